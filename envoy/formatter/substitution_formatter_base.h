@@ -29,6 +29,18 @@ public:
    */
   virtual std::string format(const Context& context,
                              const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append a formatted substitution line to the output. This is equivalent to appending the
+   * result of format(), but lets callers reuse the same buffer for every line.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the line is appended to.
+   */
+  virtual void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    output.append(format(context, stream_info));
+  }
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
@@ -60,6 +72,38 @@ public:
    */
   virtual Protobuf::Value formatValue(const Context& context,
                                       const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value returned by format() to the output. Providers may override this to write
+   * the value without building an intermediate string.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the value is appended to.
+   * @return bool true if a value was appended, false if there is no value and nothing was
+   *         appended.
+   */
+  virtual bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    const absl::optional<std::string> value = format(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Append the JSON serialization of the value returned by formatValue() to the output.
+   * Providers may override this to write the value without building a Protobuf::Value.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the buffer the value is appended to.
+   * @return bool true if the value was appended, false if the provider does not write JSON
+   *         directly, in which case nothing was appended and formatValue() must be used.
+   */
+  virtual bool formatJsonTo(const Context&, const StreamInfo::StreamInfo&, std::string&) const {
+    return false;
+  }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
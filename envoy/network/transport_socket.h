@@ -114,6 +114,13 @@ public:
    * As of 2/20, used by Google.
    */
   virtual void flushWriteBuffer() PURE;
+
+  /**
+   * Release the memory the connection's read and write buffers hold beyond the data they
+   * contain. Used by transport sockets to shrink the footprint of idle connections.
+   * @return the number of bytes released.
+   */
+  virtual uint64_t compactBuffers() PURE;
 };
 
 /**
@@ -61,6 +61,21 @@ enum class DrainStrategy {
   Immediate,
 };
 
+/**
+ * What a thread does with a log line that does not fit in its file flush buffer.
+ */
+enum class FileFlushOverflowPolicy {
+  /**
+   * The line is appended to the buffer shared by all threads writing to the file.
+   */
+  Buffer,
+
+  /**
+   * The line is dropped and counted in the filesystem.write_dropped stat.
+   */
+  Drop,
+};
+
 using CommandLineOptionsPtr = std::unique_ptr<envoy::admin::v3::CommandLineOptions>;
 
 /**
@@ -227,6 +242,18 @@ public:
    */
   virtual uint64_t fileFlushMinSizeKB() const PURE;
 
+  /**
+   * @return uint64_t the size in kilobytes of the per-thread log buffer, or 0 if threads write to a
+   *         single buffer shared by all threads.
+   */
+  virtual uint64_t fileFlushThreadBufferSizeKB() const PURE;
+
+  /**
+   * @return FileFlushOverflowPolicy what to do with log lines that do not fit in the per-thread
+   *         log buffer.
+   */
+  virtual FileFlushOverflowPolicy fileFlushOverflowPolicy() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -106,6 +106,14 @@ public:
    */
   virtual bool autoSniSanMatch() const PURE;
 
+  /**
+   * @return the configuration for verifying certificate chains on a thread pool if configured.
+   * This does not change the outcome of the validation, so it is not part of the session ID.
+   */
+  virtual const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                                   CertificateValidationContext::AsyncChainVerification>&
+  asyncChainVerification() const PURE;
+
   // SECURITY NOTE
   //
   // When adding or changing this interface, it is likely that a change is needed to
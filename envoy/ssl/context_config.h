@@ -114,6 +114,11 @@ public:
    */
   virtual const std::string& tlsKeyLogPath() const PURE;
 
+  /**
+   * @return true if encryption of written records should be handed to the kernel when possible.
+   */
+  virtual bool kernelTlsTxOffload() const PURE;
+
   /**
    * @return the access log manager object reference
    */
@@ -220,6 +225,18 @@ public:
    */
   virtual bool disableStatefulSessionResumption() const PURE;
 
+  /**
+   * @return the maximum number of sessions of the process wide session cache if stateful TLS
+   * session resumption should use it, nullopt if each context keeps its own session cache.
+   */
+  virtual absl::optional<uint32_t> sharedSessionCacheMaxSessions() const PURE;
+
+  /**
+   * @return how long a connection must be idle before its buffers are compacted, nullopt if
+   * connections are never compacted.
+   */
+  virtual absl::optional<std::chrono::milliseconds> idleCompactionTimeout() const PURE;
+
   /**
    * @return True if we allow full scan certificates when there is no cert matching SNI during
    * downstream TLS handshake, false otherwise.
@@ -1,7 +1,11 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "envoy/common/exception.h"
 
@@ -10,6 +14,7 @@
 #include "source/common/common/lock_guard.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
 namespace AccessLog {
@@ -17,6 +22,8 @@ namespace {
 static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operation::Write |
                                                    1 << Filesystem::File::Operation::Create |
                                                    1 << Filesystem::File::Operation::Append};
+
+std::atomic<uint64_t> next_file_id{0};
 } // namespace
 
 AccessLogManagerImpl::~AccessLogManagerImpl() {
@@ -50,7 +57,8 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
   auto [it, insert_success] = access_logs_.emplace(
       file_name, std::make_shared<AccessLogFileImpl>(
                      std::move(file), dispatcher_, lock_, file_stats_, file_flush_interval_msec_,
-                     file_min_flush_size_kb_, api_.threadFactory()));
+                     file_min_flush_size_kb_, file_thread_buffer_size_kb_, file_drop_on_overflow_,
+                     api_.threadFactory()));
   // Insertion was successful because the key wasn't found in the map or else
   // the value would have been previously returned.
   ASSERT(insert_success);
@@ -60,16 +68,22 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     uint64_t min_flush_size_kb,
+                                     uint64_t min_flush_size_kb, uint64_t thread_buffer_size_kb,
+                                     bool drop_on_overflow,
                                      Thread::ThreadFactory& thread_factory)
-    : file_(std::move(file)), file_lock_(lock),
+    : id_(next_file_id++), file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
+        if (thread_buffer_size_ > 0) {
+          flush_requested_ = true;
+        }
         flush_event_.notifyOne();
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
       thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec),
-      min_flush_size_(min_flush_size_kb * 1024), stats_(stats) {
+      min_flush_size_(min_flush_size_kb * 1024), thread_buffer_size_(thread_buffer_size_kb * 1024),
+      thread_flush_size_(std::min(min_flush_size_, thread_buffer_size_ / 2)),
+      drop_on_overflow_(drop_on_overflow), stats_(stats) {
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
@@ -92,8 +106,12 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    {
+      Thread::LockGuard lock(write_lock_);
+      moveToAboutToWriteBuffer();
+    }
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -149,7 +167,8 @@ void AccessLogFileImpl::flushThreadFunc() {
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (flush_buffer_.length() == 0 && !flush_requested_ && !flush_thread_exit_ &&
+             !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -159,8 +178,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+      moveToAboutToWriteBuffer();
 
       if (reopen_file_) {
         do_reopen = true;
@@ -199,23 +217,56 @@ void AccessLogFileImpl::flush() {
     // return before the pending data has actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
+    moveToAboutToWriteBuffer();
+    if (about_to_write_buffer_.length() == 0) {
       return;
     }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
   }
 
   doWrite(about_to_write_buffer_);
 }
 
+void AccessLogFileImpl::moveToAboutToWriteBuffer() {
+  // The thread buffers are drained first. A thread only writes to flush_buffer_ once its own buffer
+  // is full, so anything it wrote before is in its buffer.
+  for (const auto& thread_buffer : thread_buffers_) {
+    thread_buffer->drainTo(about_to_write_buffer_, stats_);
+  }
+  about_to_write_buffer_.move(flush_buffer_);
+  ASSERT(flush_buffer_.length() == 0);
+  flush_requested_ = false;
+  flush_generation_++;
+}
+
 void AccessLogFileImpl::write(absl::string_view data) {
+  ThreadBuffer* thread_buffer = nullptr;
+  if (thread_buffer_size_ > 0) {
+    thread_buffer = &threadBuffer();
+    // Once a thread wrote to flush_buffer_, it keeps doing so until flush_buffer_ has been moved
+    // out, so that its data is written in order.
+    if (thread_buffer->overflow_generation_ != flush_generation_) {
+      const absl::optional<uint64_t> buffered = thread_buffer->write(data);
+      if (buffered.has_value()) {
+        if (buffered.value() >= thread_flush_size_) {
+          requestFlush();
+        }
+        return;
+      }
+    }
+    if (drop_on_overflow_) {
+      stats_.write_dropped_.inc();
+      return;
+    }
+  }
+
   Thread::LockGuard lock(write_lock_);
 
   if (flush_thread_ == nullptr) {
     createFlushStructures();
   }
+  if (thread_buffer != nullptr) {
+    thread_buffer->overflow_generation_ = flush_generation_;
+  }
 
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
@@ -225,6 +276,77 @@ void AccessLogFileImpl::write(absl::string_view data) {
   }
 }
 
+AccessLogFileImpl::ThreadBuffer& AccessLogFileImpl::threadBuffer() {
+  // Buffers are looked up by file id rather than by address, so that a file created at the address
+  // of a destroyed one never finds the destroyed file's buffers. Each entry also holds a weak
+  // reference to its buffer, which expires when the file is destroyed, so that the entries of
+  // destroyed files are removed whenever the thread starts writing to a new file.
+  static thread_local absl::flat_hash_map<uint64_t,
+                                          std::pair<ThreadBuffer*, std::weak_ptr<ThreadBuffer>>>
+      thread_buffers;
+  if (auto it = thread_buffers.find(id_); it != thread_buffers.end()) {
+    return *it->second.first;
+  }
+
+  absl::erase_if(thread_buffers, [](const auto& entry) { return entry.second.second.expired(); });
+  Thread::LockGuard lock(write_lock_);
+  if (flush_thread_ == nullptr) {
+    createFlushStructures();
+  }
+  thread_buffers_.push_back(std::make_shared<ThreadBuffer>(thread_buffer_size_));
+  thread_buffers.emplace(id_, std::make_pair(thread_buffers_.back().get(), thread_buffers_.back()));
+  return *thread_buffers_.back();
+}
+
+void AccessLogFileImpl::requestFlush() {
+  // Only the first thread to cross the threshold takes the lock to wake up the flush thread. The
+  // lock ensures the flush thread either sees the flag or is waiting when notified.
+  if (!flush_requested_.load(std::memory_order_relaxed) && !flush_requested_.exchange(true)) {
+    Thread::LockGuard lock(write_lock_);
+    flush_event_.notifyOne();
+  }
+}
+
+absl::optional<uint64_t> AccessLogFileImpl::ThreadBuffer::write(absl::string_view data) {
+  const uint64_t written = written_.load(std::memory_order_relaxed);
+  const uint64_t buffered = written - read_.load(std::memory_order_acquire);
+  if (data.size() > size_ - buffered) {
+    return absl::nullopt;
+  }
+
+  const uint64_t start = written % size_;
+  const uint64_t head = std::min<uint64_t>(data.size(), size_ - start);
+  memcpy(data_.get() + start, data.data(), head);
+  memcpy(data_.get(), data.data() + head, data.size() - head);
+  writes_.store(writes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  written_.store(written + data.size(), std::memory_order_release);
+  return buffered + data.size();
+}
+
+void AccessLogFileImpl::ThreadBuffer::drainTo(Buffer::Instance& output,
+                                              AccessLogFileStats& stats) {
+  const uint64_t read = read_.load(std::memory_order_relaxed);
+  const uint64_t written = written_.load(std::memory_order_acquire);
+  if (written == read) {
+    return;
+  }
+
+  const uint64_t length = written - read;
+  const uint64_t start = read % size_;
+  const uint64_t head = std::min(length, size_ - start);
+  output.add(data_.get() + start, head);
+  if (length > head) {
+    output.add(data_.get(), length - head);
+  }
+  read_.store(written, std::memory_order_release);
+
+  // The write count may include writes whose data is only drained next time, which evens out.
+  const uint64_t writes = writes_.load(std::memory_order_relaxed);
+  stats.write_buffered_.add(writes - drained_writes_);
+  drained_writes_ = writes;
+  stats.write_total_buffered_.add(length);
+}
+
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
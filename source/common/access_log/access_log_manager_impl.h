@@ -2,7 +2,10 @@
 
 #include <sys/types.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -15,7 +18,9 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/base/optimization.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 
@@ -24,6 +29,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -36,10 +42,13 @@ namespace AccessLog {
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec,
-                       uint64_t min_flush_size_kb, Api::Api& api, Event::Dispatcher& dispatcher,
+                       uint64_t min_flush_size_kb, uint64_t thread_buffer_size_kb,
+                       bool drop_on_overflow, Api::Api& api, Event::Dispatcher& dispatcher,
                        Thread::BasicLockable& lock, Stats::Store& stats_store)
       : file_flush_interval_msec_(file_flush_interval_msec),
-        file_min_flush_size_kb_(min_flush_size_kb), api_(api), dispatcher_(dispatcher), lock_(lock),
+        file_min_flush_size_kb_(min_flush_size_kb),
+        file_thread_buffer_size_kb_(thread_buffer_size_kb),
+        file_drop_on_overflow_(drop_on_overflow), api_(api), dispatcher_(dispatcher), lock_(lock),
         file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
                                           POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
   ~AccessLogManagerImpl() override;
@@ -52,6 +61,8 @@ public:
 private:
   const std::chrono::milliseconds file_flush_interval_msec_;
   const uint64_t file_min_flush_size_kb_{64};
+  const uint64_t file_thread_buffer_size_kb_;
+  const bool file_drop_on_overflow_;
   Api::Api& api_;
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
@@ -65,12 +76,17 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * By default all threads append to a single buffer under a lock. When a thread buffer size is set,
+ * each writing thread instead gets a lock-free buffer of its own that the flush thread drains, and
+ * only falls back to the shared buffer (or drops the data) when its buffer is full.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec, uint64_t min_flush_size_kb,
+                    uint64_t thread_buffer_size_kb, bool drop_on_overflow,
                     Thread::ThreadFactory& thread_factory);
   ~AccessLogFileImpl() override;
 
@@ -86,9 +102,50 @@ public:
   void flush() override;
 
 private:
+  /**
+   * Single producer, single consumer ring of data written by one thread and drained by whichever
+   * thread flushes the file. Writes are published whole, so a drain never splits one.
+   */
+  class ThreadBuffer {
+  public:
+    explicit ThreadBuffer(uint64_t size) : data_(new char[size]), size_(size) {}
+
+    /**
+     * Called by the owning thread.
+     * @return the number of bytes buffered including the data, or absl::nullopt if the data does
+     *         not fit, in which case nothing was written.
+     */
+    absl::optional<uint64_t> write(absl::string_view data);
+
+    /**
+     * Called with the flush locks held. Moves the buffered data to the output.
+     */
+    void drainTo(Buffer::Instance& output, AccessLogFileStats& stats);
+
+    // The flush generation in which the owning thread last wrote to the shared flush buffer. Only
+    // accessed by the owning thread.
+    uint64_t overflow_generation_{UINT64_MAX};
+
+  private:
+    const std::unique_ptr<char[]> data_;
+    const uint64_t size_;
+    // The total number of bytes ever drained and written. Each is only modified by one side, and
+    // they are kept on separate cache lines so the two sides do not contend.
+    ABSL_CACHELINE_ALIGNED std::atomic<uint64_t> read_{0};
+    ABSL_CACHELINE_ALIGNED std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> writes_{0};
+    uint64_t drained_writes_{0};
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   void createFlushStructures();
+  ThreadBuffer& threadBuffer();
+  void requestFlush();
+  void moveToAboutToWriteBuffer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_lock_);
+
+  // Unique for the lifetime of the process, unlike the address of the file.
+  const uint64_t id_;
 
   Filesystem::FilePtr file_;
 
@@ -113,6 +170,12 @@ private:
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
+  // Set when a thread buffer crossed the flush threshold or the flush timer fired, so that the
+  // flush thread drains the thread buffers even if flush_buffer_ is empty.
+  std::atomic<bool> flush_requested_{false};
+  // Incremented every time flush_buffer_ is moved out. Only modified with write_lock_ held.
+  std::atomic<uint64_t> flush_generation_{0};
+  std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers_ ABSL_GUARDED_BY(write_lock_);
   Buffer::OwnedImpl
       flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
                                                   // gets filled and then flushed either when max
@@ -132,6 +195,11 @@ private:
                                                         // or not.
   const uint64_t min_flush_size_{
       64 * 1024}; // Minimum size before the flush thread will be told to flush.
+  const uint64_t thread_buffer_size_; // Size of each thread buffer, 0 if they are disabled.
+  const uint64_t thread_flush_size_;  // Size of a thread buffer before the flush thread will be
+                                      // told to flush.
+  const bool drop_on_overflow_; // Whether data that does not fit in a thread buffer is dropped
+                                // rather than written to flush_buffer_.
   AccessLogFileStats& stats_;
 };
 
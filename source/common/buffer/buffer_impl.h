@@ -465,6 +465,25 @@ public:
   bool empty() const { return size() == 0; }
   size_t size() const { return size_; }
 
+  /**
+   * Move the slices back to the inline ring if they fit in it, releasing the external ring.
+   * @return the number of bytes released.
+   */
+  size_t shrinkToFit() {
+    if (external_ring_ == nullptr || size_ > InlineRingCapacity) {
+      return 0;
+    }
+    for (size_t i = 0; i < size_; i++) {
+      inline_ring_[i] = std::move(ring_[internalIndex(i)]);
+    }
+    const size_t released = capacity_ * sizeof(Slice);
+    external_ring_.reset();
+    ring_ = inline_ring_;
+    start_ = 0;
+    capacity_ = InlineRingCapacity;
+    return released;
+  }
+
   Slice& front() { return ring_[start_]; }
   const Slice& front() const { return ring_[start_]; }
   Slice& back() { return ring_[internalIndex(size_ - 1)]; }
@@ -696,6 +715,13 @@ public:
    */
   BufferMemoryAccountSharedPtr getAccountForTest();
 
+  /**
+   * Release the memory used to track slices that were drained, e.g. after a burst of data went
+   * through the buffer. The slices themselves are freed as soon as they are drained.
+   * @return the number of bytes released.
+   */
+  uint64_t shrinkToFit() { return slices_.shrinkToFit(); }
+
   // Does not implement watermarking.
   // TODO(antoniovicente) Implement watermarks by merging the OwnedImpl and WatermarkBuffer
   // implementations. Also, make high-watermark config a constructor argument.
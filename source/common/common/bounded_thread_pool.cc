@@ -0,0 +1,84 @@
+#include "source/common/common/bounded_thread_pool.h"
+
+#include <utility>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Thread {
+
+std::shared_ptr<BoundedThreadPool>
+BoundedThreadPool::get(Singleton::Manager& singleton_manager, const std::string& singleton_name,
+                       ThreadFactory& thread_factory, const std::string& thread_name,
+                       size_t max_batch_size, uint32_t thread_count) {
+  auto pool = singleton_manager.getTyped<BoundedThreadPool>(
+      singleton_name, [&thread_factory, &thread_name, max_batch_size] {
+        return std::make_shared<BoundedThreadPool>(thread_factory, thread_name, max_batch_size);
+      });
+  pool->grow(thread_count);
+  return pool;
+}
+
+BoundedThreadPool::BoundedThreadPool(ThreadFactory& thread_factory, const std::string& thread_name,
+                                     size_t max_batch_size)
+    : thread_factory_(thread_factory), thread_options_{thread_name},
+      max_batch_size_(max_batch_size) {
+  ASSERT(max_batch_size_ > 0);
+}
+
+BoundedThreadPool::~BoundedThreadPool() {
+  std::vector<ThreadPtr> threads;
+  {
+    absl::MutexLock lock(mutex_);
+    terminate_ = true;
+    threads.swap(threads_);
+  }
+  for (ThreadPtr& thread : threads) {
+    thread->join();
+  }
+}
+
+void BoundedThreadPool::grow(uint32_t thread_count) {
+  absl::MutexLock lock(mutex_);
+  while (threads_.size() < thread_count) {
+    threads_.push_back(thread_factory_.createThread([this]() { run(); }, thread_options_));
+  }
+}
+
+bool BoundedThreadPool::post(Job job) {
+  absl::MutexLock lock(mutex_);
+  if (queue_.size() >= threads_.size() * MaxQueuedJobsPerThread) {
+    return false;
+  }
+  queue_.push(std::move(job));
+  return true;
+}
+
+void BoundedThreadPool::run() {
+  const auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || terminate_;
+  };
+  std::vector<Job> batch;
+  batch.reserve(max_batch_size_);
+  while (true) {
+    {
+      absl::MutexLock lock(mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+      if (queue_.empty()) {
+        // Terminating, and all queued jobs have run.
+        return;
+      }
+      while (!queue_.empty() && batch.size() < max_batch_size_) {
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop();
+      }
+    }
+    for (Job& job : batch) {
+      job();
+    }
+    batch.clear();
+  }
+}
+
+} // namespace Thread
+} // namespace Envoy
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/thread/thread.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Thread {
+
+/**
+ * Pool of threads running jobs off the worker threads, with a queue bounded by the number of
+ * threads so that callers can do the work themselves rather than queue without bound. Jobs are
+ * run in the order they were posted. Each time a thread wakes up it takes up to max_batch_size
+ * queued jobs, so that a burst of jobs costs one wakeup and one lock acquisition per batch.
+ * Results are expected to be handed back to the posting worker through its dispatcher.
+ */
+class BoundedThreadPool : public Singleton::Instance {
+public:
+  using Job = absl::AnyInvocable<void()>;
+
+  // The number of jobs that may be queued per thread before post() refuses new jobs.
+  static constexpr size_t MaxQueuedJobsPerThread = 256;
+
+  /**
+   * @param singleton_name supplies the name the pool is registered under, see
+   *        SINGLETON_MANAGER_REGISTERED_NAME.
+   * @return the process wide pool of that name, grown to at least thread_count threads. The thread
+   *         name and batch size are only used when the pool is created.
+   */
+  static std::shared_ptr<BoundedThreadPool>
+  get(Singleton::Manager& singleton_manager, const std::string& singleton_name,
+      ThreadFactory& thread_factory, const std::string& thread_name, size_t max_batch_size,
+      uint32_t thread_count);
+
+  BoundedThreadPool(ThreadFactory& thread_factory, const std::string& thread_name,
+                    size_t max_batch_size);
+  // Blocks until all queued jobs have run.
+  ~BoundedThreadPool() override;
+
+  /**
+   * Grows the pool to at least thread_count threads. The pool never shrinks.
+   */
+  void grow(uint32_t thread_count);
+
+  /**
+   * Queues a job to run on one of the threads of the pool.
+   * @return false if the queue is full, in which case the job was not queued and the caller should
+   * do the work itself.
+   */
+  bool post(Job job);
+
+private:
+  void run();
+
+  ThreadFactory& thread_factory_;
+  const Options thread_options_;
+  const size_t max_batch_size_;
+  absl::Mutex mutex_;
+  std::queue<Job> queue_ ABSL_GUARDED_BY(mutex_);
+  std::vector<ThreadPtr> threads_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){false};
+};
+
+using BoundedThreadPoolSharedPtr = std::shared_ptr<BoundedThreadPool>;
+
+} // namespace Thread
+} // namespace Envoy
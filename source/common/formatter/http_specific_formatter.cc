@@ -11,6 +11,7 @@
 #include "source/common/grpc/status.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
+#include "source/common/json/json_streamer.h"
 #include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
@@ -82,6 +83,30 @@ Protobuf::Value HeaderFormatter::formatValue(OptRef<const Http::HeaderMap> heade
   return ValueUtil::stringValue(std::string(val));
 }
 
+bool HeaderFormatter::appendTo(OptRef<const Http::HeaderMap> headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  output.append(SubstitutionFormatUtils::truncateStringView(header->value().getStringView(),
+                                                            max_length_));
+  return true;
+}
+
+void HeaderFormatter::appendJsonTo(OptRef<const Http::HeaderMap> headers,
+                                   std::string& output) const {
+  Json::StringStreamer streamer(output);
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    streamer.addNull();
+    return;
+  }
+
+  streamer.addString(SubstitutionFormatUtils::truncateStringView(header->value().getStringView(),
+                                                                 max_length_));
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(absl::string_view main_header,
                                                  absl::string_view alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -97,6 +122,18 @@ Protobuf::Value ResponseHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                       std::string& output) const {
+  return HeaderFormatter::appendTo(context.responseHeaders(), output);
+}
+
+bool ResponseHeaderFormatter::formatJsonTo(const Context& context,
+                                           const StreamInfo::StreamInfo&,
+                                           std::string& output) const {
+  HeaderFormatter::appendJsonTo(context.responseHeaders(), output);
+  return true;
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(absl::string_view main_header,
                                                absl::string_view alternative_header,
                                                absl::optional<size_t> max_length)
@@ -112,6 +149,17 @@ Protobuf::Value RequestHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                      std::string& output) const {
+  return HeaderFormatter::appendTo(context.requestHeaders(), output);
+}
+
+bool RequestHeaderFormatter::formatJsonTo(const Context& context, const StreamInfo::StreamInfo&,
+                                          std::string& output) const {
+  HeaderFormatter::appendJsonTo(context.requestHeaders(), output);
+  return true;
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(absl::string_view main_header,
                                                    absl::string_view alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -127,6 +175,18 @@ Protobuf::Value ResponseTrailerFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                        std::string& output) const {
+  return HeaderFormatter::appendTo(context.responseTrailers(), output);
+}
+
+bool ResponseTrailerFormatter::formatJsonTo(const Context& context,
+                                            const StreamInfo::StreamInfo&,
+                                            std::string& output) const {
+  HeaderFormatter::appendJsonTo(context.responseTrailers(), output);
+  return true;
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
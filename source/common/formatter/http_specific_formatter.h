@@ -55,6 +55,8 @@ public:
 protected:
   absl::optional<std::string> format(OptRef<const Http::HeaderMap> headers) const;
   Protobuf::Value formatValue(OptRef<const Http::HeaderMap> headers) const;
+  bool appendTo(OptRef<const Http::HeaderMap> headers, std::string& output) const;
+  void appendJsonTo(OptRef<const Http::HeaderMap> headers, std::string& output) const;
 
 private:
   const Http::HeaderEntry* findHeader(OptRef<const Http::HeaderMap> headers) const;
@@ -99,6 +101,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override;
 };
 
 /**
@@ -114,6 +120,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override;
 };
 
 /**
@@ -129,6 +139,10 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override;
 };
 
 /**
@@ -5,6 +5,7 @@
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
+#include "source/common/json/json_streamer.h"
 #include "source/common/json/json_utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
@@ -764,6 +765,17 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::optionalStringValue(field_extractor_(stream_info));
   }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override {
+    Json::StringStreamer streamer(output);
+    const auto value = field_extractor_(stream_info);
+    if (value.has_value()) {
+      streamer.addString(value.value());
+    } else {
+      streamer.addNull();
+    }
+    return true;
+  }
 
 private:
   FieldExtractor field_extractor_;
@@ -797,6 +809,29 @@ public:
 
     return ValueUtil::numberValue(millis.value());
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    const fmt::format_int formatted(millis.value());
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override {
+    Json::StringStreamer streamer(output);
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      streamer.addNull();
+    } else {
+      // Serialized as a double to match the Protobuf::Value number returned by formatValue().
+      streamer.addNumber(static_cast<double>(millis.value()));
+    }
+    return true;
+  }
 
 private:
   absl::optional<int64_t> extractMillis(const StreamInfo::StreamInfo& stream_info) const {
@@ -827,6 +862,17 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    const fmt::format_int formatted(field_extractor_(stream_info));
+    output.append(formatted.data(), formatted.size());
+    return true;
+  }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override {
+    Json::StringStreamer(output).addNumber(static_cast<double>(field_extractor_(stream_info)));
+    return true;
+  }
 
 private:
   FieldExtractor field_extractor_;
@@ -367,19 +367,19 @@ std::string FormatterImpl::format(const Context& context,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
   log_line.reserve(256);
+  formatTo(context, stream_info, log_line);
+  return log_line;
+}
 
+void FormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                             std::string& output) const {
   for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->format(context, stream_info);
     // Add the formatted value if there is one. Otherwise add a default value
     // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
-      log_line += DefaultUnspecifiedValueStringView;
+    if (!provider->formatTo(context, stream_info, output) && !omit_empty_values_) {
+      output.append(DefaultUnspecifiedValueStringView);
     }
   }
-
-  return log_line;
 }
 
 void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
@@ -387,15 +387,21 @@ void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const
                           std::string& sanitize, bool omit_empty_values) {
   log_line.push_back('"'); // Start the JSON string.
   for (const JsonFormatterImpl::Formatter& formatter : formatters) {
-    const absl::optional<std::string> value = formatter->format(context, info);
-    if (!value.has_value()) {
+    const size_t start = log_line.size();
+    if (!formatter->formatTo(context, info, log_line)) {
       // Add the empty value. This needn't be sanitized.
       log_line.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
       continue;
     }
-    // Sanitize the string value and add it to the buffer. The string value will not be quoted
-    // since we handle the quoting by ourselves at the outer level.
-    log_line.append(Json::sanitize(sanitize, value.value()));
+    // The value was written in place. It is only rewritten if it needs escaping, which is rare.
+    // The string value will not be quoted since we handle the quoting by ourselves at the outer
+    // level.
+    const absl::string_view value = absl::string_view(log_line).substr(start);
+    const absl::string_view sanitized = Json::sanitize(sanitize, value);
+    if (sanitized.data() != value.data()) {
+      log_line.resize(start);
+      log_line.append(sanitized);
+    }
   }
   log_line.push_back('"'); // End the JSON string.
 }
@@ -418,6 +424,12 @@ std::string JsonFormatterImpl::format(const Context& context,
                                       const StreamInfo::StreamInfo& info) const {
   std::string log_line;
   log_line.reserve(2048);
+  formatTo(context, info, log_line);
+  return log_line;
+}
+
+void JsonFormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                                 std::string& log_line) const {
   std::string sanitize; // Helper to serialize the value to log line.
 
   for (const ParsedFormatElement& element : parsed_elements_) {
@@ -436,16 +448,16 @@ std::string JsonFormatterImpl::format(const Context& context,
     if (formatters.size() != 1) {
       // 2. Handle the formatter element with multiple or zero providers.
       stringValueToLogLine(formatters, context, info, log_line, sanitize, omit_empty_values_);
-    } else {
+    } else if (!formatters[0]->formatJsonTo(context, info, log_line)) {
       // 3. Handle the formatter element with a single provider and value
-      //    type needs to be kept.
+      //    type needs to be kept. Providers that can not write JSON directly
+      //    go through a Protobuf::Value.
       const auto value = formatters[0]->formatValue(context, info);
       Json::Utility::appendValueToString(value, log_line);
     }
   }
 
   log_line.push_back('\n');
-  return log_line;
 }
 
 } // namespace Formatter
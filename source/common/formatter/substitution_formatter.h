@@ -30,7 +30,10 @@ namespace Formatter {
  */
 class PlainStringFormatter : public FormatterProvider {
 public:
-  PlainStringFormatter(absl::string_view str) { str_.set_string_value(str); }
+  PlainStringFormatter(absl::string_view str) {
+    str_.set_string_value(str);
+    Json::StringStreamer(json_).addString(str);
+  }
 
   // FormatterProvider
   absl::optional<std::string> format(const Context&, const StreamInfo::StreamInfo&) const override {
@@ -39,9 +42,20 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return str_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&, std::string& output) const override {
+    output.append(str_.string_value());
+    return true;
+  }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo&,
+                    std::string& output) const override {
+    output.append(json_);
+    return true;
+  }
 
 private:
   Protobuf::Value str_;
+  // The value serialized as JSON when the formatter is created.
+  std::string json_;
 };
 
 /**
@@ -49,19 +63,32 @@ private:
  */
 class PlainNumberFormatter : public FormatterProvider {
 public:
-  PlainNumberFormatter(double num) { num_.set_number_value(num); }
+  PlainNumberFormatter(double num) : str_(absl::StrFormat("%g", num)) {
+    num_.set_number_value(num);
+    Json::StringStreamer(json_).addNumber(num);
+  }
 
   // FormatterProvider
   absl::optional<std::string> format(const Context&, const StreamInfo::StreamInfo&) const override {
-    std::string str = absl::StrFormat("%g", num_.number_value());
-    return str;
+    return str_;
   }
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return num_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&, std::string& output) const override {
+    output.append(str_);
+    return true;
+  }
+  bool formatJsonTo(const Context&, const StreamInfo::StreamInfo&,
+                    std::string& output) const override {
+    output.append(json_);
+    return true;
+  }
 
 private:
   Protobuf::Value num_;
+  const std::string str_;
+  std::string json_;
 };
 
 /**
@@ -89,6 +116,8 @@ public:
   // Formatter
   std::string format(const Context& context,
                      const StreamInfo::StreamInfo& stream_info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
 
 protected:
   FormatterImpl(absl::Status& creation_status, absl::string_view format,
@@ -115,6 +144,8 @@ public:
 
   // Formatter
   std::string format(const Context& context, const StreamInfo::StreamInfo& info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                std::string& output) const override;
 
 private:
   const bool omit_empty_values_;
@@ -1028,6 +1028,17 @@ void ConnectionImpl::flushWriteBuffer() {
   }
 }
 
+uint64_t ConnectionImpl::compactBuffers() {
+  uint64_t released = 0;
+  for (Buffer::Instance* buffer : {read_buffer_.get(), write_buffer_.get()}) {
+    // The buffers come from the dispatcher's watermark factory, which creates OwnedImpl buffers.
+    if (auto* owned = dynamic_cast<Buffer::OwnedImpl*>(buffer); owned != nullptr) {
+      released += owned->shrinkToFit();
+    }
+  }
+  return released;
+}
+
 void ConnectionImpl::dumpState(std::ostream& os, int indent_level) const {
   const char* spaces = spacesForLevel(indent_level);
   os << spaces << "ConnectionImpl " << this << DUMP_MEMBER(connecting_) << DUMP_MEMBER(bind_error_)
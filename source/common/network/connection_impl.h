@@ -158,6 +158,7 @@ public:
   // Reconsider how to make fairness happen.
   void setTransportSocketIsReadable() override;
   void flushWriteBuffer() override;
+  uint64_t compactBuffers() override;
   TransportSocketPtr& transportSocket() { return transport_socket_; }
 
   // Obtain global next connection ID. This should only be used in tests.
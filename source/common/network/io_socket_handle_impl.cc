@@ -488,6 +488,7 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmmsg(RawSliceArrays& slices, uin
                    fmt::format("Unable to get remote address from recvmmsg() for fd: {}", fd_));
 
     output.msg_[i].msg_len_ = mmsg_hdr[i].msg_len;
+    output.msg_[i].gso_size_ = 0;
     // Get local and peer addresses for each packet.
     output.msg_[i].peer_address_ =
         getOrCreateEnvoyAddressInstance(raw_addresses[i], hdr.msg_namelen);
@@ -500,6 +501,15 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmmsg(RawSliceArrays& slices, uin
           Buffer::OwnedImpl cmsg_slice{CMSG_DATA(cmsg), cmsg->cmsg_len};
           output.msg_[i].saved_cmsg_ = std::move(cmsg_slice);
         }
+#ifdef UDP_GRO
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+          absl::optional<uint16_t> maybe_gso = maybeGetUnsignedIntFromHeader<uint16_t>(*cmsg);
+          if (maybe_gso) {
+            output.msg_[i].gso_size_ = *maybe_gso;
+          }
+          continue;
+        }
+#endif
         Address::InstanceConstSharedPtr addr = maybeGetDstAddressFromHeader(*cmsg, self_port);
         absl::optional<uint8_t> maybe_tos = maybeGetTosFromHeader(*cmsg);
         if (maybe_tos) {
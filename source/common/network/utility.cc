@@ -567,7 +567,7 @@ Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
   // TODO(yugant): Avoid allocating 64k for each read by getting memory from UdpPacketProcessor
   const uint64_t max_rx_datagram_size_with_gro =
       num_packets_read != nullptr
-          ? 64 * 1024
+          ? MAX_UDP_GRO_MESSAGE_SIZE
           : NUM_DATAGRAMS_PER_RECEIVE * udp_packet_processor.maxDatagramSize();
   ENVOY_LOG_MISC(trace, "starting gro recvmsg with max={}", max_rx_datagram_size_with_gro);
 
@@ -681,6 +681,75 @@ Api::IoCallUint64Result readFromSocketRecvMmsg(IoHandle& handle,
   return result;
 }
 
+Api::IoCallUint64Result readFromSocketRecvMmsgWithGro(IoHandle& handle,
+                                                      const Address::Instance& local_address,
+                                                      UdpPacketProcessor& udp_packet_processor,
+                                                      TimeSource& time_source,
+                                                      uint32_t* packets_dropped,
+                                                      uint32_t* num_packets_read) {
+  ASSERT(Api::OsSysCallsSingleton::get().supportsUdpGro() &&
+             Api::OsSysCallsSingleton::get().supportsMmsg(),
+         "cannot use recvmmsg with GRO when the platform doesn't support both.");
+  if (num_packets_read != nullptr) {
+    *num_packets_read = 0;
+  }
+
+  // Coalesced messages are received into memory reused by every read on this thread, and each
+  // datagram is then copied into a buffer of its own size. This avoids allocating
+  // NUM_GRO_MESSAGES_PER_RECEIVE * MAX_UDP_GRO_MESSAGE_SIZE bytes per system call, most of which
+  // would go unused.
+  static thread_local std::vector<uint8_t> receive_buffer(NUM_GRO_MESSAGES_PER_RECEIVE *
+                                                          MAX_UDP_GRO_MESSAGE_SIZE);
+  RawSliceArrays slices(NUM_GRO_MESSAGES_PER_RECEIVE, absl::FixedArray<Buffer::RawSlice>(1));
+  for (uint32_t i = 0; i < NUM_GRO_MESSAGES_PER_RECEIVE; i++) {
+    slices[i][0] = {receive_buffer.data() + i * MAX_UDP_GRO_MESSAGE_SIZE,
+                    MAX_UDP_GRO_MESSAGE_SIZE};
+  }
+
+  IoHandle::RecvMsgOutput output(NUM_GRO_MESSAGES_PER_RECEIVE, packets_dropped);
+  ENVOY_LOG_MISC(trace, "starting gro recvmmsg with messages={} max={}",
+                 NUM_GRO_MESSAGES_PER_RECEIVE, MAX_UDP_GRO_MESSAGE_SIZE);
+  Api::IoCallUint64Result result = handle.recvmmsg(slices, local_address.ip()->port(),
+                                                   udp_packet_processor.saveCmsgConfig(), output);
+  if (!result.ok()) {
+    return result;
+  }
+
+  const uint64_t messages_read = result.return_value_;
+  ENVOY_LOG_MISC(trace, "gro recvmmsg read {} messages", messages_read);
+  const MonotonicTime receive_time = time_source.monotonicTime();
+  for (uint64_t i = 0; i < messages_read; ++i) {
+    if (output.msg_[i].truncated_and_dropped_) {
+      continue;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(slices[i][0].mem_);
+    const uint64_t msg_len = output.msg_[i].msg_len_;
+    ASSERT(msg_len <= slices[i][0].len_);
+    // A zero gso_size means the kernel did not coalesce this message.
+    const uint64_t gso_size = output.msg_[i].gso_size_ != 0 ? output.msg_[i].gso_size_ : msg_len;
+    ENVOY_LOG_MISC(trace, "gro recvmmsg message {} bytes {} with gso_size as {}", i, msg_len,
+                   output.msg_[i].gso_size_);
+
+    // Segment the message into gso_sized datagrams. A do-while so that empty datagrams are
+    // delivered too.
+    uint64_t offset = 0;
+    do {
+      const uint64_t bytes_to_copy = std::min(msg_len - offset, gso_size);
+      Buffer::InstancePtr buffer =
+          std::make_unique<Buffer::OwnedImpl>(data + offset, bytes_to_copy);
+      offset += bytes_to_copy;
+      if (num_packets_read != nullptr) {
+        *num_packets_read += 1;
+      }
+      passPayloadToProcessor(bytes_to_copy, std::move(buffer), output.msg_[i].peer_address_,
+                             output.msg_[i].local_address_, udp_packet_processor, receive_time,
+                             output.msg_[i].tos_, std::move(output.msg_[i].saved_cmsg_));
+    } while (offset < msg_len);
+  }
+  return result;
+}
+
 Api::IoCallUint64Result readFromSocketRecvMsg(IoHandle& handle,
                                               const Address::Instance& local_address,
                                               UdpPacketProcessor& udp_packet_processor,
@@ -726,6 +795,9 @@ Utility::readFromSocket(IoHandle& handle, const Address::Instance& local_address
   } else if (recv_msg_method == UdpRecvMsgMethod::RecvMmsg) {
     return readFromSocketRecvMmsg(handle, local_address, udp_packet_processor, time_source,
                                   packets_dropped, num_packets_read);
+  } else if (recv_msg_method == UdpRecvMsgMethod::RecvMmsgWithGro) {
+    return readFromSocketRecvMmsgWithGro(handle, local_address, udp_packet_processor, time_source,
+                                         packets_dropped, num_packets_read);
   }
   return readFromSocketRecvMsg(handle, local_address, udp_packet_processor, time_source,
                                packets_dropped, num_packets_read);
@@ -735,10 +807,13 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
                                                const Address::Instance& local_address,
                                                UdpPacketProcessor& udp_packet_processor,
                                                TimeSource& time_source, bool allow_gro,
-                                               bool allow_mmsg, uint32_t& packets_dropped) {
+                                               bool allow_mmsg, uint32_t& packets_dropped,
+                                               bool batch_gro_reads) {
   UdpRecvMsgMethod recv_msg_method = UdpRecvMsgMethod::RecvMsg;
   if (allow_gro && handle.supportsUdpGro()) {
-    recv_msg_method = UdpRecvMsgMethod::RecvMsgWithGro;
+    recv_msg_method = batch_gro_reads && allow_mmsg && handle.supportsMmsg()
+                          ? UdpRecvMsgMethod::RecvMmsgWithGro
+                          : UdpRecvMsgMethod::RecvMsgWithGro;
   } else if (allow_mmsg && handle.supportsMmsg()) {
     recv_msg_method = UdpRecvMsgMethod::RecvMmsg;
   }
@@ -793,7 +868,8 @@ ResolvedUdpSocketConfig::ResolvedUdpSocketConfig(
     const envoy::config::core::v3::UdpSocketConfig& config, bool prefer_gro_default)
     : max_rx_datagram_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_rx_datagram_size,
                                                             DEFAULT_UDP_MAX_DATAGRAM_SIZE)),
-      prefer_gro_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, prefer_gro, prefer_gro_default)) {
+      prefer_gro_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, prefer_gro, prefer_gro_default)),
+      batch_gro_reads_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, batch_gro_reads, false)) {
   if (prefer_gro_ && !Api::OsSysCallsSingleton::get().supportsUdpGro()) {
     ENVOY_LOG_MISC(
         warn, "GRO requested but not supported by the OS. Check OS config or disable prefer_gro.");
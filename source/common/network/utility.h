@@ -66,6 +66,10 @@ public:
 static const uint64_t DEFAULT_UDP_MAX_DATAGRAM_SIZE = 1500;
 static const uint64_t NUM_DATAGRAMS_PER_RECEIVE = 16;
 static const uint64_t MAX_NUM_PACKETS_PER_EVENT_LOOP = 6000;
+// The largest message a GRO read can return, which is the largest UDP payload.
+static const uint64_t MAX_UDP_GRO_MESSAGE_SIZE = 64 * 1024;
+// The number of GRO-coalesced messages received per recvmmsg call.
+static const uint64_t NUM_GRO_MESSAGES_PER_RECEIVE = 8;
 
 /**
  * Wrapper which resolves UDP socket proto config with defaults.
@@ -76,6 +80,7 @@ struct ResolvedUdpSocketConfig {
 
   uint64_t max_rx_datagram_size_;
   bool prefer_gro_;
+  bool batch_gro_reads_;
 };
 
 // The different options for receiving UDP packet(s) from system calls.
@@ -87,6 +92,8 @@ enum class UdpRecvMsgMethod {
   RecvMsgWithGro,
   // The `recvmmsg` system call.
   RecvMmsg,
+  // The `recvmmsg` system call using GRO, receiving several coalesced messages per system call.
+  RecvMmsgWithGro,
 };
 
 /**
@@ -348,6 +355,8 @@ public:
    * check the IoHandle to ensure the platform supports recvmmsg before using it. If `allow_gro` is
    * true and the platform supports GRO, then it will take precedence over using recvmmsg.
    * @param packets_dropped is the output parameter for number of packets dropped in kernel.
+   * @param batch_gro_reads whether to receive several GRO-coalesced messages per recvmmsg call
+   * when both GRO and recvmmsg are allowed and supported, rather than one per recvmsg call.
    * Return the io error encountered or nullptr if no io error but read stopped
    * because of MAX_NUM_PACKETS_PER_EVENT_LOOP.
    *
@@ -362,7 +371,8 @@ public:
                                                const Address::Instance& local_address,
                                                UdpPacketProcessor& udp_packet_processor,
                                                TimeSource& time_source, bool allow_gro,
-                                               bool allow_mmsg, uint32_t& packets_dropped);
+                                               bool allow_mmsg, uint32_t& packets_dropped,
+                                               bool batch_gro_reads = false);
 
 #if defined(__linux__)
   /**
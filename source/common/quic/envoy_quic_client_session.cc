@@ -34,6 +34,7 @@ public:
   bool shouldDrainReadBuffer() override { PANIC("unexpectedly reached"); }
   void setTransportSocketIsReadable() override { PANIC("unexpectedly reached"); }
   void flushWriteBuffer() override { PANIC("unexpectedly reached"); }
+  uint64_t compactBuffers() override { PANIC("unexpectedly reached"); }
 
 private:
   EnvoyQuicClientSession& session_;
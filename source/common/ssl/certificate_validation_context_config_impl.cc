@@ -45,7 +45,11 @@ CertificateValidationContextConfigImpl::CertificateValidationContextConfigImpl(
       max_verify_depth_(config.has_max_verify_depth()
                             ? absl::optional<uint32_t>(config.max_verify_depth().value())
                             : absl::nullopt),
-      auto_sni_san_match_(auto_sni_san_match) {}
+      auto_sni_san_match_(auto_sni_san_match),
+      async_chain_verification_(
+          config.has_async_chain_verification()
+              ? absl::make_optional(config.async_chain_verification())
+              : absl::nullopt) {}
 
 absl::StatusOr<std::unique_ptr<CertificateValidationContextConfigImpl>>
 CertificateValidationContextConfigImpl::create(
@@ -61,6 +61,12 @@ public:
 
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
 
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                           CertificateValidationContext::AsyncChainVerification>&
+  asyncChainVerification() const override {
+    return async_chain_verification_;
+  }
+
 protected:
   CertificateValidationContextConfigImpl(
       std::string ca_cert, std::string certificate_revocation_list,
@@ -88,6 +94,10 @@ private:
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
   const bool auto_sni_san_match_;
+  const absl::optional<
+      envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+          AsyncChainVerification>
+      async_chain_verification_;
 };
 
 } // namespace Ssl
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <list>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include "source/common/tls/stats.h"
 #include "source/common/tls/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -45,6 +47,90 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+SINGLETON_MANAGER_REGISTRATION(tls_chain_verification_pool);
+
+namespace {
+
+std::vector<bssl::UniquePtr<X509>> upRefChain(const std::vector<bssl::UniquePtr<X509>>& chain) {
+  std::vector<bssl::UniquePtr<X509>> copy;
+  copy.reserve(chain.size());
+  for (const bssl::UniquePtr<X509>& cert : chain) {
+    copy.emplace_back(bssl::UpRef(cert.get()));
+  }
+  return copy;
+}
+
+} // namespace
+
+// LRU cache of the chains that were successfully verified against the trust store.
+class DefaultCertValidator::VerifiedChainCache {
+public:
+  VerifiedChainCache(size_t max_entries, std::chrono::milliseconds ttl)
+      : max_entries_(max_entries), ttl_(ttl) {}
+
+  // @return the key of the chain, or an empty string if the chain cannot be cached.
+  static std::string key(STACK_OF(X509)& cert_chain, bool is_server) {
+    // The purpose the chain is verified for depends on the side of the connection.
+    std::string key(1, is_server ? 's' : 'c');
+    key.reserve(1 + sk_X509_num(&cert_chain) * SHA256_DIGEST_LENGTH);
+    for (size_t i = 0; i < sk_X509_num(&cert_chain); i++) {
+      uint8_t digest[SHA256_DIGEST_LENGTH];
+      unsigned int digest_length;
+      if (!X509_digest(sk_X509_value(&cert_chain, i), EVP_sha256(), digest, &digest_length)) {
+        return "";
+      }
+      key.append(reinterpret_cast<const char*>(digest), digest_length);
+    }
+    return key;
+  }
+
+  // @return the validated chain, or an empty chain if the chain was not verified within the TTL.
+  std::vector<bssl::UniquePtr<X509>> lookup(const std::string& key, MonotonicTime now) {
+    absl::MutexLock lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return {};
+    }
+    if (now - it->second->verified_at_ >= ttl_) {
+      entries_.erase(it->second);
+      index_.erase(it);
+      return {};
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return upRefChain(it->second->validated_chain_);
+  }
+
+  void insert(const std::string& key, const std::vector<bssl::UniquePtr<X509>>& validated_chain,
+              MonotonicTime now) {
+    absl::MutexLock lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    while (entries_.size() >= max_entries_) {
+      index_.erase(entries_.back().key_);
+      entries_.pop_back();
+    }
+    entries_.push_front({key, now, upRefChain(validated_chain)});
+    index_.emplace(entries_.front().key_, entries_.begin());
+  }
+
+private:
+  struct Entry {
+    std::string key_;
+    MonotonicTime verified_at_;
+    std::vector<bssl::UniquePtr<X509>> validated_chain_;
+  };
+
+  const size_t max_entries_;
+  const std::chrono::milliseconds ttl_;
+  absl::Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  // Keys refer to the keys stored in entries_.
+  absl::flat_hash_map<absl::string_view, std::list<Entry>::iterator> index_ ABSL_GUARDED_BY(mutex_);
+};
+
 DefaultCertValidator::DefaultCertValidator(
     const Envoy::Ssl::CertificateValidationContextConfig* config, SslStats& stats,
     Server::Configuration::CommonFactoryContext& context)
@@ -57,6 +143,14 @@ DefaultCertValidator::DefaultCertValidator(
   }
 };
 
+DefaultCertValidator::~DefaultCertValidator() {
+  if (async_state_ != nullptr) {
+    // Verifications still running on the pool are dropped from now on.
+    absl::MutexLock lock(async_state_->mutex_);
+    async_state_->validator_ = nullptr;
+  }
+}
+
 absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
                                                                 bool provides_certificates,
                                                                 Stats::Scope& scope) {
@@ -103,6 +197,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
           has_crl = true;
+          has_crl_ = true;
         }
       }
       if (ca_cert_ == nullptr) {
@@ -149,6 +244,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
       for (const X509_INFO* item : list.get()) {
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
+          has_crl_ = true;
         }
       }
       X509_STORE_set_flags(store, config_->onlyVerifyLeafCertificateCrl()
@@ -197,6 +293,28 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
     }
   }
 
+  if (config_ != nullptr && config_->asyncChainVerification().has_value() && verify_trusted_ca_) {
+    const auto& async_config = config_->asyncChainVerification().value();
+    const std::string prefix("ssl.chain_verification.");
+    chain_verification_stats_ = std::make_unique<ChainVerificationStats>(
+        ChainVerificationStats{ALL_CHAIN_VERIFICATION_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                                            POOL_HISTOGRAM_PREFIX(scope, prefix))});
+    min_offloaded_chain_length_ =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(async_config, min_chain_length, 3);
+    const uint32_t cache_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(async_config, cache_size, 1024);
+    if (cache_size > 0) {
+      verified_chain_cache_ = std::make_unique<VerifiedChainCache>(
+          cache_size,
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(async_config, cache_ttl, 60000)));
+    }
+    chain_verification_pool_ = chainVerificationPool(
+        context_.singletonManager(), context_.api().threadFactory(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(async_config, thread_count, 2));
+    async_state_ = std::make_shared<AsyncState>();
+    absl::MutexLock lock(async_state_->mutex_);
+    async_state_->validator_ = this;
+  }
+
   initializeCertExpirationStats(scope);
 
   return verify_mode;
@@ -311,7 +429,7 @@ DefaultCertValidator::verifyCertificate(X509* cert, const std::vector<std::strin
 }
 
 ValidationResults DefaultCertValidator::doVerifyCertChain(
-    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr /*callback*/,
+    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
     const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options, SSL_CTX& ssl_ctx,
     const CertValidator::ExtraValidationContext& context, bool is_server,
     absl::string_view host_name) {
@@ -328,45 +446,52 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
   ASSERT(leaf_cert);
   if (verify_trusted_ca_) {
-    X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
-    ASSERT(verify_store);
-    bssl::UniquePtr<X509_STORE_CTX> ctx(X509_STORE_CTX_new());
-    if (!ctx || !X509_STORE_CTX_init(ctx.get(), verify_store, leaf_cert, &cert_chain) ||
-        // We need to inherit the verify parameters. These can be determined by
-        // the context: if it's a server it will verify SSL client certificates or
-        // vice versa.
-        !X509_STORE_CTX_set_default(ctx.get(), is_server ? "ssl_client" : "ssl_server") ||
-        // Anything non-default in "param" should overwrite anything in the ctx.
-        !X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(ctx.get()),
-                                SSL_CTX_get0_param(&ssl_ctx))) {
-      OPENSSL_PUT_ERROR(SSL, ERR_R_X509_LIB);
-      const char* error = "verify cert failed: init and setup X509_STORE_CTX";
-      stats_.fail_verify_error_.inc();
-      ENVOY_LOG(debug, error);
-      return {ValidationResults::ValidationStatus::Failed,
-              Envoy::Ssl::ClientValidationStatus::Failed, absl::nullopt, error};
+    std::string cache_key;
+    if (verified_chain_cache_ != nullptr) {
+      cache_key = VerifiedChainCache::key(cert_chain, is_server);
+      if (!cache_key.empty()) {
+        validated_chain =
+            verified_chain_cache_->lookup(cache_key, context_.timeSource().monotonicTime());
+      }
+      if (validated_chain.empty()) {
+        chain_verification_stats_->cache_miss_.inc();
+      } else {
+        chain_verification_stats_->cache_hit_.inc();
+      }
     }
-    const bool verify_succeeded = (X509_verify_cert(ctx.get()) == 1);
 
-    if (!verify_succeeded) {
-      const std::string error =
-          absl::StrCat("verify cert failed: ", Utility::getX509VerificationErrorInfo(ctx.get()));
-      stats_.fail_verify_error_.inc();
-      ENVOY_LOG(debug, error);
-      if (allow_untrusted_certificate_) {
-        return ValidationResults{ValidationResults::ValidationStatus::Successful,
-                                 Envoy::Ssl::ClientValidationStatus::Failed, absl::nullopt,
-                                 absl::nullopt};
+    if (validated_chain.empty()) {
+      if (callback != nullptr && shouldOffload(cert_chain)) {
+        // The remaining checks may need the connection, which the pool must not touch, so they
+        // are done before the trust is verified, whether or not the pool takes the chain. They
+        // are cheap compared to the verification.
+        std::string error_details;
+        uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
+        const bool succeeded =
+            verifyCertAndUpdateStatus(leaf_cert, host_name, transport_socket_options.get(),
+                                      context, detailed_status, &error_details, &tls_alert);
+        if (detailed_status == Envoy::Ssl::ClientValidationStatus::Failed) {
+          return succeeded ? ValidationResults{ValidationResults::ValidationStatus::Successful,
+                                               detailed_status, absl::nullopt, absl::nullopt}
+                           : ValidationResults{ValidationResults::ValidationStatus::Failed,
+                                               detailed_status, tls_alert, error_details};
+        }
+        const MonotonicTime started = context_.timeSource().monotonicTime();
+        if (offloadVerification(cert_chain, std::move(callback), ssl_ctx, is_server, cache_key)) {
+          return {ValidationResults::ValidationStatus::Pending,
+                  Envoy::Ssl::ClientValidationStatus::NotValidated, absl::nullopt, absl::nullopt};
+        }
+        return completeTrustVerification(verifyTrust(cert_chain, ssl_ctx, is_server), cache_key,
+                                         started);
       }
-      return {ValidationResults::ValidationStatus::Failed,
-              Envoy::Ssl::ClientValidationStatus::Failed,
-              SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx.get())), error};
-    }
 
-    STACK_OF(X509)* verified_chain = X509_STORE_CTX_get0_chain(ctx.get());
-    for (size_t i = 0; i < sk_X509_num(verified_chain); i++) {
-      X509* cert = sk_X509_value(verified_chain, i);
-      validated_chain.emplace_back(bssl::UpRef(cert));
+      const MonotonicTime started = context_.timeSource().monotonicTime();
+      TrustVerification trust = verifyTrust(cert_chain, ssl_ctx, is_server);
+      if (trust.status != TrustVerification::Status::Trusted) {
+        return onTrustVerificationFailed(trust);
+      }
+      onTrustVerified(trust, cache_key, started);
+      validated_chain = std::move(trust.validated_chain);
     }
 
     detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
@@ -383,6 +508,144 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
                                  tls_alert, error_details};
 }
 
+DefaultCertValidator::TrustVerification
+DefaultCertValidator::verifyTrust(STACK_OF(X509)& cert_chain, SSL_CTX& ssl_ctx, bool is_server) {
+  X509* leaf_cert = sk_X509_value(&cert_chain, 0);
+  X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
+  ASSERT(verify_store);
+  bssl::UniquePtr<X509_STORE_CTX> ctx(X509_STORE_CTX_new());
+  if (!ctx || !X509_STORE_CTX_init(ctx.get(), verify_store, leaf_cert, &cert_chain) ||
+      // We need to inherit the verify parameters. These can be determined by
+      // the context: if it's a server it will verify SSL client certificates or
+      // vice versa.
+      !X509_STORE_CTX_set_default(ctx.get(), is_server ? "ssl_client" : "ssl_server") ||
+      // Anything non-default in "param" should overwrite anything in the ctx.
+      !X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(ctx.get()),
+                              SSL_CTX_get0_param(&ssl_ctx))) {
+    OPENSSL_PUT_ERROR(SSL, ERR_R_X509_LIB);
+    return {TrustVerification::Status::Error, "verify cert failed: init and setup X509_STORE_CTX"};
+  }
+
+  if (X509_verify_cert(ctx.get()) != 1) {
+    const int verify_result = X509_STORE_CTX_get_error(ctx.get());
+    return {TrustVerification::Status::Untrusted,
+            absl::StrCat("verify cert failed: ", Utility::getX509VerificationErrorInfo(ctx.get())),
+            static_cast<uint8_t>(SSL_alert_from_verify_result(verify_result))};
+  }
+
+  TrustVerification trust{TrustVerification::Status::Trusted};
+  STACK_OF(X509)* verified_chain = X509_STORE_CTX_get0_chain(ctx.get());
+  for (size_t i = 0; i < sk_X509_num(verified_chain); i++) {
+    X509* cert = sk_X509_value(verified_chain, i);
+    trust.validated_chain.emplace_back(bssl::UpRef(cert));
+  }
+  return trust;
+}
+
+ValidationResults DefaultCertValidator::onTrustVerificationFailed(const TrustVerification& trust) {
+  stats_.fail_verify_error_.inc();
+  ENVOY_LOG(debug, trust.error);
+  if (trust.status == TrustVerification::Status::Error) {
+    return {ValidationResults::ValidationStatus::Failed,
+            Envoy::Ssl::ClientValidationStatus::Failed, absl::nullopt, trust.error};
+  }
+  if (allow_untrusted_certificate_) {
+    return {ValidationResults::ValidationStatus::Successful,
+            Envoy::Ssl::ClientValidationStatus::Failed, absl::nullopt, absl::nullopt};
+  }
+  return {ValidationResults::ValidationStatus::Failed, Envoy::Ssl::ClientValidationStatus::Failed,
+          trust.tls_alert, trust.error};
+}
+
+void DefaultCertValidator::onTrustVerified(const TrustVerification& trust,
+                                           const std::string& cache_key, MonotonicTime started) {
+  if (chain_verification_stats_ == nullptr) {
+    return;
+  }
+  const MonotonicTime now = context_.timeSource().monotonicTime();
+  chain_verification_stats_->duration_.recordValue(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - started).count());
+  if (verified_chain_cache_ != nullptr && !cache_key.empty()) {
+    verified_chain_cache_->insert(cache_key, trust.validated_chain, now);
+  }
+}
+
+Thread::BoundedThreadPoolSharedPtr
+DefaultCertValidator::chainVerificationPool(Singleton::Manager& singleton_manager,
+                                            Thread::ThreadFactory& thread_factory,
+                                            uint32_t thread_count) {
+  // Each verification is expensive enough that batching them would only add latency.
+  return Thread::BoundedThreadPool::get(
+      singleton_manager, SINGLETON_MANAGER_REGISTERED_NAME(tls_chain_verification_pool),
+      thread_factory, "tls_verify", 1, thread_count);
+}
+
+bool DefaultCertValidator::shouldOffload(STACK_OF(X509)& cert_chain) const {
+  return chain_verification_pool_ != nullptr &&
+         (has_crl_ || sk_X509_num(&cert_chain) >= min_offloaded_chain_length_);
+}
+
+bool DefaultCertValidator::offloadVerification(STACK_OF(X509)& cert_chain,
+                                               Ssl::ValidateResultCallbackPtr callback,
+                                               SSL_CTX& ssl_ctx, bool is_server,
+                                               const std::string& cache_key) {
+  // The chain is owned by the connection, which may go away while the chain is verified.
+  bssl::UniquePtr<STACK_OF(X509)> chain(sk_X509_new_null());
+  for (size_t i = 0; i < sk_X509_num(&cert_chain); i++) {
+    if (!bssl::PushToStack(chain.get(), bssl::UpRef(sk_X509_value(&cert_chain, i)))) {
+      return false;
+    }
+  }
+
+  Event::Dispatcher& dispatcher = callback->dispatcher();
+  const bool posted = chain_verification_pool_->post(
+      [state = async_state_, &dispatcher, chain = std::move(chain),
+       ssl_ctx = bssl::UpRef(&ssl_ctx), is_server, callback = std::move(callback), cache_key,
+       started = context_.timeSource().monotonicTime()]() mutable {
+        TrustVerification trust = verifyTrust(*chain, *ssl_ctx, is_server);
+        // Once the validator is gone, so may be the worker the handshake runs on.
+        absl::MutexLock lock(state->mutex_);
+        if (state->validator_ == nullptr) {
+          return;
+        }
+        dispatcher.post([state, trust = std::move(trust), callback = std::move(callback),
+                         cache_key = std::move(cache_key), started]() mutable {
+          absl::optional<ValidationResults> result;
+          {
+            absl::MutexLock lock(state->mutex_);
+            if (state->validator_ == nullptr) {
+              return;
+            }
+            result =
+                state->validator_->completeTrustVerification(std::move(trust), cache_key, started);
+          }
+          // Resuming the handshake may destroy the validator, so it is done without the lock.
+          callback->onCertValidationResult(
+              result->status == ValidationResults::ValidationStatus::Successful,
+              result->detailed_status, result->error_details.value_or(""),
+              result->tls_alert.value_or(SSL_AD_CERTIFICATE_UNKNOWN));
+        });
+      });
+  if (posted) {
+    chain_verification_stats_->offloaded_.inc();
+  } else {
+    chain_verification_stats_->pool_full_.inc();
+  }
+  return posted;
+}
+
+ValidationResults DefaultCertValidator::completeTrustVerification(TrustVerification&& trust,
+                                                                  const std::string& cache_key,
+                                                                  MonotonicTime started) {
+  if (trust.status != TrustVerification::Status::Trusted) {
+    return onTrustVerificationFailed(trust);
+  }
+  onTrustVerified(trust, cache_key, started);
+  return {ValidationResults::ValidationStatus::Successful,
+          Envoy::Ssl::ClientValidationStatus::Validated, absl::nullopt, absl::nullopt,
+          std::move(trust.validated_chain)};
+}
+
 bool DefaultCertValidator::verifySubjectAltName(X509* cert,
                                                 const std::vector<std::string>& subject_alt_names) {
   bssl::UniquePtr<GENERAL_NAMES> san_names(
@@ -9,13 +9,16 @@
 #include <vector>
 
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/registry/registry.h"
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/context_config.h"
 #include "envoy/ssl/private_key/private_key.h"
 #include "envoy/ssl/ssl_socket_extended_info.h"
+#include "envoy/stats/stats_macros.h"
 
+#include "source/common/common/bounded_thread_pool.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
 #include "source/common/stats/symbol_table.h"
@@ -32,12 +35,27 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+#define ALL_CHAIN_VERIFICATION_STATS(COUNTER, HISTOGRAM)                                          \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)                                                                              \
+  COUNTER(offloaded)                                                                               \
+  COUNTER(pool_full)                                                                               \
+  HISTOGRAM(duration, Microseconds)
+
+/**
+ * Stats of the verification of certificate chains against the trust store, only emitted when
+ * async_chain_verification is configured. @see stats_macros.h
+ */
+struct ChainVerificationStats {
+  ALL_CHAIN_VERIFICATION_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
 class DefaultCertValidator : public CertValidator, Logger::Loggable<Logger::Id::connection> {
 public:
   DefaultCertValidator(const Envoy::Ssl::CertificateValidationContextConfig* config,
                        SslStats& stats, Server::Configuration::CommonFactoryContext& context);
 
-  ~DefaultCertValidator() override = default;
+  ~DefaultCertValidator() override;
 
   // Tls::CertValidator
   absl::Status addClientValidationContext(SSL_CTX* context, bool require_client_cert) override;
@@ -105,7 +123,49 @@ public:
   static bool matchSubjectAltName(X509* cert, OptRef<const StreamInfo::StreamInfo> stream_info,
                                   const std::vector<SanMatcherPtr>& subject_alt_name_matchers);
 
+  /**
+   * @return the process wide pool verifying the chains of all the validators, grown to at least
+   *         thread_count threads.
+   */
+  static Thread::BoundedThreadPoolSharedPtr
+  chainVerificationPool(Singleton::Manager& singleton_manager,
+                        Thread::ThreadFactory& thread_factory, uint32_t thread_count);
+
 private:
+  // The outcome of verifying a chain against the trust store.
+  struct TrustVerification {
+    enum class Status { Trusted, Untrusted, Error };
+
+    Status status;
+    std::string error;
+    uint8_t tls_alert{SSL_AD_CERTIFICATE_UNKNOWN};
+    // The chain built by BoringSSL, only populated if the chain is trusted.
+    std::vector<bssl::UniquePtr<X509>> validated_chain;
+  };
+
+  // Shared with the jobs of the chain verification pool, which must not touch the validator once
+  // it has been destroyed.
+  struct AsyncState {
+    absl::Mutex mutex_;
+    DefaultCertValidator* validator_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  class VerifiedChainCache;
+
+  // Does not touch the validator, so it is safe to call from the chain verification pool.
+  static TrustVerification verifyTrust(STACK_OF(X509)& cert_chain, SSL_CTX& ssl_ctx,
+                                       bool is_server);
+  ValidationResults onTrustVerificationFailed(const TrustVerification& trust);
+  bool shouldOffload(STACK_OF(X509)& cert_chain) const;
+  // @return false if the chain verification pool is full.
+  bool offloadVerification(STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
+                           SSL_CTX& ssl_ctx, bool is_server, const std::string& cache_key);
+  // Completes a verification whose other checks passed before the trust was verified.
+  ValidationResults completeTrustVerification(TrustVerification&& trust,
+                                              const std::string& cache_key, MonotonicTime started);
+  void onTrustVerified(const TrustVerification& trust, const std::string& cache_key,
+                       MonotonicTime started);
+
   bool verifyCertAndUpdateStatus(X509* leaf_cert, absl::string_view sni,
                                  const Network::TransportSocketOptions* transport_socket_options,
                                  const CertValidator::ExtraValidationContext& validation_context,
@@ -124,6 +184,14 @@ private:
   bool allow_untrusted_certificate_{false};
   bool verify_trusted_ca_{false};
   const bool auto_sni_san_match_{false};
+  bool has_crl_{false};
+
+  // Only set if async_chain_verification is configured and a trust store is in use.
+  std::unique_ptr<ChainVerificationStats> chain_verification_stats_;
+  std::unique_ptr<VerifiedChainCache> verified_chain_cache_;
+  Thread::BoundedThreadPoolSharedPtr chain_verification_pool_;
+  uint32_t min_offloaded_chain_length_{};
+  std::shared_ptr<AsyncState> async_state_;
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
@@ -62,6 +62,7 @@ public:
   const Network::Address::IpList& tlsKeyLogLocal() const override { return *tls_keylog_local_; };
   const Network::Address::IpList& tlsKeyLogRemote() const override { return *tls_keylog_remote_; };
   const std::string& tlsKeyLogPath() const override { return tls_keylog_path_; };
+  bool kernelTlsTxOffload() const override { return kernel_tls_tx_offload_; }
   AccessLog::AccessLogManager& accessLogManager() const override {
     return factory_context_.serverFactoryContext().accessLogManager();
   }
@@ -132,6 +133,7 @@ private:
   Ssl::SslCtxCb sslctx_cb_;
   Server::Configuration::TransportSocketFactoryContext& factory_context_;
   const std::string tls_keylog_path_;
+  const bool kernel_tls_tx_offload_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_local_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_remote_;
   const absl::optional<
@@ -155,6 +157,10 @@ public:
   bool autoHostServerNameIndication() const override { return auto_host_sni_; }
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
   bool allowRenegotiation() const override { return allow_renegotiation_; }
+  // Records can't be rekeyed once the kernel encrypts them.
+  bool kernelTlsTxOffload() const override {
+    return ContextConfigImpl::kernelTlsTxOffload() && !allow_renegotiation_;
+  }
   size_t maxSessionKeys() const override { return max_session_keys_; }
   bool enforceRsaKeyUsage() const override { return enforce_rsa_key_usage_; }
   void setSecretUpdateCallback(std::function<absl::Status()> callback) override;
@@ -118,6 +118,12 @@ public:
 
   static void keylogCallback(const SSL* ssl, const char* line);
 
+  bool kernelTlsTxOffload() const { return kernel_tls_tx_offload_; }
+  // Only set for server contexts.
+  absl::optional<std::chrono::milliseconds> idleCompactionTimeout() const {
+    return idle_compaction_timeout_;
+  }
+
 protected:
   friend class ContextImplPeer;
 
@@ -176,6 +182,8 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  const bool kernel_tls_tx_offload_;
+  absl::optional<std::chrono::milliseconds> idle_compaction_timeout_;
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
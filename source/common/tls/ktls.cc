@@ -0,0 +1,140 @@
+#include "source/common/tls/ktls.h"
+
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/macros.h"
+
+#include "openssl/mem.h"
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#define ENVOY_KERNEL_TLS
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+#ifdef ENVOY_KERNEL_TLS
+namespace {
+
+// The TLS 1.2 AES-GCM implicit nonce (RFC 5288).
+constexpr size_t SaltSize = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+static_assert(SaltSize == TLS_CIPHER_AES_GCM_256_SALT_SIZE);
+
+constexpr uint8_t AlertRecordType = 21;
+
+template <class CryptoInfo>
+bool setTx(Network::IoHandle& io_handle, uint16_t cipher_type, const uint8_t* key,
+           const uint8_t* salt, const uint8_t* sequence) {
+  CryptoInfo crypto_info{};
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  memcpy(crypto_info.key, key, sizeof(crypto_info.key));
+  memcpy(crypto_info.salt, salt, sizeof(crypto_info.salt));
+  // BoringSSL uses the record sequence number as explicit nonce, as the kernel does.
+  memcpy(crypto_info.iv, sequence, sizeof(crypto_info.iv));
+  memcpy(crypto_info.rec_seq, sequence, sizeof(crypto_info.rec_seq));
+  const bool ok =
+      io_handle.setOption(SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info)).return_value_ == 0;
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return ok;
+}
+
+} // namespace
+#endif
+
+bool enableTx(SSL* ssl, Network::IoHandle& io_handle) {
+#ifdef ENVOY_KERNEL_TLS
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (SSL_version(ssl) != TLS1_2_VERSION || SSL_in_false_start(ssl) || cipher == nullptr) {
+    return false;
+  }
+  size_t key_size;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    break;
+  default:
+    return false;
+  }
+
+  // For AEAD ciphers the key block holds the client and server write keys followed by the client
+  // and server implicit nonces, without any MAC keys.
+  uint8_t key_block[2 * (TLS_CIPHER_AES_GCM_256_KEY_SIZE + SaltSize)];
+  const size_t key_block_size = 2 * (key_size + SaltSize);
+  if (SSL_get_key_block_len(ssl) != key_block_size ||
+      !SSL_generate_key_block(ssl, key_block, key_block_size)) {
+    return false;
+  }
+  const bool is_server = SSL_is_server(ssl);
+  const uint8_t* key = key_block + (is_server ? key_size : 0);
+  const uint8_t* salt = key_block + 2 * key_size + (is_server ? SaltSize : 0);
+
+  uint8_t sequence[8];
+  const uint64_t write_sequence = SSL_get_write_sequence(ssl);
+  for (size_t i = 0; i < sizeof(sequence); ++i) {
+    sequence[i] = static_cast<uint8_t>(write_sequence >> (8 * (sizeof(sequence) - 1 - i)));
+  }
+
+  // If the kernel has no TLS support this fails, and the socket is unchanged. If only setting the
+  // keys fails, the socket keeps working as a plain TCP socket.
+  static constexpr char Ulp[] = "tls";
+  bool enabled = io_handle.setOption(IPPROTO_TCP, TCP_ULP, Ulp, sizeof(Ulp)).return_value_ == 0;
+  if (enabled) {
+    enabled = key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE
+                  ? setTx<tls12_crypto_info_aes_gcm_128>(io_handle, TLS_CIPHER_AES_GCM_128, key,
+                                                         salt, sequence)
+                  : setTx<tls12_crypto_info_aes_gcm_256>(io_handle, TLS_CIPHER_AES_GCM_256, key,
+                                                         salt, sequence);
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return enabled;
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  return false;
+#endif
+}
+
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle) {
+#ifdef ENVOY_KERNEL_TLS
+  // A warning level close_notify alert.
+  uint8_t alert[2] = {1, 0};
+  iovec iov{alert, sizeof(alert)};
+  char control[CMSG_SPACE(sizeof(AlertRecordType))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(AlertRecordType));
+  memcpy(CMSG_DATA(cmsg), &AlertRecordType, sizeof(AlertRecordType));
+  return Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/network/io_handle.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * Hands encryption of the records written on a connection to the kernel (Linux kernel TLS), so
+ * that application data can be written to the socket as is. This is only done for TLS 1.2
+ * connections using AES-GCM, whose keys never change after the handshake.
+ *
+ * Must be called once the handshake is complete and before any application data is written with
+ * SSL_write(). Once this returns true, data must be written to the socket directly and never with
+ * BoringSSL, whose write state is stale from then on. Reading records with BoringSSL is unaffected.
+ *
+ * @param ssl supplies the connection, which must have completed its handshake.
+ * @param io_handle supplies the socket the connection is established on.
+ * @return bool true if the kernel now encrypts the records written on the socket, false if the
+ *         connection or the kernel doesn't support it, in which case the socket is left unchanged.
+ */
+bool enableTx(SSL* ssl, Network::IoHandle& io_handle);
+
+/**
+ * Sends a close_notify alert on a socket for which enableTx() returned true.
+ * @param io_handle supplies the socket.
+ * @return Api::SysCallSizeResult the result of writing the alert.
+ */
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
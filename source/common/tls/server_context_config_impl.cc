@@ -136,6 +136,14 @@ ServerContextConfigImpl::ServerContextConfigImpl(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, full_scan_certs_on_sni_mismatch, false)),
       prefer_client_ciphers_(config.prefer_client_ciphers()) {
   SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+  if (config.has_shared_session_cache()) {
+    shared_session_cache_max_sessions_ =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.shared_session_cache(), max_sessions, 20480);
+  }
+  if (config.has_idle_compaction_timeout()) {
+    idle_compaction_timeout_ = std::chrono::milliseconds(
+        DurationUtil::durationToMilliseconds(config.idle_compaction_timeout()));
+  }
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
     stk_validation_callback_handle_ = session_ticket_keys_provider_->addValidationCallback(
@@ -39,6 +39,12 @@ public:
   bool disableStatefulSessionResumption() const override {
     return disable_stateful_session_resumption_;
   }
+  absl::optional<uint32_t> sharedSessionCacheMaxSessions() const override {
+    return shared_session_cache_max_sessions_;
+  }
+  absl::optional<std::chrono::milliseconds> idleCompactionTimeout() const override {
+    return idle_compaction_timeout_;
+  }
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
   bool preferClientCiphers() const override { return prefer_client_ciphers_; }
@@ -78,6 +84,8 @@ private:
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
   const bool disable_stateful_session_resumption_;
+  absl::optional<uint32_t> shared_session_cache_max_sessions_;
+  absl::optional<std::chrono::milliseconds> idle_compaction_timeout_;
   bool full_scan_certs_on_sni_mismatch_;
   const bool prefer_client_ciphers_;
   // Certificate selector contains a reference to this context so should be destroyed first.
@@ -106,6 +106,7 @@ ServerContextImpl::ServerContextImpl(
   if (!creation_status.ok()) {
     return;
   }
+  idle_compaction_timeout_ = config.idleCompactionTimeout();
   // If creation failed, do not create the selector.
   if (add_selector) {
     tls_certificate_selector_ = config.tlsCertificateSelectorFactory().create(*this);
@@ -143,6 +144,15 @@ ServerContextImpl::ServerContextImpl(
     session_id = *id_or_error;
   }
 
+  // The session cache does not need the sessions to be scoped by context, as BoringSSL only resumes
+  // sessions whose session ID context matches.
+  if (config.sharedSessionCacheMaxSessions().has_value() &&
+      !config.disableStatefulSessionResumption() &&
+      !config.capabilities().handles_session_resumption) {
+    session_cache_ = SharedSessionCacheImpl::get(factory_context_.singletonManager(),
+                                                 config.sharedSessionCacheMaxSessions().value());
+  }
+
   for (uint32_t i = 0; i < tls_contexts_.size(); ++i) {
     auto& ctx = tls_contexts_[i];
     if (!config.capabilities().verifies_peer_certificates) {
@@ -186,6 +196,26 @@ ServerContextImpl::ServerContextImpl(
 
     if (config.disableStatefulSessionResumption()) {
       SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    } else if (session_cache_ != nullptr) {
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+        // The session is copied into the cache, so BoringSSL keeps its reference.
+        return 0;
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->getSession(ssl, absl::string_view(reinterpret_cast<const char*>(id), id_len))
+                .release();
+          });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
     }
 
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
@@ -229,6 +259,39 @@ ServerContextImpl::ServerContextImpl(
   }
 }
 
+void ServerContextImpl::newSession(SSL_SESSION* session) {
+  uint8_t* data;
+  size_t len;
+  if (!SSL_SESSION_to_bytes(session, &data, &len)) {
+    return;
+  }
+  std::string serialized(reinterpret_cast<const char*>(data), len);
+  OPENSSL_free(data);
+
+  unsigned int id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  session_cache_->insert(absl::string_view(reinterpret_cast<const char*>(id), id_len),
+                         std::move(serialized));
+}
+
+bssl::UniquePtr<SSL_SESSION> ServerContextImpl::getSession(SSL* ssl, absl::string_view id) {
+  const absl::optional<std::string> serialized = session_cache_->lookup(id);
+  if (!serialized.has_value()) {
+    stats_.shared_session_cache_miss_.inc();
+    return nullptr;
+  }
+  stats_.shared_session_cache_hit_.inc();
+  return bssl::UniquePtr<SSL_SESSION>(
+      SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(serialized->data()),
+                             serialized->size(), SSL_get_SSL_CTX(ssl)));
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned int id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  session_cache_->remove(absl::string_view(reinterpret_cast<const char*>(id), id_len));
+}
+
 absl::StatusOr<ServerContextImpl::SessionContextID>
 ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string>& server_names) {
   uint8_t hash_buffer[EVP_MAX_MD_SIZE];
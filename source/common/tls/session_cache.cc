@@ -0,0 +1,90 @@
+#include "source/common/tls/session_cache.h"
+
+#include "source/common/common/lock_guard.h"
+
+#include "absl/hash/hash.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+SINGLETON_MANAGER_REGISTRATION(tls_shared_session_cache);
+
+std::shared_ptr<SharedSessionCacheImpl>
+SharedSessionCacheImpl::get(Singleton::Manager& singleton_manager, uint32_t max_sessions) {
+  // Pinned, so that sessions survive while no context references the cache, e.g. between the
+  // removal of a listener and the creation of its replacement.
+  auto cache = singleton_manager.getTyped<SharedSessionCacheImpl>(
+      SINGLETON_MANAGER_REGISTERED_NAME(tls_shared_session_cache),
+      [] { return std::make_shared<SharedSessionCacheImpl>(); }, true);
+  cache->reserve(max_sessions);
+  return cache;
+}
+
+void SharedSessionCacheImpl::reserve(uint32_t max_sessions) {
+  const size_t capacity = (static_cast<size_t>(max_sessions) + NumShards - 1) / NumShards;
+  size_t current = shard_capacity_.load();
+  while (current < capacity && !shard_capacity_.compare_exchange_weak(current, capacity)) {
+  }
+}
+
+size_t SharedSessionCacheImpl::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    Thread::LockGuard lock(shard.mutex_);
+    size += shard.entries_.size();
+  }
+  return size;
+}
+
+void SharedSessionCacheImpl::insert(absl::string_view id, std::string&& session) {
+  Shard& shard = this->shard(id);
+  const size_t capacity = shard_capacity_.load(std::memory_order_relaxed);
+  Thread::LockGuard lock(shard.mutex_);
+  if (auto it = shard.index_.find(id); it != shard.index_.end()) {
+    it->second->second = std::move(session);
+    shard.entries_.splice(shard.entries_.begin(), shard.entries_, it->second);
+    return;
+  }
+  while (!shard.entries_.empty() && shard.entries_.size() >= capacity) {
+    shard.index_.erase(shard.entries_.back().first);
+    shard.entries_.pop_back();
+  }
+  if (capacity == 0) {
+    return;
+  }
+  shard.entries_.emplace_front(std::string(id), std::move(session));
+  shard.index_.emplace(shard.entries_.front().first, shard.entries_.begin());
+}
+
+absl::optional<std::string> SharedSessionCacheImpl::lookup(absl::string_view id) {
+  Shard& shard = this->shard(id);
+  Thread::LockGuard lock(shard.mutex_);
+  auto it = shard.index_.find(id);
+  if (it == shard.index_.end()) {
+    return absl::nullopt;
+  }
+  shard.entries_.splice(shard.entries_.begin(), shard.entries_, it->second);
+  return it->second->second;
+}
+
+void SharedSessionCacheImpl::remove(absl::string_view id) {
+  Shard& shard = this->shard(id);
+  Thread::LockGuard lock(shard.mutex_);
+  auto it = shard.index_.find(id);
+  if (it == shard.index_.end()) {
+    return;
+  }
+  shard.entries_.erase(it->second);
+  shard.index_.erase(it);
+}
+
+SharedSessionCacheImpl::Shard& SharedSessionCacheImpl::shard(absl::string_view id) {
+  return shards_[absl::Hash<absl::string_view>()(id) % NumShards];
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/common/thread_annotations.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Server side store of serialized TLS sessions, keyed by session ID. Implementations must be
+ * thread safe as sessions are inserted and looked up from all workers.
+ */
+class SessionCache {
+public:
+  virtual ~SessionCache() = default;
+
+  /**
+   * Stores a session, replacing any session with the same ID.
+   * @param id supplies the session ID.
+   * @param session supplies the serialized session.
+   */
+  virtual void insert(absl::string_view id, std::string&& session) PURE;
+
+  /**
+   * @param id supplies the session ID.
+   * @return the serialized session, or nullopt if the cache holds no session with this ID.
+   */
+  virtual absl::optional<std::string> lookup(absl::string_view id) PURE;
+
+  /**
+   * Removes a session, e.g. because it failed to resume or expired.
+   * @param id supplies the session ID.
+   */
+  virtual void remove(absl::string_view id) PURE;
+};
+
+using SessionCacheSharedPtr = std::shared_ptr<SessionCache>;
+
+/**
+ * In-process SessionCache shared by all server contexts. It outlives the contexts, so sessions
+ * remain resumable when listeners are updated or certificates rotated. Entries are split over a
+ * fixed number of shards, each with its own lock and LRU list, to keep contention between workers
+ * low.
+ */
+class SharedSessionCacheImpl : public SessionCache, public Singleton::Instance {
+public:
+  static constexpr uint32_t NumShards = 16;
+
+  /**
+   * @return the process wide cache, grown to hold at least max_sessions sessions.
+   */
+  static std::shared_ptr<SharedSessionCacheImpl> get(Singleton::Manager& singleton_manager,
+                                                     uint32_t max_sessions);
+
+  /**
+   * Grows the capacity of the cache to at least max_sessions sessions. The capacity never shrinks.
+   */
+  void reserve(uint32_t max_sessions);
+
+  /**
+   * @return the number of sessions in the cache.
+   */
+  size_t size() const;
+
+  // SessionCache
+  void insert(absl::string_view id, std::string&& session) override;
+  absl::optional<std::string> lookup(absl::string_view id) override;
+  void remove(absl::string_view id) override;
+
+private:
+  struct Shard {
+    using Entry = std::pair<std::string, std::string>;
+
+    mutable Thread::MutexBasicLockable mutex_;
+    // Most recently used first.
+    std::list<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+    // Keys refer to the IDs stored in entries_.
+    absl::flat_hash_map<absl::string_view, std::list<Entry>::iterator>
+        index_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shard(absl::string_view id);
+
+  std::atomic<size_t> shard_capacity_{0};
+  std::array<Shard, NumShards> shards_;
+};
+
+using SharedSessionCacheImplSharedPtr = std::shared_ptr<SharedSessionCacheImpl>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
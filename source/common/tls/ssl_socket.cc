@@ -8,6 +8,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/ktls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -117,6 +118,9 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
       return {action, 0, false};
     }
   }
+  if (idle_compaction_timer_ != nullptr) {
+    onActivity();
+  }
 
   bool keep_reading = true;
   bool end_stream = false;
@@ -192,6 +196,17 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsTxOffload() && KernelTls::enableTx(ssl, callbacks_->ioHandle())) {
+    ENVOY_CONN_LOG(debug, "TLS record encryption handed to the kernel", callbacks_->connection());
+    ctx_->stats().kernel_tls_tx_.inc();
+    kernel_tls_tx_ = true;
+  }
+  if (ctx_->idleCompactionTimeout().has_value()) {
+    Event::Dispatcher& dispatcher = callbacks_->connection().dispatcher();
+    idle_compaction_timer_ = dispatcher.createTimer([this]() { onIdleCompactionTimeout(); });
+    last_activity_ = dispatcher.approximateMonotonicTime();
+    idle_compaction_timer_->enableTimer(ctx_->idleCompactionTimeout().value());
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -207,6 +222,38 @@ void SslSocket::onSuccess(SSL* ssl) {
 
 void SslSocket::onFailure() { drainErrorQueue(); }
 
+void SslSocket::onActivity() {
+  last_activity_ = callbacks_->connection().dispatcher().approximateMonotonicTime();
+  if (compacted_) {
+    // Nothing needs to be restored, the buffers grow again as data goes through them.
+    compacted_ = false;
+    ctx_->stats().idle_compacted_.dec();
+    idle_compaction_timer_->enableTimer(ctx_->idleCompactionTimeout().value());
+  }
+}
+
+void SslSocket::onIdleCompactionTimeout() {
+  const std::chrono::milliseconds timeout = ctx_->idleCompactionTimeout().value();
+  const auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(
+      callbacks_->connection().dispatcher().approximateMonotonicTime() - last_activity_);
+  if (idle < timeout) {
+    // Reads and writes only record their time rather than re-arming the timer, so it is re-armed
+    // here for the remainder of the timeout.
+    idle_compaction_timer_->enableTimer(timeout - idle);
+    return;
+  }
+
+  // BoringSSL releases its record buffers whenever they are empty, so only the connection's
+  // buffers are left to compact.
+  const uint64_t released = callbacks_->compactBuffers();
+  ENVOY_CONN_LOG(debug, "compacted idle connection, released {} bytes", callbacks_->connection(),
+                 released);
+  ctx_->stats().idle_compaction_.inc();
+  ctx_->stats().idle_compaction_released_.recordValue(released);
+  ctx_->stats().idle_compacted_.inc();
+  compacted_ = true;
+}
+
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
 void SslSocket::drainErrorQueue() {
@@ -289,6 +336,13 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
       return {action, 0, false};
     }
   }
+  if (idle_compaction_timer_ != nullptr) {
+    onActivity();
+  }
+
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
 
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
@@ -340,6 +394,30 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel encrypts whatever is written, so the buffer is written as is, without linearizing
+  // it into records first.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        break;
+      }
+      return {PostIoAction::Close, total_bytes_written, false, result.err_->getErrorCode()};
+    }
+    total_bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -348,6 +426,14 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_tx_) {
+      // BoringSSL can no longer write records, so the alert is sent by the kernel.
+      const Api::SysCallSizeResult result = KernelTls::sendCloseNotify(callbacks_->ioHandle());
+      ENVOY_CONN_LOG(debug, "kernel TLS shutdown: rc={}", callbacks_->connection(),
+                     result.return_value_);
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -376,6 +462,12 @@ void SslSocket::shutdownBasic() {
 }
 
 void SslSocket::closeSocket(Network::ConnectionEvent, bool abort_reset) {
+  idle_compaction_timer_.reset();
+  if (compacted_) {
+    compacted_ = false;
+    ctx_->stats().idle_compacted_.dec();
+  }
+
   // Unregister the SSL connection object from private key method providers.
   for (auto const& provider : ctx_->getPrivateKeyMethodProviders()) {
     provider->unregisterPrivateKeyMethod(rawSsl());
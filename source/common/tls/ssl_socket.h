@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <string>
 
+#include "envoy/event/timer.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/secret/secret_callbacks.h"
@@ -92,12 +93,15 @@ private:
     absl::optional<int> error_;
   };
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
 
   Network::PostIoAction doHandshake();
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
   void resumeHandshake();
+  void onActivity();
+  void onIdleCompactionTimeout();
 
   const Network::TransportSocketOptionsConstSharedPtr transport_socket_options_;
   Network::TransportSocketCallbacks* callbacks_{};
@@ -105,6 +109,12 @@ private:
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
   absl::optional<Api::IoError::IoErrorCode> detected_io_error_;
+  // Whether the kernel encrypts the records written on the socket.
+  bool kernel_tls_tx_{false};
+  // Only created if the context compacts idle connections.
+  Event::TimerPtr idle_compaction_timer_;
+  MonotonicTime last_activity_;
+  bool compacted_{false};
 
   SslHandshakerImplSharedPtr info_;
 };
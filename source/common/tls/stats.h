@@ -21,7 +21,13 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
-  COUNTER(was_key_usage_invalid)
+  COUNTER(was_key_usage_invalid)                                                                   \
+  COUNTER(kernel_tls_tx)                                                                           \
+  COUNTER(shared_session_cache_hit)                                                                \
+  COUNTER(shared_session_cache_miss)                                                               \
+  COUNTER(idle_compaction)                                                                         \
+  GAUGE(idle_compacted, Accumulate)                                                                \
+  HISTOGRAM(idle_compaction_released, Bytes)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
@@ -16,7 +16,12 @@ FileAccessLog::FileAccessLog(const Filesystem::FilePathAndType& access_log_file_
 
 void FileAccessLog::emitLog(const Formatter::Context& context,
                             const StreamInfo::StreamInfo& stream_info) {
-  log_file_->write(formatter_->format(context, stream_info));
+  // The line is formatted into a per-thread buffer whose capacity is kept across log entries, so
+  // that steady state logging does not allocate. write() copies the line before returning.
+  static thread_local std::string log_line;
+  log_line.clear();
+  formatter_->formatTo(context, stream_info, log_line);
+  log_file_->write(log_line);
 }
 
 } // namespace File
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/config/core/v3/config_source.pb.h"
@@ -110,10 +111,15 @@ public:
       : client_(std::move(client)), buffer_flush_interval_msec_(PROTOBUF_GET_MS_OR_DEFAULT(
                                         config, buffer_flush_interval, 1000)),
         flush_timer_(dispatcher.createTimer([this]() {
+          onFlushInterval();
           flush();
           flush_timer_->enableTimer(buffer_flush_interval_msec_);
         })),
-        max_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)) {
+        min_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)),
+        max_buffer_size_bytes_(std::max<uint64_t>(
+            min_buffer_size_bytes_, PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_buffer_size_bytes,
+                                                                    0))),
+        buffer_size_bytes_(min_buffer_size_bytes_) {
     flush_timer_->enableTimer(buffer_flush_interval_msec_);
     if (access_log_prefix.has_value()) {
       stats_ = std::make_unique<GrpcAccessLoggerStats>(GrpcAccessLoggerStats{
@@ -127,19 +133,24 @@ public:
     }
     approximate_message_size_bytes_ += entry.ByteSizeLong();
     addEntry(std::move(entry));
-    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
-      flush();
+    if (approximate_message_size_bytes_ >= buffer_size_bytes_) {
+      flushFullBuffer();
     }
   }
 
   void log(TcpLogProto&& entry) override {
     approximate_message_size_bytes_ += entry.ByteSizeLong();
     addEntry(std::move(entry));
-    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
-      flush();
+    if (approximate_message_size_bytes_ >= buffer_size_bytes_) {
+      flushFullBuffer();
     }
   }
 
+  /**
+   * @return uint64_t the current buffer size limit in bytes.
+   */
+  uint64_t bufferSizeBytes() const { return buffer_size_bytes_; }
+
 protected:
   std::unique_ptr<GrpcAccessLogClient<LogRequest, LogResponse>> client_;
   LogRequest message_;
@@ -151,6 +162,21 @@ private:
   virtual void addEntry(TcpLogProto&& entry) PURE;
   virtual void clearMessage() { message_.Clear(); }
 
+  // Grows the buffer size limit, if adaptive, before flushing a full buffer.
+  void flushFullBuffer() {
+    filled_buffer_ = true;
+    buffer_size_bytes_ = std::min(buffer_size_bytes_ * 2, max_buffer_size_bytes_);
+    flush();
+  }
+
+  // Shrinks the buffer size limit, if adaptive, when the last interval had little to log.
+  void onFlushInterval() {
+    if (!filled_buffer_ && approximate_message_size_bytes_ < buffer_size_bytes_ / 2) {
+      buffer_size_bytes_ = std::max(buffer_size_bytes_ / 2, min_buffer_size_bytes_);
+    }
+    filled_buffer_ = false;
+  }
+
   void flush() {
     if (isEmpty()) {
       // Nothing to flush.
@@ -177,12 +203,12 @@ private:
   // [1]https://github.com/envoyproxy/envoy/blob/cd5ef906026160ec2cd766d8d18217e668c256d8/source/extensions/access_loggers/common/grpc_access_logger.h#L287.
   // [2]https://github.com/envoyproxy/envoy/blob/cd5ef906026160ec2cd766d8d18217e668c256d8/source/extensions/access_loggers/common/grpc_access_logger.h#L126
   bool canLogMore() {
-    if (max_buffer_size_bytes_ == 0 || approximate_message_size_bytes_ < max_buffer_size_bytes_) {
+    if (buffer_size_bytes_ == 0 || approximate_message_size_bytes_ < buffer_size_bytes_) {
       incLogsWrittenStats();
       return true;
     }
     flush();
-    if (approximate_message_size_bytes_ < max_buffer_size_bytes_) {
+    if (approximate_message_size_bytes_ < buffer_size_bytes_) {
       incLogsWrittenStats();
       return true;
     }
@@ -204,7 +230,13 @@ private:
 
   const std::chrono::milliseconds buffer_flush_interval_msec_;
   const Event::TimerPtr flush_timer_;
+  // The buffer size limit stays within [min_buffer_size_bytes_, max_buffer_size_bytes_], which
+  // are the same unless the limit is adaptive.
+  const uint64_t min_buffer_size_bytes_;
   const uint64_t max_buffer_size_bytes_;
+  uint64_t buffer_size_bytes_;
+  // Whether the buffer filled up since the last flush interval.
+  bool filled_buffer_{false};
   uint64_t approximate_message_size_bytes_ = 0;
   std::unique_ptr<GrpcAccessLoggerStats> stats_ = nullptr;
 };
@@ -0,0 +1,37 @@
+#include "source/extensions/access_loggers/filters/exemplar/config.h"
+
+#include "envoy/extensions/access_loggers/filters/exemplar/v3/exemplar.pb.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/filters/exemplar/filter.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace Exemplar {
+
+AccessLog::FilterPtr
+ExemplarFilterFactory::createFilter(const envoy::config::accesslog::v3::ExtensionFilter& config,
+                                    Server::Configuration::GenericFactoryContext& context) {
+  auto factory_config =
+      Config::Utility::translateToFactoryConfig(config, context.messageValidationVisitor(), *this);
+  const auto& exemplar_config = dynamic_cast<
+      const envoy::extensions::access_loggers::filters::exemplar::v3::ExemplarFilter&>(
+      *factory_config);
+  return std::make_unique<ExemplarFilter>(context, exemplar_config);
+}
+
+ProtobufTypes::MessagePtr ExemplarFilterFactory::createEmptyConfigProto() {
+  return std::make_unique<
+      envoy::extensions::access_loggers::filters::exemplar::v3::ExemplarFilter>();
+}
+
+REGISTER_FACTORY(ExemplarFilterFactory, AccessLog::ExtensionFilterFactory);
+
+} // namespace Exemplar
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,59 @@
+#include "source/extensions/access_loggers/filters/exemplar/filter.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace Exemplar {
+
+ExemplarFilter::ExemplarFilter(
+    Server::Configuration::GenericFactoryContext& context,
+    const envoy::extensions::access_loggers::filters::exemplar::v3::ExemplarFilter& config)
+    : key_formatter_(THROW_OR_RETURN_VALUE(Formatter::FormatterImpl::create(config.key_format()),
+                                           Formatter::FormatterPtr)),
+      interval_(PROTOBUF_GET_MS_REQUIRED(config, interval)),
+      max_entries_per_key_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries_per_key, 1)),
+      max_keys_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_keys, 1000)),
+      time_source_(context.serverFactoryContext().timeSource()),
+      stats_({ALL_EXEMPLAR_FILTER_STATS(
+          POOL_COUNTER_PREFIX(context.serverFactoryContext().scope(), "access_log.exemplar."))}),
+      budgets_(context.serverFactoryContext().threadLocal()) {
+  budgets_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalBudgets>(); });
+}
+
+bool ExemplarFilter::evaluate(const Formatter::Context& log_context,
+                              const StreamInfo::StreamInfo& stream_info) const {
+  ThreadLocalBudgets& budgets = *budgets_;
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now - budgets.interval_start_ >= interval_) {
+    budgets.entries_.clear();
+    budgets.interval_start_ = now;
+  }
+
+  budgets.key_.clear();
+  key_formatter_->formatTo(log_context, stream_info, budgets.key_);
+  auto it = budgets.entries_.find(budgets.key_);
+  if (it == budgets.entries_.end()) {
+    if (budgets.entries_.size() >= max_keys_) {
+      stats_.denied_.inc();
+      return false;
+    }
+    it = budgets.entries_.emplace(budgets.key_, 0).first;
+  }
+  if (it->second >= max_entries_per_key_) {
+    stats_.denied_.inc();
+    return false;
+  }
+  ++it->second;
+  stats_.allowed_.inc();
+  return true;
+}
+
+} // namespace Exemplar
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/common/time.h"
+#include "envoy/extensions/access_loggers/filters/exemplar/v3/exemplar.pb.h"
+#include "envoy/formatter/substitution_formatter.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace Exemplar {
+
+#define ALL_EXEMPLAR_FILTER_STATS(COUNTER)                                                         \
+  COUNTER(allowed)                                                                                 \
+  COUNTER(denied)
+
+/**
+ * Struct definition for all exemplar filter stats. @see stats_macros.h
+ */
+struct ExemplarFilterStats {
+  ALL_EXEMPLAR_FILTER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Access log filter that lets a bounded number of entries through for every distinct key in
+ * every interval. The budgets are kept per worker so that evaluation never takes a lock.
+ */
+class ExemplarFilter : public AccessLog::Filter {
+public:
+  ExemplarFilter(
+      Server::Configuration::GenericFactoryContext& context,
+      const envoy::extensions::access_loggers::filters::exemplar::v3::ExemplarFilter& config);
+
+  bool evaluate(const Formatter::Context& log_context,
+                const StreamInfo::StreamInfo& stream_info) const override;
+
+private:
+  struct ThreadLocalBudgets : public ThreadLocal::ThreadLocalObject {
+    MonotonicTime interval_start_;
+    // The number of entries that passed in the current interval, by key.
+    absl::flat_hash_map<std::string, uint32_t> entries_;
+    // Reused to format the key of every entry.
+    std::string key_;
+  };
+
+  const Formatter::FormatterPtr key_formatter_;
+  const std::chrono::milliseconds interval_;
+  const uint32_t max_entries_per_key_;
+  const uint32_t max_keys_;
+  TimeSource& time_source_;
+  ExemplarFilterStats stats_;
+  mutable ThreadLocal::TypedSlot<ThreadLocalBudgets> budgets_;
+};
+
+} // namespace Exemplar
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
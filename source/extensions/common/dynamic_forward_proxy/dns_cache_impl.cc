@@ -1,8 +1,11 @@
 #include "source/extensions/common/dynamic_forward_proxy/dns_cache_impl.h"
 
+#include <algorithm>
+
 #include "envoy/extensions/common/dynamic_forward_proxy/v3/dns_cache.pb.h"
 
 #include "source/common/common/dns_utils.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/stl_helpers.h"
 #include "source/common/config/utility.h"
 #include "source/common/http/utility.h"
@@ -51,7 +54,8 @@ DnsCacheImpl::DnsCacheImpl(
       file_system_(context.serverFactoryContext().api().fileSystem()),
       validation_visitor_(context.messageValidationVisitor()),
       host_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, host_ttl, 300000)),
-      max_hosts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts, 1024)) {
+      max_hosts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts, 1024)),
+      evict_least_recently_used_hosts_(config.evict_least_recently_used_hosts()) {
   tls_slot_.set([&](Event::Dispatcher&) { return std::make_shared<ThreadLocalHostInfo>(*this); });
 
   loadCacheEntries(config);
@@ -73,10 +77,12 @@ DnsCacheImpl::DnsCacheImpl(
 }
 
 DnsCacheImpl::~DnsCacheImpl() {
-  for (const auto& primary_host : primary_hosts_) {
-    if (primary_host.second->active_query_ != nullptr) {
-      primary_host.second->active_query_->cancel(
-          Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  for (auto& shard : primary_host_shards_) {
+    for (const auto& primary_host : shard.hosts_) {
+      if (primary_host.second->active_query_ != nullptr) {
+        primary_host.second->active_query_->cancel(
+            Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+      }
     }
   }
 
@@ -128,10 +134,11 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
   bool ignore_cached_entries = force_refresh;
 
   {
-    absl::ReaderMutexLock read_lock{primary_hosts_lock_};
-    is_overflow = primary_hosts_.size() >= max_hosts_;
-    auto tls_host = primary_hosts_.find(host);
-    if (tls_host != primary_hosts_.end() && tls_host->second->host_info_->firstResolveComplete()) {
+    is_overflow = !evict_least_recently_used_hosts_ && num_primary_hosts_ >= max_hosts_;
+    PrimaryHostShard& shard = primaryHostShard(host);
+    absl::ReaderMutexLock read_lock{shard.lock_};
+    auto tls_host = shard.hosts_.find(host);
+    if (tls_host != shard.hosts_.end() && tls_host->second->host_info_->firstResolveComplete()) {
       host_info = tls_host->second->host_info_;
     }
   }
@@ -178,11 +185,13 @@ Upstream::ResourceAutoIncDecPtr DnsCacheImpl::canCreateDnsRequest() {
 }
 
 void DnsCacheImpl::iterateHostMap(IterateHostMapCb iterate_callback) {
-  absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-  for (const auto& host : primary_hosts_) {
-    // Only include hosts that have ever resolved to an address.
-    if (host.second->host_info_->address() != nullptr) {
-      iterate_callback(host.first, host.second->host_info_);
+  for (auto& shard : primary_host_shards_) {
+    absl::ReaderMutexLock reader_lock{shard.lock_};
+    for (const auto& host : shard.hosts_) {
+      // Only include hosts that have ever resolved to an address.
+      if (host.second->host_info_->address() != nullptr) {
+        iterate_callback(host.first, host.second->host_info_);
+      }
     }
   }
 }
@@ -190,9 +199,10 @@ void DnsCacheImpl::iterateHostMap(IterateHostMapCb iterate_callback) {
 absl::optional<const DnsHostInfoSharedPtr> DnsCacheImpl::getHost(absl::string_view host_name) {
   // Find a host with the given name.
   const auto host_info = [&]() -> const DnsHostInfoSharedPtr {
-    absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-    auto it = primary_hosts_.find(host_name);
-    return it != primary_hosts_.end() ? it->second->host_info_ : nullptr;
+    PrimaryHostShard& shard = primaryHostShard(host_name);
+    absl::ReaderMutexLock reader_lock{shard.lock_};
+    auto it = shard.hosts_.find(host_name);
+    return it != shard.hosts_.end() ? it->second->host_info_ : nullptr;
   }();
 
   // Only include hosts that have ever resolved to an address.
@@ -216,13 +226,7 @@ void DnsCacheImpl::startCacheLoad(const std::string& host, uint16_t default_port
   // already in the map it's either in the process of being resolved or the resolution is already
   // heading out to the worker threads. Either way the pending resolution will be completed.
 
-  // Functions like this one that modify primary_hosts_ are only called in the main thread so we
-  // know it is safe to use the PrimaryHostInfo pointers outside of the lock.
-  auto* primary_host = [&]() {
-    absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-    auto host_it = primary_hosts_.find(host);
-    return host_it != primary_hosts_.end() ? host_it->second.get() : nullptr;
-  }();
+  auto* primary_host = findPrimaryHost(host);
 
   if (primary_host) {
     if (!ignore_cached_entries || !primary_host->host_info_->firstResolveComplete()) {
@@ -234,6 +238,22 @@ void DnsCacheImpl::startCacheLoad(const std::string& host, uint16_t default_port
     removeHost(host, *primary_host, false);
   }
 
+  if (evict_least_recently_used_hosts_ && num_primary_hosts_ >= max_hosts_) {
+    evictLeastRecentlyUsedHosts();
+    if (num_primary_hosts_ >= max_hosts_) {
+      // Every host is being resolved, so none could be evicted. Fail the requests waiting for the
+      // host as loadDnsCacheEntry() would have, rather than go over max_hosts.
+      ENVOY_LOG(debug, "DNS cache overflow for host '{}'", host);
+      stats_.host_overflow_.inc();
+      const auto host_attributes = Http::Utility::parseAuthority(host);
+      auto host_info = std::make_shared<DnsHostInfoImpl>(*this, host_attributes.host_,
+                                                         host_attributes.is_ip_address_);
+      host_info->setDetails("dns_cache_overflow");
+      notifyThreads(host, host_info);
+      return;
+    }
+  }
+
   primary_host = createHost(host, default_port);
   // If the DNS request was simply to create a host endpoint in a Dynamic Forward Proxy cluster,
   // fast fail the look-up as the address is not needed.
@@ -251,28 +271,41 @@ DnsCacheImpl::PrimaryHostInfo* DnsCacheImpl::createHost(const std::string& host,
   // TODO(mattklein123): Right now, the same host with different ports will become two
   // independent primary hosts with independent DNS resolutions. I'm not sure how much this will
   // matter, but we could consider collapsing these down and sharing the underlying DNS resolution.
-  {
-    absl::WriterMutexLock writer_lock{primary_hosts_lock_};
-    return primary_hosts_
-        // try_emplace() is used here for direct argument forwarding.
-        .try_emplace(host,
-                     std::make_unique<PrimaryHostInfo>(
-                         *this, std::string(host_attributes.host_),
-                         host_attributes.port_.value_or(default_port),
-                         host_attributes.is_ip_address_, [this, host]() { onReResolveAlarm(host); },
-                         [this, host]() { onResolveTimeout(host); }))
-        .first->second.get();
-  }
+  PrimaryHostShard& shard = primaryHostShard(host);
+  absl::WriterMutexLock writer_lock{shard.lock_};
+  // try_emplace() is used here for direct argument forwarding.
+  auto [host_it, inserted] = shard.hosts_.try_emplace(
+      host, std::make_unique<PrimaryHostInfo>(
+                *this, std::string(host_attributes.host_),
+                host_attributes.port_.value_or(default_port), host_attributes.is_ip_address_,
+                [this, host]() { onReResolveAlarm(host); },
+                [this, host]() { onResolveTimeout(host); }));
+  if (inserted) {
+    ++num_primary_hosts_;
+  }
+  return host_it->second.get();
+}
+
+DnsCacheImpl::PrimaryHostShard& DnsCacheImpl::primaryHostShard(absl::string_view host) {
+  // The shard is picked with a different hash function than the one of the shard maps, so that
+  // the hosts of a shard are still spread evenly across its map.
+  return primary_host_shards_[HashUtil::xxHash64(host) % NUM_PRIMARY_HOST_SHARDS];
+}
+
+DnsCacheImpl::PrimaryHostInfo* DnsCacheImpl::findPrimaryHost(const std::string& host) {
+  // Functions that modify the primary hosts are only called in the main thread so we know it is
+  // safe to use the PrimaryHostInfo pointers outside of the lock.
+  ASSERT(main_thread_dispatcher_.isThreadSafe());
+  PrimaryHostShard& shard = primaryHostShard(host);
+  absl::ReaderMutexLock reader_lock{shard.lock_};
+  auto host_it = shard.hosts_.find(host);
+  return host_it != shard.hosts_.end() ? host_it->second.get() : nullptr;
 }
 
 DnsCacheImpl::PrimaryHostInfo& DnsCacheImpl::getPrimaryHost(const std::string& host) {
-  // Functions modify primary_hosts_ are only called in the main thread so we
-  // know it is safe to use the PrimaryHostInfo pointers outside of the lock.
-  ASSERT(main_thread_dispatcher_.isThreadSafe());
-  absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-  const auto primary_host_it = primary_hosts_.find(host);
-  ASSERT(primary_host_it != primary_hosts_.end());
-  return *(primary_host_it->second);
+  PrimaryHostInfo* primary_host = findPrimaryHost(host);
+  ASSERT(primary_host != nullptr);
+  return *primary_host;
 }
 
 void DnsCacheImpl::onResolveTimeout(const std::string& host) {
@@ -316,11 +349,13 @@ void DnsCacheImpl::removeHost(const std::string& host, const PrimaryHostInfo& pr
   }
   {
     removeCacheEntry(host);
-    absl::WriterMutexLock writer_lock{primary_hosts_lock_};
-    auto host_it = primary_hosts_.find(host);
-    ASSERT(host_it != primary_hosts_.end());
+    PrimaryHostShard& shard = primaryHostShard(host);
+    absl::WriterMutexLock writer_lock{shard.lock_};
+    auto host_it = shard.hosts_.find(host);
+    ASSERT(host_it != shard.hosts_.end());
     host_to_erase = std::move(host_it->second);
-    primary_hosts_.erase(host_it);
+    shard.hosts_.erase(host_it);
+    --num_primary_hosts_;
   }
   // In the case of force-remove and resolve, don't cancel outstanding resolve
   // callbacks on remove, as a resolve is pending.
@@ -329,31 +364,63 @@ void DnsCacheImpl::removeHost(const std::string& host, const PrimaryHostInfo& pr
   }
 }
 
+void DnsCacheImpl::evictLeastRecentlyUsedHosts() {
+  ASSERT(main_thread_dispatcher_.isThreadSafe());
+  // Evict a batch of hosts at a time, so that the scan of the cache is amortized over the hosts
+  // added after it.
+  const size_t batch_size = std::max<size_t>(1, max_hosts_ / NUM_PRIMARY_HOST_SHARDS);
+  std::vector<std::pair<std::chrono::steady_clock::duration, std::string>> candidates;
+  candidates.reserve(num_primary_hosts_);
+  for (auto& shard : primary_host_shards_) {
+    absl::ReaderMutexLock reader_lock{shard.lock_};
+    for (const auto& primary_host : shard.hosts_) {
+      // A host being resolved has just been added or refreshed, so it isn't a candidate.
+      if (primary_host.second->active_query_ == nullptr) {
+        candidates.emplace_back(primary_host.second->host_info_->lastUsedTime(),
+                                primary_host.first);
+      }
+    }
+  }
+
+  const size_t num_evicted = std::min(batch_size, candidates.size());
+  std::nth_element(candidates.begin(), candidates.begin() + num_evicted, candidates.end(),
+                   [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  for (size_t i = 0; i < num_evicted; ++i) {
+    const std::string& host = candidates[i].second;
+    ENVOY_LOG(debug, "DNS cache full, evicting least recently used host '{}'", host);
+    stats_.host_evicted_.inc();
+    removeHost(host, getPrimaryHost(host), true);
+  }
+}
+
 void DnsCacheImpl::forceRefreshHosts() {
   ENVOY_LOG(debug, "beginning DNS cache force refresh");
   // Tell the underlying resolver to reset itself since we likely just went through a network
   // transition and parameters may have changed.
   resolver_->resetNetworking();
 
-  absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-  for (auto& primary_host : primary_hosts_) {
-    // Avoid holding the lock for longer than necessary by just triggering the refresh timer for
-    // each host IFF the host is not already refreshing. Cancellation is assumed to be cheap for
-    // resolvers.
-    if (primary_host.second->active_query_ != nullptr) {
-      primary_host.second->active_query_->cancel(
-          Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
-      primary_host.second->active_query_ = nullptr;
-      if (timeout_interval_.count() > 0) {
-        primary_host.second->timeout_timer_->disableTimer();
+  for (auto& shard : primary_host_shards_) {
+    absl::ReaderMutexLock reader_lock{shard.lock_};
+    for (auto& primary_host : shard.hosts_) {
+      // Avoid holding the lock for longer than necessary by just triggering the refresh timer for
+      // each host IFF the host is not already refreshing. Cancellation is assumed to be cheap for
+      // resolvers.
+      if (primary_host.second->active_query_ != nullptr) {
+        primary_host.second->active_query_->cancel(
+            Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+        primary_host.second->active_query_ = nullptr;
+        if (timeout_interval_.count() > 0) {
+          primary_host.second->timeout_timer_->disableTimer();
+        }
       }
-    }
 
-    if (timeout_interval_.count() > 0) {
-      ASSERT(!primary_host.second->timeout_timer_->enabled());
+      if (timeout_interval_.count() > 0) {
+        ASSERT(!primary_host.second->timeout_timer_->enabled());
+      }
+      primary_host.second->refresh_timer_->enableTimer(std::chrono::milliseconds(0), nullptr);
+      ENVOY_LOG_EVENT(debug, "force_refresh_host", "force refreshing host='{}'",
+                      primary_host.first);
     }
-    primary_host.second->refresh_timer_->enableTimer(std::chrono::milliseconds(0), nullptr);
-    ENVOY_LOG_EVENT(debug, "force_refresh_host", "force refreshing host='{}'", primary_host.first);
   }
 }
 
@@ -373,20 +440,22 @@ void DnsCacheImpl::stop() {
   // transition and parameters may have changed.
   resolver_->resetNetworking();
 
-  absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-  for (auto& primary_host : primary_hosts_) {
-    if (primary_host.second->active_query_ != nullptr) {
-      primary_host.second->active_query_->cancel(
-          Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
-      primary_host.second->active_query_ = nullptr;
-    }
+  for (auto& shard : primary_host_shards_) {
+    absl::ReaderMutexLock reader_lock{shard.lock_};
+    for (auto& primary_host : shard.hosts_) {
+      if (primary_host.second->active_query_ != nullptr) {
+        primary_host.second->active_query_->cancel(
+            Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+        primary_host.second->active_query_ = nullptr;
+      }
 
-    if (timeout_interval_.count() > 0) {
-      primary_host.second->timeout_timer_->disableTimer();
-      ASSERT(!primary_host.second->timeout_timer_->enabled());
+      if (timeout_interval_.count() > 0) {
+        primary_host.second->timeout_timer_->disableTimer();
+        ASSERT(!primary_host.second->timeout_timer_->enabled());
+      }
+      primary_host.second->refresh_timer_->disableTimer();
+      ENVOY_LOG_EVENT(debug, "stop_host", "stop host='{}'", primary_host.first);
     }
-    primary_host.second->refresh_timer_->disableTimer();
-    ENVOY_LOG_EVENT(debug, "stop_host", "stop host='{}'", primary_host.first);
   }
 }
 
@@ -441,14 +510,8 @@ void DnsCacheImpl::finishResolve(const std::string& host,
                   }));
   const bool from_cache = resolution_time.has_value();
 
-  // Functions like this one that modify primary_hosts_ are only called in the main thread so we
-  // know it is safe to use the PrimaryHostInfo pointers outside of the lock.
-  auto* primary_host_info = [this, &host]() {
-    absl::ReaderMutexLock reader_lock{primary_hosts_lock_};
-    const auto primary_host_it = primary_hosts_.find(host);
-    ASSERT(primary_host_it != primary_hosts_.end());
-    return primary_host_it->second.get();
-  }();
+  auto* primary_host_info = findPrimaryHost(host);
+  ASSERT(primary_host_info != nullptr);
 
   if (primary_host_info == nullptr) {
     ENVOY_LOG(warn, "host '{}' was removed during resolution, skipping update", host);
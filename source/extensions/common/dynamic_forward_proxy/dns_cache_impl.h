@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include "envoy/common/backoff_strategy.h"
 #include "envoy/common/key_value_store.h"
 #include "envoy/extensions/common/dynamic_forward_proxy/v3/dns_cache.pb.h"
@@ -31,6 +34,7 @@ namespace DynamicForwardProxy {
   COUNTER(dns_query_timeout)                                                                       \
   COUNTER(host_added)                                                                              \
   COUNTER(host_address_changed)                                                                    \
+  COUNTER(host_evicted)                                                                            \
   COUNTER(host_overflow)                                                                           \
   COUNTER(host_removed)                                                                            \
   COUNTER(dns_rq_pending_overflow)                                                                 \
@@ -181,8 +185,20 @@ private:
   void startCacheLoad(const std::string& host, uint16_t default_port, bool is_proxy_lookup,
                       bool disallow_cached_results);
 
-  void startResolve(const std::string& host, PrimaryHostInfo& host_info)
-      ABSL_LOCKS_EXCLUDED(primary_hosts_lock_);
+  // Primary hosts are split into shards by host name, so that worker lookups only contend with
+  // main thread updates of the hosts in the same shard.
+  struct PrimaryHostShard {
+    absl::Mutex lock_;
+    absl::flat_hash_map<std::string, PrimaryHostInfoPtr> hosts_ ABSL_GUARDED_BY(lock_);
+  };
+  static constexpr size_t NUM_PRIMARY_HOST_SHARDS = 16;
+
+  PrimaryHostShard& primaryHostShard(absl::string_view host);
+  // Returns the primary host, or nullptr if it isn't in the cache. Only safe to use on the main
+  // thread, which is the only one that adds or removes primary hosts.
+  PrimaryHostInfo* findPrimaryHost(const std::string& host);
+
+  void startResolve(const std::string& host, PrimaryHostInfo& host_info);
 
   void finishResolve(const std::string& host, Network::DnsResolver::ResolutionStatus status,
                      absl::string_view details, std::list<Network::DnsResponse>&& response,
@@ -197,6 +213,7 @@ private:
   void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
   void onReResolveAlarm(const std::string& host);
   void removeHost(const std::string& host, const PrimaryHostInfo& host_info, bool update_threads);
+  void evictLeastRecentlyUsedHosts();
   void onResolveTimeout(const std::string& host);
   PrimaryHostInfo& getPrimaryHost(const std::string& host);
 
@@ -219,9 +236,9 @@ private:
   Stats::ScopeSharedPtr scope_;
   DnsCacheStats stats_;
   std::list<AddUpdateCallbacksHandleImpl*> update_callbacks_;
-  absl::Mutex primary_hosts_lock_;
-  absl::flat_hash_map<std::string, PrimaryHostInfoPtr>
-      primary_hosts_ ABSL_GUARDED_BY(primary_hosts_lock_);
+  std::array<PrimaryHostShard, NUM_PRIMARY_HOST_SHARDS> primary_host_shards_;
+  // The number of primary hosts across all shards. Only written on the main thread.
+  std::atomic<size_t> num_primary_hosts_{};
   std::unique_ptr<KeyValueStore> key_value_store_;
   DnsCacheResourceManagerImpl resource_manager_;
   const std::chrono::milliseconds refresh_interval_;
@@ -231,6 +248,7 @@ private:
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const std::chrono::milliseconds host_ttl_;
   const uint32_t max_hosts_;
+  const bool evict_least_recently_used_hosts_;
   absl::Mutex ip_version_to_remove_lock_;
   absl::optional<Network::Address::IpVersion>
       ip_version_to_remove_ ABSL_GUARDED_BY(ip_version_to_remove_lock_) = absl::nullopt;
@@ -12,6 +12,30 @@ namespace Compression {
 namespace Brotli {
 namespace Compressor {
 
+/**
+ * A raw dictionary prepared for the brotli encoder. Preparing a dictionary hashes its content,
+ * which is too expensive to repeat for every stream, so one instance is built per configuration
+ * and shared read-only by all compressors on all workers.
+ */
+class BrotliCompressorDictionary : NonCopyable {
+public:
+  /**
+   * @param data raw dictionary content.
+   * @param quality compression quality the dictionary is prepared for.
+   */
+  BrotliCompressorDictionary(std::string data, uint32_t quality);
+  ~BrotliCompressorDictionary();
+
+  const BrotliEncoderPreparedDictionary* prepared() const { return prepared_; }
+
+private:
+  // The prepared dictionary refers to the raw content, which must outlive it.
+  const std::string data_;
+  BrotliEncoderPreparedDictionary* prepared_;
+};
+
+using BrotliCompressorDictionarySharedPtr = std::shared_ptr<const BrotliCompressorDictionary>;
+
 /**
  * Implementation of compressor's interface.
  */
@@ -44,10 +68,12 @@ public:
    * feature. This flag is a "decoding-speed vs compression ratio" trade-off.
    * @param mode tunes encoder for specific input. @see EncoderMode enum.
    * @param chunk_size amount of memory reserved for the compressor output.
+   * @param dictionary optional dictionary to compress with.
    */
   BrotliCompressorImpl(const uint32_t quality, const uint32_t window_bits,
                        const uint32_t input_block_bits, const bool disable_literal_context_modeling,
-                       const EncoderMode mode, const uint32_t chunk_size);
+                       const EncoderMode mode, const uint32_t chunk_size,
+                       BrotliCompressorDictionarySharedPtr dictionary = nullptr);
 
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
@@ -57,6 +83,8 @@ private:
                const BrotliEncoderOperation op);
 
   const uint32_t chunk_size_;
+  // Keeps the attached dictionary alive for the lifetime of the encoder.
+  const BrotliCompressorDictionarySharedPtr dictionary_;
   std::unique_ptr<BrotliEncoderState, decltype(&BrotliEncoderDestroyInstance)> state_;
 };
 
@@ -22,14 +22,22 @@ constexpr uint32_t MaxInflateRatio = 100;
 
 BrotliDecompressorImpl::BrotliDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
                                                const uint32_t chunk_size,
-                                               const bool disable_ring_buffer_reallocation)
-    : chunk_size_{chunk_size},
+                                               const bool disable_ring_buffer_reallocation,
+                                               BrotliDecompressorDictionarySharedPtr dictionary)
+    : chunk_size_{chunk_size}, dictionary_(std::move(dictionary)),
       state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr), &BrotliDecoderDestroyInstance),
       stats_(generateStats(stats_prefix, scope)) {
   BROTLI_BOOL result =
       BrotliDecoderSetParameter(state_.get(), BROTLI_DECODER_PARAM_DISABLE_RING_BUFFER_REALLOCATION,
                                 disable_ring_buffer_reallocation ? BROTLI_TRUE : BROTLI_FALSE);
   RELEASE_ASSERT(result == BROTLI_TRUE, "");
+
+  if (dictionary_ != nullptr) {
+    result = BrotliDecoderAttachDictionary(state_.get(), BROTLI_SHARED_DICTIONARY_RAW,
+                                           dictionary_->size(),
+                                           reinterpret_cast<const uint8_t*>(dictionary_->data()));
+    RELEASE_ASSERT(result == BROTLI_TRUE, "unable to attach brotli dictionary");
+  }
 }
 
 void BrotliDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
@@ -29,6 +29,11 @@ struct BrotliDecompressorStats {
   ALL_BROTLI_DECOMPRESSOR_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * Raw dictionary content shared by all decompressors created from one configuration.
+ */
+using BrotliDecompressorDictionarySharedPtr = std::shared_ptr<const std::string>;
+
 /**
  * Implementation of decompressor's interface.
  */
@@ -40,9 +45,11 @@ public:
    * @param disable_ring_buffer_reallocation if true disables "canny" ring buffer allocation
    * strategy. Ring buffer is allocated according to window size, despite the real size of the
    * content.
+   * @param dictionary optional raw dictionary the input was compressed with.
    */
   BrotliDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
-                         const uint32_t chunk_size, bool disable_ring_buffer_reallocation);
+                         const uint32_t chunk_size, bool disable_ring_buffer_reallocation,
+                         BrotliDecompressorDictionarySharedPtr dictionary = nullptr);
 
   // Envoy::Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
@@ -56,6 +63,8 @@ private:
   bool process(Common::BrotliContext& ctx, Buffer::Instance& output_buffer);
 
   const uint32_t chunk_size_;
+  // The decoder refers to the attached dictionary without copying it.
+  const BrotliDecompressorDictionarySharedPtr dictionary_;
   std::unique_ptr<BrotliDecoderState, decltype(&BrotliDecoderDestroyInstance)> state_;
   const BrotliDecompressorStats stats_;
 };
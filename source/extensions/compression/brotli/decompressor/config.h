@@ -4,6 +4,7 @@
 #include "envoy/extensions/compression/brotli/decompressor/v3/brotli.pb.h"
 #include "envoy/extensions/compression/brotli/decompressor/v3/brotli.pb.validate.h"
 
+#include "source/common/config/datasource.h"
 #include "source/common/http/headers.h"
 #include "source/extensions/compression/brotli/decompressor/brotli_decompressor_impl.h"
 #include "source/extensions/compression/common/decompressor/factory_base.h"
@@ -26,7 +27,7 @@ class BrotliDecompressorFactory : public Envoy::Compression::Decompressor::Decom
 public:
   BrotliDecompressorFactory(
       const envoy::extensions::compression::brotli::decompressor::v3::Brotli& brotli,
-      Stats::Scope& scope);
+      Stats::Scope& scope, Api::Api& api);
 
   // Envoy::Compression::Decompressor::DecompressorFactory
   Envoy::Compression::Decompressor::DecompressorPtr
@@ -40,6 +41,7 @@ private:
   Stats::Scope& scope_;
   const uint32_t chunk_size_;
   const bool disable_ring_buffer_reallocation_;
+  BrotliDecompressorDictionarySharedPtr dictionary_;
 };
 
 class BrotliDecompressorLibraryFactory
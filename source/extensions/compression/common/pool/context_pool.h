@@ -0,0 +1,170 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/compression/decompressor/decompressor.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Pool {
+
+/**
+ * All context pool stats. @see stats_macros.h
+ */
+#define ALL_CONTEXT_POOL_STATS(COUNTER)                                                            \
+  COUNTER(hit)  /* A stream reused an idle context. */                                             \
+  COUNTER(miss) /* A stream had to initialize a new context. */
+
+/**
+ * Struct definition for context pool stats. @see stats_macros.h
+ */
+struct ContextPoolStats {
+  ALL_CONTEXT_POOL_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Per worker pool of compression library contexts. Initializing a context can cost more than
+ * compressing a small body with it (deflateInit2 allocates a few hundred KB of state), so contexts
+ * are reset at the end of a stream and kept for the next stream on the same worker instead of
+ * being torn down. Context must provide reset(), which returns it to its freshly initialized
+ * state without releasing its memory.
+ *
+ * Contexts are keyed so that a pool can hold contexts that differ in some fixed property, e.g. the
+ * stats prefix a decompressor reports errors under.
+ */
+template <class Context> class ContextPool : NonCopyable {
+public:
+  using ContextPtr = std::unique_ptr<Context>;
+  using ContextFactory = std::function<ContextPtr()>;
+
+private:
+  using IdleContexts = std::vector<ContextPtr>;
+  using IdleContextsSharedPtr = std::shared_ptr<IdleContexts>;
+
+public:
+  /**
+   * Returns a context to the idle list of the worker it was acquired on. Contexts outliving the
+   * pool, or exceeding its capacity, are destroyed instead.
+   */
+  class Releaser {
+  public:
+    Releaser() = default;
+    Releaser(std::weak_ptr<IdleContexts> idle, uint32_t max_idle)
+        : idle_(std::move(idle)), max_idle_(max_idle) {}
+
+    void operator()(Context* context) const {
+      ContextPtr owned(context);
+      IdleContextsSharedPtr idle = idle_.lock();
+      if (idle != nullptr && idle->size() < max_idle_) {
+        owned->reset();
+        idle->push_back(std::move(owned));
+      }
+    }
+
+  private:
+    std::weak_ptr<IdleContexts> idle_;
+    uint32_t max_idle_{};
+  };
+  using PooledContextPtr = std::unique_ptr<Context, Releaser>;
+
+  /**
+   * @param tls slot allocator for the per worker idle lists.
+   * @param scope stats scope for the pool stats.
+   * @param stats_prefix prefix of the pool stats.
+   * @param max_idle maximum number of idle contexts kept per worker and key.
+   */
+  ContextPool(ThreadLocal::SlotAllocator& tls, Stats::Scope& scope,
+              const std::string& stats_prefix, uint32_t max_idle)
+      : tls_slot_(ThreadLocal::TypedSlot<ThreadLocalPool>::makeUnique(tls)),
+        stats_{ALL_CONTEXT_POOL_STATS(POOL_COUNTER_PREFIX(scope, stats_prefix))},
+        max_idle_(max_idle) {
+    tls_slot_->set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalPool>(); });
+  }
+
+  /**
+   * Takes an idle context for key from the calling worker's pool, or creates one.
+   * @param key identifies contexts that are interchangeable.
+   * @param factory creates a context when none is idle.
+   * @return PooledContextPtr context that is handed back to the pool when destroyed. It must be
+   *         destroyed on the worker that acquired it.
+   */
+  PooledContextPtr acquire(const std::string& key, const ContextFactory& factory) {
+    IdleContextsSharedPtr& idle = (*tls_slot_)->idle_[key];
+    if (idle == nullptr) {
+      idle = std::make_shared<IdleContexts>();
+    }
+    ContextPtr context;
+    if (idle->empty()) {
+      stats_.miss_.inc();
+      context = factory();
+    } else {
+      stats_.hit_.inc();
+      context = std::move(idle->back());
+      idle->pop_back();
+    }
+    return PooledContextPtr(context.release(), Releaser(idle, max_idle_));
+  }
+
+private:
+  struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject {
+    absl::flat_hash_map<std::string, IdleContextsSharedPtr> idle_;
+  };
+
+  ThreadLocal::TypedSlotPtr<ThreadLocalPool> tls_slot_;
+  ContextPoolStats stats_;
+  const uint32_t max_idle_;
+};
+
+/**
+ * Compressor backed by a pooled context.
+ */
+template <class Context>
+class PooledCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  explicit PooledCompressor(typename ContextPool<Context>::PooledContextPtr context)
+      : context_(std::move(context)) {}
+
+  // Compression::Compressor::Compressor
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override {
+    context_->compress(buffer, state);
+  }
+
+private:
+  typename ContextPool<Context>::PooledContextPtr context_;
+};
+
+/**
+ * Decompressor backed by a pooled context.
+ */
+template <class Context>
+class PooledDecompressor : public Envoy::Compression::Decompressor::Decompressor {
+public:
+  explicit PooledDecompressor(typename ContextPool<Context>::PooledContextPtr context)
+      : context_(std::move(context)) {}
+
+  // Compression::Decompressor::Decompressor
+  void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override {
+    context_->decompress(input_buffer, output_buffer);
+  }
+
+private:
+  typename ContextPool<Context>::PooledContextPtr context_;
+};
+
+} // namespace Pool
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
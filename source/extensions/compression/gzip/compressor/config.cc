@@ -1,5 +1,7 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -7,13 +9,21 @@ namespace Gzip {
 namespace Compressor {
 
 GzipCompressorFactory::GzipCompressorFactory(
-    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip)
+    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+    ThreadLocal::SlotAllocator& tls, Stats::Scope& scope)
     : compression_level_(compressionLevelEnum(gzip.compression_level())),
       compression_strategy_(compressionStrategyEnum(gzip.compression_strategy())),
       memory_level_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, memory_level, DefaultMemoryLevel)),
       window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, window_bits, DefaultWindowBits) |
                    GzipHeaderValue),
-      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {}
+      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {
+  const uint32_t max_pooled_contexts =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_pooled_contexts, 0);
+  if (max_pooled_contexts > 0) {
+    pool_ = std::make_unique<Common::Pool::ContextPool<ZlibCompressorImpl>>(
+        tls, scope, absl::StrCat("compressor_pool.", gzipStatsPrefix()), max_pooled_contexts);
+  }
+}
 
 ZlibCompressorImpl::CompressionLevel GzipCompressorFactory::compressionLevelEnum(
     envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
@@ -60,16 +70,24 @@ ZlibCompressorImpl::CompressionStrategy GzipCompressorFactory::compressionStrate
 }
 
 Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
-  auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
-  compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
-  return compressor;
+  auto create = [this]() {
+    auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
+    compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
+    return compressor;
+  };
+  if (pool_ == nullptr) {
+    return create();
+  }
+  return std::make_unique<Common::Pool::PooledCompressor<ZlibCompressorImpl>>(
+      pool_->acquire(EMPTY_STRING, create));
 }
 
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
-    Server::Configuration::GenericFactoryContext&) {
-  return std::make_unique<GzipCompressorFactory>(proto_config);
+    Server::Configuration::GenericFactoryContext& context) {
+  return std::make_unique<GzipCompressorFactory>(
+      proto_config, context.serverFactoryContext().threadLocal(), context.scope());
 }
 
 /**
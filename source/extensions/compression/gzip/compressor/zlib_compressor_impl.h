@@ -82,6 +82,12 @@ public:
   void init(CompressionLevel level, CompressionStrategy strategy, int64_t window_bits,
             uint64_t memory_level);
 
+  /**
+   * Discards the state of the current stream so that the compressor can be reused for a new
+   * stream with the parameters given to init(), without reallocating its internal state.
+   */
+  void reset();
+
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
 
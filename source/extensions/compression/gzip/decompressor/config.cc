@@ -1,5 +1,7 @@
 #include "source/extensions/compression/gzip/decompressor/config.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -16,27 +18,45 @@ const uint64_t DefaultMaxInflateRatio = 100;
 } // namespace
 
 GzipDecompressorFactory::GzipDecompressorFactory(
-    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& gzip, Stats::Scope& scope)
+    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& gzip, Stats::Scope& scope,
+    ThreadLocal::SlotAllocator& tls)
     : scope_(scope),
       window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, window_bits, DefaultWindowBits) |
                    GzipHeaderValue),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)),
       max_inflate_ratio_(
-          PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_inflate_ratio, DefaultMaxInflateRatio)) {}
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_inflate_ratio, DefaultMaxInflateRatio)) {
+  const uint32_t max_pooled_contexts =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_pooled_contexts, 0);
+  if (max_pooled_contexts > 0) {
+    pool_ = std::make_unique<Common::Pool::ContextPool<ZlibDecompressorImpl>>(
+        tls, scope, absl::StrCat("decompressor_pool.", gzipStatsPrefix()), max_pooled_contexts);
+  }
+}
 
 Envoy::Compression::Decompressor::DecompressorPtr
 GzipDecompressorFactory::createDecompressor(const std::string& stats_prefix) {
-  auto decompressor =
-      std::make_unique<ZlibDecompressorImpl>(scope_, stats_prefix, chunk_size_, max_inflate_ratio_);
-  decompressor->init(window_bits_);
-  return decompressor;
+  auto create = [this, &stats_prefix]() {
+    auto decompressor = std::make_unique<ZlibDecompressorImpl>(scope_, stats_prefix, chunk_size_,
+                                                               max_inflate_ratio_);
+    decompressor->init(window_bits_);
+    return decompressor;
+  };
+  if (pool_ == nullptr) {
+    return create();
+  }
+  // Decompressors report errors under the caller's stats prefix, so only contexts created for the
+  // same prefix are interchangeable.
+  return std::make_unique<Common::Pool::PooledDecompressor<ZlibDecompressorImpl>>(
+      pool_->acquire(stats_prefix, create));
 }
 
 Envoy::Compression::Decompressor::DecompressorFactoryPtr
 GzipDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::decompressor::v3::Gzip& proto_config,
     Server::Configuration::FactoryContext& context) {
-  return std::make_unique<GzipDecompressorFactory>(proto_config, context.scope());
+  return std::make_unique<GzipDecompressorFactory>(proto_config, context.scope(),
+                                                   context.serverFactoryContext().threadLocal());
 }
 
 /**
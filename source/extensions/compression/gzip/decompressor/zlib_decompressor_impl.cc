@@ -44,6 +44,15 @@ void ZlibDecompressorImpl::init(int64_t window_bits) {
   initialized_ = true;
 }
 
+void ZlibDecompressorImpl::reset() {
+  ASSERT(initialized_);
+  const int result = inflateReset(zstream_ptr_.get());
+  RELEASE_ASSERT(result == Z_OK, "");
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+  decompression_error_ = 0;
+}
+
 void ZlibDecompressorImpl::decompress(const Buffer::Instance& input_buffer,
                                       Buffer::Instance& output_buffer) {
   uint64_t limit = max_inflate_ratio_ * input_buffer.length();
@@ -59,6 +59,12 @@ public:
    */
   void init(int64_t window_bits);
 
+  /**
+   * Discards the state of the current stream so that the decompressor can be reused for a new
+   * stream with the window size given to init(), without reallocating its internal state.
+   */
+  void reset();
+
   // Compression::Decompressor::Decompressor
   void decompress(const Buffer::Instance& input_buffer, Buffer::Instance& output_buffer) override;
 
@@ -42,8 +42,23 @@ void LuaLoggable::scriptLog(spdlog::level::level_enum level, absl::string_view m
   }
 }
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     std::vector<LuaRef<lua_State>>* pool)
+    : coroutine_state_(new_thread_state, false), pool_(pool) {}
+
+Coroutine::Coroutine(LuaRef<lua_State>&& thread_ref, std::vector<LuaRef<lua_State>>* pool)
+    : coroutine_state_(std::move(thread_ref)), pool_(pool) {}
+
+Coroutine::~Coroutine() {
+  // A thread that ran to completion has no frames left and can be started again with a new
+  // function. Threads that are still suspended or that failed are left for the GC.
+  if (pool_ == nullptr || state_ == State::Yielded || failed_ ||
+      pool_->size() >= MaxPooledCoroutines) {
+    return;
+  }
+  lua_settop(coroutine_state_.get(), 0);
+  pool_->push_back(std::move(coroutine_state_));
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -71,6 +86,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
     yield_callback();
   } else {
     state_ = State::Finished;
+    failed_ = true;
     const char* error = lua_tostring(coroutine_state_.get(), -1);
     if (!error) {
       error = "unspecified lua error";
@@ -79,20 +95,69 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
   }
 }
 
+namespace {
+
+int appendBytecode(lua_State*, const void* data, size_t size, void* bytecode) {
+  static_cast<std::string*>(bytecode)->append(static_cast<const char*>(data), size);
+  return 0;
+}
+
+} // namespace
+
 ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
-    : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)) {
+    : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)), bytecode_(compile(code)) {
+
+  // Now initialize on all threads. Workers load the precompiled bytecode rather than parsing the
+  // source again.
+  tls_slot_->set([code, bytecode = bytecode_](Event::Dispatcher&) {
+    return std::make_shared<LuaThreadLocal>(code, *bytecode);
+  });
+}
+
+std::shared_ptr<const std::string> ThreadLocalState::compile(const std::string& code) {
+  BytecodeCache& cache = bytecodeCache();
+  {
+    absl::MutexLock lock(cache.mutex_);
+    auto it = cache.map_.find(code);
+    if (it != cache.map_.end()) {
+      if (auto bytecode = it->second.lock(); bytecode != nullptr) {
+        return bytecode;
+      }
+    }
+  }
 
-  // First verify that the supplied code can be parsed.
+  // First verify that the supplied code can be parsed and run.
   CSmartPtr<lua_State, lua_close> state(luaL_newstate());
   RELEASE_ASSERT(state.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  // The source is used as the chunk name, as luaL_dostring() does, so that error messages are the
+  // same whether a worker runs the source or the bytecode.
+  if (0 != luaL_loadbuffer(state.get(), code.data(), code.size(), code.c_str())) {
+    throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
+  }
+  auto bytecode = std::make_shared<std::string>();
+  lua_pushvalue(state.get(), -1);
+  if (0 != lua_dump(state.get(), appendBytecode, bytecode.get())) {
+    // Workers fall back to loading the source.
+    bytecode->clear();
+  }
+  lua_pop(state.get(), 1);
+  if (0 != lua_pcall(state.get(), 0, LUA_MULTRET, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
-  // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(code); });
+  absl::MutexLock lock(cache.mutex_);
+  // Drop the entries of scripts that are no longer used while we hold the lock.
+  absl::erase_if(cache.map_, [](const auto& entry) { return entry.second.expired(); });
+  auto [it, inserted] = cache.map_.try_emplace(code, bytecode);
+  if (!inserted) {
+    if (auto existing = it->second.lock(); existing != nullptr) {
+      return existing;
+    }
+    it->second = bytecode;
+  }
+  return bytecode;
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -121,16 +186,30 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tlsState().get();
-  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
+  LuaThreadLocal& tls = **tls_slot_;
+  if (!tls.coroutine_pool_.empty()) {
+    auto coroutine =
+        std::make_unique<Coroutine>(std::move(tls.coroutine_pool_.back()), &tls.coroutine_pool_);
+    tls.coroutine_pool_.pop_back();
+    return coroutine;
+  }
+  lua_State* state = tls.state_.get();
+  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state),
+                                     &tls.coroutine_pool_);
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code,
+                                                 const std::string& bytecode)
     : state_(luaL_newstate()) {
 
   RELEASE_ASSERT(state_.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  int rc = bytecode.empty()
+               ? luaL_loadbuffer(state_.get(), code.data(), code.size(), code.c_str())
+               : luaL_loadbuffer(state_.get(), bytecode.data(), bytecode.size(), code.c_str());
+  if (rc == 0) {
+    rc = lua_pcall(state_.get(), 0, LUA_MULTRET, 0);
+  }
   ASSERT(rc == 0);
 }
 
@@ -10,7 +10,10 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/c_smart_ptr.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "lua.hpp"
 
 namespace Envoy {
@@ -423,6 +426,11 @@ public:
   }
 };
 
+/**
+ * Maximum number of idle coroutine threads kept by each worker per script.
+ */
+constexpr size_t MaxPooledCoroutines = 64;
+
 /**
  * This is a wrapper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -431,7 +439,16 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param new_thread_state supplies the coroutine thread and the state that owns it.
+   * @param pool optionally supplies the idle coroutine pool the thread is returned to when this
+   *        object is destroyed after running to completion.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            std::vector<LuaRef<lua_State>>* pool = nullptr);
+  Coroutine(LuaRef<lua_State>&& thread_ref, std::vector<LuaRef<lua_State>>* pool);
+  ~Coroutine();
+
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
@@ -456,6 +473,9 @@ public:
 private:
   LuaRef<lua_State> coroutine_state_;
   State state_{State::NotStarted};
+  // Set when the coroutine failed with an error, in which case its thread is not reused.
+  bool failed_{};
+  std::vector<LuaRef<lua_State>>* pool_;
 };
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
@@ -472,7 +492,8 @@ public:
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a new coroutine. Threads of coroutines that ran to completion are reused
+   *         from a bounded per-worker pool rather than allocated for every coroutine.
    */
   CoroutinePtr createCoroutine();
 
@@ -514,18 +535,46 @@ public:
    */
   void runtimeGC() { lua_gc(tlsState().get(), LUA_GCCOLLECT, 0); }
 
+  /**
+   * @return the compiled script, shared with every other ThreadLocalState running the same
+   *         source. Empty if the script could not be dumped, in which case workers load the source.
+   */
+  const std::string& bytecode() const { return *bytecode_; }
+
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& code, const std::string& bytecode);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Declared after state_ so that the pooled threads are unreferenced before the state closes.
+    std::vector<LuaRef<lua_State>> coroutine_pool_;
   };
 
+  /**
+   * Bytecode of scripts keyed by their source, shared by every ThreadLocalState running the same
+   * script so that it is only compiled once however many routes or listeners use it.
+   */
+  struct BytecodeCache {
+    absl::Mutex mutex_;
+    absl::flat_hash_map<std::string, std::weak_ptr<const std::string>>
+        map_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  static BytecodeCache& bytecodeCache() { MUTABLE_CONSTRUCT_ON_FIRST_USE(BytecodeCache); }
+
+  /**
+   * Compile the script, reusing the bytecode of another ThreadLocalState running the same source.
+   * Throws LuaException if the script fails to load.
+   */
+  static std::shared_ptr<const std::string> compile(const std::string& code);
+
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
 
   ThreadLocal::TypedSlotPtr<LuaThreadLocal> tls_slot_;
   uint64_t current_global_slot_{};
+  // Held for the lifetime of this object so that the cache entry outlives all the workers.
+  std::shared_ptr<const std::string> bytecode_;
 };
 
 using ThreadLocalStatePtr = std::unique_ptr<ThreadLocalState>;
@@ -11,6 +11,13 @@ namespace Filters {
 namespace Common {
 namespace RBAC {
 
+namespace {
+
+// Below this many policies evaluating each of them is cheap enough that the index does not pay off.
+constexpr size_t MinPoliciesToIndex = 16;
+
+} // namespace
+
 Envoy::Matcher::ActionConstSharedPtr
 ActionFactory::createAction(const Protobuf::Message& config, ActionContext& context,
                             ProtobufMessage::ValidationVisitor& validation_visitor) {
@@ -64,6 +71,21 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
                           policy.second, validation_visitor, context,
                           builder_with_arena_ ? builder_with_arena_->builder_instance_ : nullptr));
   }
+
+  if (policies_.size() >= MinPoliciesToIndex) {
+    std::vector<const envoy::config::rbac::v3::Policy*> ordered_configs;
+    ordered_configs.reserve(policies_.size());
+    ordered_policies_.reserve(policies_.size());
+    for (const auto& policy : policies_) {
+      ordered_configs.push_back(&rules.policies().at(policy.first));
+      ordered_policies_.push_back(&policy);
+    }
+    policy_index_ = std::make_unique<PolicyIndex>(ordered_configs);
+    if (policy_index_->indexedPolicies() == 0) {
+      policy_index_.reset();
+      ordered_policies_.clear();
+    }
+  }
 }
 
 bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& connection,
@@ -97,6 +119,21 @@ bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& c
 bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Network::Connection& connection, const StreamInfo::StreamInfo& info,
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
+  if (policy_index_ != nullptr) {
+    // Policies outside of the candidates can not match, so the first matching candidate is the
+    // first matching policy.
+    for (const uint32_t candidate : policy_index_->candidates(connection, headers, info)) {
+      const auto& policy = *ordered_policies_[candidate];
+      if (policy.second->matches(connection, headers, info)) {
+        if (effective_policy_id != nullptr) {
+          *effective_policy_id = policy.first;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
   bool matched = false;
 
   for (const auto& policy : policies_) {
@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -93,6 +94,11 @@ private:
   const EnforcementMode mode_;
 
   std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
+  // Set for large policy sets. Candidate indices refer to policies_ in iteration order, which
+  // ordered_policies_ stores.
+  PolicyIndexPtr policy_index_;
+  std::vector<const std::pair<const std::string, std::unique_ptr<PolicyMatcher>>*>
+      ordered_policies_;
   // Arena-based builder for when cel_config is not used.
   std::unique_ptr<ExprBuilderWithArena> builder_with_arena_;
 };
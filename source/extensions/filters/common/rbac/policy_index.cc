@@ -0,0 +1,336 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+
+#include "source/common/http/header_utility.h"
+#include "source/common/http/path_utility.h"
+#include "source/common/network/cidr_range.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+namespace {
+
+// Matches the limit the LC trie enforces with its default fill factor.
+constexpr size_t MaxIndexedCidrRanges = Network::LcTrie::MaxLcTrieNodes / 4;
+
+absl::optional<std::string> exactValue(const envoy::type::matcher::v3::StringMatcher& matcher) {
+  if (matcher.match_pattern_case() != envoy::type::matcher::v3::StringMatcher::kExact ||
+      matcher.ignore_case()) {
+    return absl::nullopt;
+  }
+  return matcher.exact();
+}
+
+void appendAll(std::vector<uint32_t>& to, const std::vector<uint32_t>& from) {
+  to.insert(to.end(), from.begin(), from.end());
+}
+
+} // namespace
+
+struct PolicyIndex::Keys {
+  void append(Keys&& other) {
+    for (auto& path : other.exact_paths) {
+      exact_paths.push_back(std::move(path));
+    }
+    for (auto& regex : other.path_regexes) {
+      path_regexes.push_back(std::move(regex));
+    }
+    ports.insert(ports.end(), other.ports.begin(), other.ports.end());
+    for (auto& header : other.headers) {
+      headers.push_back(std::move(header));
+    }
+    for (size_t i = 0; i < ip_ranges.size(); ++i) {
+      for (auto& range : other.ip_ranges[i]) {
+        ip_ranges[i].push_back(std::move(range));
+      }
+    }
+  }
+
+  bool addPath(const envoy::type::matcher::v3::PathMatcher& matcher) {
+    const auto& path = matcher.path();
+    if (const auto exact = exactValue(path); exact.has_value()) {
+      exact_paths.push_back(*exact);
+      return true;
+    }
+    if (path.match_pattern_case() == envoy::type::matcher::v3::StringMatcher::kSafeRegex) {
+      path_regexes.push_back(path.safe_regex().regex());
+      return true;
+    }
+    return false;
+  }
+
+  bool addHeader(const envoy::config::route::v3::HeaderMatcher& matcher) {
+    if (matcher.header_match_specifier_case() !=
+            envoy::config::route::v3::HeaderMatcher::kStringMatch ||
+        matcher.invert_match() || matcher.treat_missing_header_as_empty()) {
+      return false;
+    }
+    const auto exact = exactValue(matcher.string_match());
+    if (!exact.has_value()) {
+      return false;
+    }
+    headers.emplace_back(Http::LowerCaseString(matcher.name()).get(), *exact);
+    return true;
+  }
+
+  bool addIpRange(IpSource source, const envoy::config::core::v3::CidrRange& range) {
+    auto cidr = Network::Address::CidrRange::create(range);
+    if (!cidr.ok()) {
+      return false;
+    }
+    ip_ranges[source].push_back(std::move(cidr.value()));
+    return true;
+  }
+
+  std::vector<std::string> exact_paths;
+  std::vector<std::string> path_regexes;
+  std::vector<uint32_t> ports;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::array<std::vector<Network::Address::CidrRange>, IpSourceCount> ip_ranges;
+};
+
+PolicyIndex::PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies) {
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  path_regexes_ = std::make_unique<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+
+  std::array<std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>>,
+             IpSourceCount>
+      ip_ranges;
+  std::array<size_t, IpSourceCount> ip_range_count{};
+
+  for (uint32_t i = 0; i < policies.size(); ++i) {
+    const envoy::config::rbac::v3::Policy& policy = *policies[i];
+
+    // A policy matches only if one of its permissions and one of its principals match, so the keys
+    // of either list are a necessary condition for a match.
+    Keys keys;
+    bool indexed = policy.permissions_size() > 0;
+    for (const auto& permission : policy.permissions()) {
+      if (!collectPermission(permission, keys)) {
+        indexed = false;
+        break;
+      }
+    }
+    if (!indexed) {
+      keys = Keys();
+      indexed = policy.principals_size() > 0;
+      for (const auto& principal : policy.principals()) {
+        if (!collectPrincipal(principal, keys)) {
+          indexed = false;
+          break;
+        }
+      }
+    }
+    for (size_t source = 0; indexed && source < IpSourceCount; ++source) {
+      indexed = ip_range_count[source] + keys.ip_ranges[source].size() <= MaxIndexedCidrRanges;
+    }
+    if (!indexed) {
+      unindexed_.push_back(i);
+      continue;
+    }
+
+    for (size_t source = 0; source < IpSourceCount; ++source) {
+      if (!keys.ip_ranges[source].empty()) {
+        ip_range_count[source] += keys.ip_ranges[source].size();
+        ip_ranges[source].emplace_back(i, std::move(keys.ip_ranges[source]));
+      }
+    }
+    add(i, keys);
+  }
+
+  if (path_regex_policies_.empty() || !path_regexes_->Compile()) {
+    // Without a compiled set, the regex policies must always be evaluated.
+    for (const uint32_t policy : path_regex_policies_) {
+      unindexed_.push_back(policy);
+    }
+    path_regex_policies_.clear();
+    path_regexes_.reset();
+  }
+  for (size_t source = 0; source < IpSourceCount; ++source) {
+    if (!ip_ranges[source].empty()) {
+      ip_ranges_[source] = std::make_unique<Network::LcTrie::LcTrie<uint32_t>>(ip_ranges[source]);
+    }
+  }
+
+  std::sort(unindexed_.begin(), unindexed_.end());
+  unindexed_.erase(std::unique(unindexed_.begin(), unindexed_.end()), unindexed_.end());
+  indexed_policies_ = policies.size() - unindexed_.size();
+}
+
+bool PolicyIndex::collectPermission(const envoy::config::rbac::v3::Permission& permission,
+                                    Keys& keys) {
+  switch (permission.rule_case()) {
+  case envoy::config::rbac::v3::Permission::RuleCase::kAndRules:
+    // Any one of the rules is a necessary condition.
+    for (const auto& rule : permission.and_rules().rules()) {
+      Keys rule_keys;
+      if (collectPermission(rule, rule_keys)) {
+        keys.append(std::move(rule_keys));
+        return true;
+      }
+    }
+    return false;
+  case envoy::config::rbac::v3::Permission::RuleCase::kOrRules:
+    for (const auto& rule : permission.or_rules().rules()) {
+      if (!collectPermission(rule, keys)) {
+        return false;
+      }
+    }
+    return true;
+  case envoy::config::rbac::v3::Permission::RuleCase::kHeader:
+    return keys.addHeader(permission.header());
+  case envoy::config::rbac::v3::Permission::RuleCase::kUrlPath:
+    return keys.addPath(permission.url_path());
+  case envoy::config::rbac::v3::Permission::RuleCase::kDestinationPort:
+    keys.ports.push_back(permission.destination_port());
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool PolicyIndex::collectPrincipal(const envoy::config::rbac::v3::Principal& principal,
+                                   Keys& keys) {
+  switch (principal.identifier_case()) {
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kAndIds:
+    for (const auto& id : principal.and_ids().ids()) {
+      Keys id_keys;
+      if (collectPrincipal(id, id_keys)) {
+        keys.append(std::move(id_keys));
+        return true;
+      }
+    }
+    return false;
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kOrIds:
+    for (const auto& id : principal.or_ids().ids()) {
+      if (!collectPrincipal(id, keys)) {
+        return false;
+      }
+    }
+    return true;
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kHeader:
+    return keys.addHeader(principal.header());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kUrlPath:
+    return keys.addPath(principal.url_path());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+    return keys.addIpRange(ConnectionRemote, principal.source_ip());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+    return keys.addIpRange(DownstreamDirectRemote, principal.direct_remote_ip());
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+    return keys.addIpRange(DownstreamRemote, principal.remote_ip());
+  default:
+    return false;
+  }
+}
+
+void PolicyIndex::add(uint32_t policy, const Keys& keys) {
+  for (const std::string& path : keys.exact_paths) {
+    exact_paths_[path].push_back(policy);
+  }
+  for (const std::string& regex : keys.path_regexes) {
+    if (path_regexes_->Add(regex, nullptr) < 0) {
+      // Patterns added before the failure still select the policy, which is harmless.
+      unindexed_.push_back(policy);
+      return;
+    }
+    path_regex_policies_.push_back(policy);
+  }
+  for (const uint32_t port : keys.ports) {
+    destination_ports_[port].push_back(policy);
+  }
+  for (const auto& [name, value] : keys.headers) {
+    auto [it, inserted] = exact_headers_.try_emplace(name);
+    if (inserted) {
+      header_names_.emplace_back(name);
+    }
+    it->second[value].push_back(policy);
+  }
+}
+
+std::vector<uint32_t> PolicyIndex::candidates(const Network::Connection& connection,
+                                              const Http::RequestHeaderMap& headers,
+                                              const StreamInfo::StreamInfo& info) const {
+  std::vector<uint32_t> result = unindexed_;
+
+  // Paths are matched as PathMatcher does, without the query and fragment.
+  if (headers.Path() != nullptr && (!exact_paths_.empty() || path_regexes_ != nullptr)) {
+    const absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+    if (auto it = exact_paths_.find(path); it != exact_paths_.end()) {
+      appendAll(result, it->second);
+    }
+    if (path_regexes_ != nullptr) {
+      std::vector<int> matches;
+      re2::RE2::Set::ErrorInfo error;
+      if (path_regexes_->Match(path, &matches, &error)) {
+        for (const int match : matches) {
+          result.push_back(path_regex_policies_[match]);
+        }
+      } else if (error.kind != re2::RE2::Set::kNoError) {
+        // The set couldn't tell which patterns match, e.g. because the DFA ran out of memory, so
+        // all the regex policies must be evaluated to decide as the policies themselves would.
+        appendAll(result, path_regex_policies_);
+      }
+    }
+  }
+
+  if (!destination_ports_.empty()) {
+    const auto& local_address = info.downstreamAddressProvider().localAddress();
+    if (local_address != nullptr && local_address->ip() != nullptr) {
+      if (auto it = destination_ports_.find(local_address->ip()->port());
+          it != destination_ports_.end()) {
+        appendAll(result, it->second);
+      }
+    }
+  }
+
+  // Header matchers may compare either the comma joined value or each value individually, so both
+  // are looked up.
+  for (const Http::LowerCaseString& name : header_names_) {
+    const auto values = headers.get(name);
+    if (values.empty()) {
+      continue;
+    }
+    const auto& by_value = exact_headers_.find(name.get())->second;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (auto it = by_value.find(values[i]->value().getStringView()); it != by_value.end()) {
+        appendAll(result, it->second);
+      }
+    }
+    if (values.size() > 1) {
+      const auto joined = Http::HeaderUtility::getAllOfHeaderAsString(values, ",");
+      if (joined.result().has_value()) {
+        if (auto it = by_value.find(joined.result().value()); it != by_value.end()) {
+          appendAll(result, it->second);
+        }
+      }
+    }
+  }
+
+  for (size_t source = 0; source < IpSourceCount; ++source) {
+    if (ip_ranges_[source] == nullptr) {
+      continue;
+    }
+    const Network::Address::InstanceConstSharedPtr& address =
+        source == ConnectionRemote ? connection.connectionInfoProvider().remoteAddress()
+        : source == DownstreamDirectRemote ? info.downstreamAddressProvider().directRemoteAddress()
+                                           : info.downstreamAddressProvider().remoteAddress();
+    if (address != nullptr && address->ip() != nullptr) {
+      appendAll(result, ip_ranges_[source]->getData(address));
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/network/lc_trie.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * Index over a set of RBAC policies that narrows down the policies a request may match, so that
+ * only those need to be evaluated. A policy is indexed when all of the alternatives of its
+ * permissions (or, failing that, of its principals) require one of:
+ *
+ * - an exact, case sensitive URL path or a URL path regex,
+ * - an exact, case sensitive header value,
+ * - a destination port,
+ * - a source, remote or direct remote IP in a CIDR range.
+ *
+ * Lookups only ever return a superset of the policies that match, so evaluating the candidates in
+ * policy order yields the same decision and effective policy as evaluating every policy.
+ */
+class PolicyIndex {
+public:
+  /**
+   * @param policies supplies the policies in evaluation order. Candidate indices refer to
+   *                 positions in this vector.
+   */
+  explicit PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies);
+
+  /**
+   * @return the indices of the policies that may match the request, in ascending order.
+   */
+  std::vector<uint32_t> candidates(const Network::Connection& connection,
+                                   const Http::RequestHeaderMap& headers,
+                                   const StreamInfo::StreamInfo& info) const;
+
+  /**
+   * @return the number of policies that are only evaluated when selected by the index.
+   */
+  uint32_t indexedPolicies() const { return indexed_policies_; }
+
+private:
+  // The address a CIDR range is matched against, mirroring IPMatcher::Type.
+  enum IpSource { ConnectionRemote = 0, DownstreamDirectRemote, DownstreamRemote, IpSourceCount };
+
+  struct Keys;
+
+  static bool collectPermission(const envoy::config::rbac::v3::Permission& permission,
+                                Keys& keys);
+  static bool collectPrincipal(const envoy::config::rbac::v3::Principal& principal, Keys& keys);
+
+  void add(uint32_t policy, const Keys& keys);
+
+  std::vector<uint32_t> unindexed_;
+  uint32_t indexed_policies_{};
+
+  absl::flat_hash_map<std::string, std::vector<uint32_t>> exact_paths_;
+  std::unique_ptr<re2::RE2::Set> path_regexes_;
+  // The policy of each regex in path_regexes_.
+  std::vector<uint32_t> path_regex_policies_;
+  absl::flat_hash_map<uint32_t, std::vector<uint32_t>> destination_ports_;
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<uint32_t>>>
+      exact_headers_;
+  std::vector<Http::LowerCaseString> header_names_;
+  std::array<std::unique_ptr<Network::LcTrie::LcTrie<uint32_t>>, IpSourceCount> ip_ranges_;
+};
+
+using PolicyIndexPtr = std::unique_ptr<PolicyIndex>;
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -44,6 +44,7 @@ bool isWeakEtag(absl::string_view value) {
 
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
+const uint64_t DefaultMaxFlushLatencyMs = 10;
 
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
@@ -94,6 +95,9 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime)
     : compression_enabled_(proto_config.enabled(), runtime),
       min_content_length_{contentLengthUint(proto_config.min_content_length().value())},
+      min_flush_bytes_{proto_config.flush_policy().min_flush_bytes()},
+      max_flush_latency_{PROTOBUF_GET_MS_OR_DEFAULT(proto_config.flush_policy(), max_flush_latency,
+                                                    DefaultMaxFlushLatencyMs)},
       content_type_values_(contentTypeSet(proto_config.content_type())),
       stats_{generateStats(stats_prefix, scope)} {}
 
@@ -281,8 +285,11 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
 
 Http::FilterDataStatus CompressorFilter::decodeData(Buffer::Instance& data, bool end_stream) {
   if (request_compressor_ != nullptr) {
-    compressAndUpdateStats(request_compressor_, config_->requestDirectionConfig().stats(), data,
-                           end_stream);
+    return compressWithFlushPolicy(
+        request_compressor_, config_->requestDirectionConfig(), request_pending_, data, end_stream,
+        decoder_callbacks_->dispatcher(), [this](Buffer::Instance& compressed) {
+          decoder_callbacks_->injectDecodedDataToFilterChain(compressed, false);
+        });
   }
   return Http::FilterDataStatus::Continue;
 }
@@ -293,8 +300,8 @@ Http::FilterTrailersStatus CompressorFilter::decodeTrailers(Http::RequestTrailer
     // The presence of trailers means the stream is ended, but decodeData()
     // is never called with end_stream=true, thus let the compression library know
     // that the stream is ended.
-    compressAndUpdateStats(request_compressor_, config_->requestDirectionConfig().stats(),
-                           empty_buffer, true);
+    finishWithPendingChunks(request_compressor_, config_->requestDirectionConfig(),
+                            request_pending_, empty_buffer);
     decoder_callbacks_->addDecodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
@@ -467,8 +474,11 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeadersWithStatusHeader(
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
   if (response_compressor_ != nullptr) {
-    compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
-                           end_stream);
+    return compressWithFlushPolicy(
+        response_compressor_, config_->responseDirectionConfig(), response_pending_, data,
+        end_stream, encoder_callbacks_->dispatcher(), [this](Buffer::Instance& compressed) {
+          encoder_callbacks_->injectEncodedDataToFilterChain(compressed, false);
+        });
   }
   return Http::FilterDataStatus::Continue;
 }
@@ -479,13 +489,70 @@ Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTraile
     // The presence of trailers means the stream is ended, but encodeData()
     // is never called with end_stream=true, thus let the compression library know
     // that the stream is ended.
-    compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(),
-                           empty_buffer, true);
+    finishWithPendingChunks(response_compressor_, config_->responseDirectionConfig(),
+                            response_pending_, empty_buffer);
     encoder_callbacks_->addEncodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::onDestroy() {
+  request_pending_.flush_timer_.reset();
+  response_pending_.flush_timer_.reset();
+}
+
+Http::FilterDataStatus CompressorFilter::compressWithFlushPolicy(
+    const Envoy::Compression::Compressor::CompressorPtr& compressor,
+    const CompressorFilterConfig::DirectionConfig& config, PendingChunks& pending,
+    Buffer::Instance& data, bool end_stream, Event::Dispatcher& dispatcher,
+    std::function<void(Buffer::Instance&)> inject) {
+  if (config.minFlushBytes() == 0) {
+    compressAndUpdateStats(compressor, config.stats(), data, end_stream);
+    return Http::FilterDataStatus::Continue;
+  }
+
+  if (pending.data_.length() > 0) {
+    pending.data_.move(data);
+    data.move(pending.data_);
+  }
+  if (!end_stream && data.length() < config.minFlushBytes()) {
+    // Hold the chunk back: compressing and flushing a small chunk on its own costs a sync flush
+    // marker and a tiny frame downstream. The timer bounds the latency added for slow producers.
+    pending.data_.move(data);
+    config.stats().coalesced_chunks_.inc();
+    if (pending.flush_timer_ == nullptr) {
+      pending.flush_timer_ =
+          dispatcher.createTimer([&compressor, &config, &pending, inject = std::move(inject)]() {
+            Buffer::OwnedImpl compressed;
+            compressed.move(pending.data_);
+            compressAndUpdateStats(compressor, config.stats(), compressed, false);
+            inject(compressed);
+          });
+    }
+    if (!pending.flush_timer_->enabled()) {
+      pending.flush_timer_->enableTimer(config.maxFlushLatency());
+    }
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
+  if (pending.flush_timer_ != nullptr) {
+    pending.flush_timer_->disableTimer();
+  }
+  compressAndUpdateStats(compressor, config.stats(), data, end_stream);
+  return Http::FilterDataStatus::Continue;
+}
+
+void CompressorFilter::finishWithPendingChunks(
+    const Envoy::Compression::Compressor::CompressorPtr& compressor,
+    const CompressorFilterConfig::DirectionConfig& config, PendingChunks& pending,
+    Buffer::Instance& data) {
+  if (pending.flush_timer_ != nullptr) {
+    pending.flush_timer_->disableTimer();
+  }
+  data.move(pending.data_);
+  compressAndUpdateStats(compressor, config.stats(), data, true);
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "envoy/compression/compressor/factory.h"
+#include "envoy/event/timer.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
 #include "envoy/server/factory_context.h"
 #include "envoy/stats/stats_macros.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
@@ -29,7 +31,8 @@ namespace Compressor {
   COUNTER(not_compressed)                                                                          \
   COUNTER(total_uncompressed_bytes)                                                                \
   COUNTER(total_compressed_bytes)                                                                  \
-  COUNTER(content_length_too_small)
+  COUNTER(content_length_too_small)                                                                \
+  COUNTER(coalesced_chunks)
 
 /**
  * Compressor filter stats specific to responses only. @see stats_macros.h
@@ -77,6 +80,10 @@ public:
     const CompressorStats& stats() const { return stats_; }
     const StringUtil::CaseUnorderedSet& contentTypeValues() const { return content_type_values_; }
     uint32_t minimumLength() const { return min_content_length_; }
+    // Body chunks are held back until at least this many bytes are pending. Zero disables
+    // coalescing, so that every chunk is compressed and flushed on its own.
+    uint32_t minFlushBytes() const { return min_flush_bytes_; }
+    std::chrono::milliseconds maxFlushLatency() const { return max_flush_latency_; }
     bool isMinimumContentLength(const Http::RequestOrResponseHeaderMap& headers) const;
     bool isContentTypeAllowed(const Http::RequestOrResponseHeaderMap& headers) const;
 
@@ -94,6 +101,8 @@ public:
     contentTypeSet(const Protobuf::RepeatedPtrField<std::string>& types);
 
     const uint32_t min_content_length_;
+    const uint32_t min_flush_bytes_;
+    const std::chrono::milliseconds max_flush_latency_;
     const StringUtil::CaseUnorderedSet content_type_values_;
     const CompressorStats stats_;
   };
@@ -221,10 +230,34 @@ public:
   Http::FilterDataStatus encodeData(Buffer::Instance& buffer, bool end_stream) override;
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap&) override;
 
+  // Http::StreamFilterBase
+  void onDestroy() override;
+
   // Grant testing peer access.
   friend class CompressorFilterTestingPeer;
 
 private:
+  // Body data of one direction held back from the compressor until the direction's flush policy
+  // is satisfied.
+  struct PendingChunks {
+    Buffer::OwnedImpl data_;
+    Event::TimerPtr flush_timer_;
+  };
+
+  // Compresses data according to the flush policy of config. Returns StopIterationNoBuffer when
+  // the data has been held back in pending; it is then compressed along with later chunks, or
+  // handed to inject once the maximum flush latency has elapsed.
+  Http::FilterDataStatus
+  compressWithFlushPolicy(const Envoy::Compression::Compressor::CompressorPtr& compressor,
+                          const CompressorFilterConfig::DirectionConfig& config,
+                          PendingChunks& pending, Buffer::Instance& data, bool end_stream,
+                          Event::Dispatcher& dispatcher,
+                          std::function<void(Buffer::Instance&)> inject);
+  // Compresses any held back data followed by the end of the compressed stream.
+  void finishWithPendingChunks(const Envoy::Compression::Compressor::CompressorPtr& compressor,
+                               const CompressorFilterConfig::DirectionConfig& config,
+                               PendingChunks& pending, Buffer::Instance& data);
+
   // Initialize and cache the most specific per-route config only once for this stream.
   // Subsequent accesses should use the cached pointer to avoid any inconsistencies if
   // the route is refreshed mid-stream.
@@ -286,6 +319,8 @@ private:
 
   Envoy::Compression::Compressor::CompressorPtr response_compressor_;
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
+  PendingChunks response_pending_;
+  PendingChunks request_pending_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
   // Cached per-route configuration pointer, initialized once per stream.
@@ -0,0 +1,119 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 1024;
+
+// Dynamic metadata field the authorization service can use to shorten the TTL of a decision.
+constexpr absl::string_view TtlMetadataField = "cache_ttl_seconds";
+
+std::vector<Http::LowerCaseString>
+keyHeaders(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config) {
+  std::vector<Http::LowerCaseString> headers;
+  headers.reserve(config.key_headers_size());
+  for (const std::string& header : config.key_headers()) {
+    headers.emplace_back(header);
+  }
+  return headers;
+}
+
+} // namespace
+
+DecisionCache::DecisionCache(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source)
+    : key_headers_(keyHeaders(config)),
+      ttl_(DurationUtil::durationToMilliseconds(config.ttl())),
+      negative_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, negative_ttl, 0)),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      time_source_(time_source),
+      tls_slot_(ThreadLocal::TypedSlot<ThreadLocalCache>::makeUnique(tls)) {
+  tls_slot_->set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCache>(); });
+}
+
+std::string DecisionCache::key(const Http::RequestHeaderMap& headers) const {
+  std::string key;
+  for (const Http::LowerCaseString& name : key_headers_) {
+    const auto values = headers.get(name);
+    // Distinguish an absent header from one with an empty value.
+    key.push_back(values.empty() ? '0' : '1');
+    for (size_t i = 0; i < values.size(); ++i) {
+      absl::StrAppend(&key, i == 0 ? "" : ",", values[i]->value().getStringView());
+    }
+    key.push_back('\0');
+  }
+  return key;
+}
+
+Filters::Common::ExtAuthz::ResponsePtr DecisionCache::lookup(const std::string& key) {
+  ThreadLocalCache& cache = **tls_slot_;
+  auto it = cache.index_.find(key);
+  if (it == cache.index_.end()) {
+    return nullptr;
+  }
+  if (it->second->expiry_ <= time_source_.monotonicTime()) {
+    cache.entries_.erase(it->second);
+    cache.index_.erase(it);
+    return nullptr;
+  }
+  cache.entries_.splice(cache.entries_.begin(), cache.entries_, it->second);
+  return std::make_unique<Filters::Common::ExtAuthz::Response>(it->second->response_);
+}
+
+void DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response) {
+  const std::chrono::milliseconds decision_ttl = ttl(response);
+  if (decision_ttl.count() <= 0) {
+    return;
+  }
+
+  ThreadLocalCache& cache = **tls_slot_;
+  auto it = cache.index_.find(key);
+  if (it != cache.index_.end()) {
+    cache.entries_.erase(it->second);
+    cache.index_.erase(it);
+  } else if (cache.entries_.size() >= max_entries_) {
+    cache.index_.erase(cache.entries_.back().key_);
+    cache.entries_.pop_back();
+  }
+  cache.entries_.push_front({key, response, time_source_.monotonicTime() + decision_ttl});
+  cache.index_.emplace(key, cache.entries_.begin());
+}
+
+std::chrono::milliseconds
+DecisionCache::ttl(const Filters::Common::ExtAuthz::Response& response) const {
+  std::chrono::milliseconds ttl;
+  switch (response.status) {
+  case Filters::Common::ExtAuthz::CheckStatus::OK:
+    ttl = ttl_;
+    break;
+  case Filters::Common::ExtAuthz::CheckStatus::Denied:
+    ttl = negative_ttl_;
+    break;
+  case Filters::Common::ExtAuthz::CheckStatus::Error:
+    return std::chrono::milliseconds::zero();
+  }
+
+  const auto& fields = response.dynamic_metadata.fields();
+  const auto field = fields.find(std::string(TtlMetadataField));
+  if (field != fields.end() && field->second.has_number_value()) {
+    const auto server_ttl = std::chrono::milliseconds(
+        static_cast<int64_t>(std::max(0.0, field->second.number_value()) * 1000));
+    ttl = std::min(ttl, server_ttl);
+  }
+  return ttl;
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
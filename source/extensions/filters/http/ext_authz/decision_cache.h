@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * Per worker cache of authorization decisions. Decisions are keyed on the values of a configured
+ * set of request headers, expire after a TTL, and the least recently used decision is evicted once
+ * a worker's cache is full. Only OK and (optionally) denied decisions are cached.
+ */
+class DecisionCache {
+public:
+  DecisionCache(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                ThreadLocal::SlotAllocator& tls, TimeSource& time_source);
+
+  /**
+   * @return the cache key of a request.
+   */
+  std::string key(const Http::RequestHeaderMap& headers) const;
+
+  /**
+   * @return a copy of the unexpired decision cached on the calling worker for key, or nullptr.
+   */
+  Filters::Common::ExtAuthz::ResponsePtr lookup(const std::string& key);
+
+  /**
+   * Caches a decision on the calling worker, unless its status or TTL excludes it from caching.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response);
+
+private:
+  struct Entry {
+    std::string key_;
+    Filters::Common::ExtAuthz::Response response_;
+    MonotonicTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
+    // Most recently used entries are at the front.
+    EntryList entries_;
+    absl::flat_hash_map<std::string, EntryList::iterator> index_;
+  };
+
+  std::chrono::milliseconds ttl(const Filters::Common::ExtAuthz::Response& response) const;
+
+  const std::vector<Http::LowerCaseString> key_headers_;
+  const std::chrono::milliseconds ttl_;
+  const std::chrono::milliseconds negative_ttl_;
+  const uint32_t max_entries_;
+  TimeSource& time_source_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalCache> tls_slot_;
+};
+
+using DecisionCachePtr = std::unique_ptr<DecisionCache>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
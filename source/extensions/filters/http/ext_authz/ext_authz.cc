@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/ext_authz/ext_authz.h"
 
+#include <algorithm>
 #include <chrono>
 #include <optional>
 #include <string>
@@ -80,6 +81,27 @@ Http::Code zeroHttpCode() {
   return static_cast<Http::Code>(0);
 }
 
+// Returns the part of the decision cache key that identifies the route and the per-route settings
+// merged for it, which are sent to or select the authorization service.
+std::string decisionCacheRouteKey(const Router::Route& route,
+                                  const Protobuf::Map<std::string, std::string>& context_extensions,
+                                  const absl::optional<FilterConfigPerRoute>& per_route_config) {
+  std::string key = absl::StrCat(route.routeName(), absl::string_view("\0", 1));
+  std::vector<std::pair<absl::string_view, absl::string_view>> extensions(
+      context_extensions.begin(), context_extensions.end());
+  std::sort(extensions.begin(), extensions.end());
+  for (const auto& [name, value] : extensions) {
+    absl::StrAppend(&key, name.size(), ":", name, value.size(), ":", value);
+  }
+  if (per_route_config.has_value() && per_route_config->grpcService().has_value()) {
+    absl::StrAppend(&key, "grpc:", MessageUtil::hash(per_route_config->grpcService().value()));
+  } else if (per_route_config.has_value() && per_route_config->httpService().has_value()) {
+    absl::StrAppend(&key, "http:", MessageUtil::hash(per_route_config->httpService().value()));
+  }
+  key.push_back('\0');
+  return key;
+}
+
 } // namespace
 
 FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3::ExtAuthz& config,
@@ -183,6 +205,11 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3
     disallowed_headers_matcher_ = Filters::Common::ExtAuthz::CheckRequestUtils::toRequestMatchers(
         config.disallowed_headers(), false, factory_context);
   }
+
+  if (config.has_decision_cache()) {
+    decision_cache_ = std::make_unique<DecisionCache>(
+        config.decision_cache(), factory_context.threadLocal(), factory_context.timeSource());
+  }
 }
 
 void FilterConfigPerRoute::merge(const FilterConfigPerRoute& other) {
@@ -324,6 +351,31 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     context_extensions = maybe_merged_per_route_config.value().takeContextExtensions();
   }
 
+  // Requests whose body is sent to the authorization service are never cached, as the body may
+  // affect the decision. Nor are requests on unnamed routes, which can't be told apart even though
+  // their route metadata may differ.
+  const auto route = decoder_callbacks_->route();
+  if (config_->decisionCache() != nullptr && !buffer_data_ && route != nullptr &&
+      !route->routeName().empty()) {
+    decision_cache_key_ = absl::StrCat(
+        decisionCacheRouteKey(*route, context_extensions, maybe_merged_per_route_config),
+        config_->decisionCache()->key(headers));
+    Filters::Common::ExtAuthz::ResponsePtr cached =
+        config_->decisionCache()->lookup(*decision_cache_key_);
+    if (cached != nullptr) {
+      ENVOY_STREAM_LOG(trace, "ext_authz filter using cached decision.", *decoder_callbacks_);
+      stats_.decision_cache_hit_.inc();
+      served_from_decision_cache_ = true;
+      state_ = State::Calling;
+      filter_return_ = FilterReturn::StopDecoding;
+      initiating_call_ = true;
+      onComplete(std::move(cached));
+      initiating_call_ = false;
+      return;
+    }
+    stats_.decision_cache_miss_.inc();
+  }
+
   // Check if we need to use a per-route service override (gRPC or HTTP).
   if (maybe_merged_per_route_config) {
     if (maybe_merged_per_route_config->grpcService().has_value()) {
@@ -375,7 +427,7 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
 
   // Fill route_metadata_context from the selected route's metadata.
   envoy::config::core::v3::Metadata route_metadata_context;
-  if (const auto route = decoder_callbacks_->route(); route) {
+  if (route != nullptr) {
     fillMetadataContext({&route->metadata()}, config_->routeMetadataContextNamespaces(),
                         config_->routeTypedMetadataContextNamespaces(), route_metadata_context);
   }
@@ -658,6 +710,10 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
+  if (decision_cache_key_.has_value() && !served_from_decision_cache_) {
+    config_->decisionCache()->insert(*decision_cache_key_, *response);
+  }
+
   updateLoggingInfo(response->grpc_status);
 
   if (response->saw_invalid_append_actions) {
@@ -29,6 +29,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
 #include "source/extensions/filters/common/mutation_rules/mutation_rules.h"
 #include "source/extensions/filters/common/processing_effect/processing_effect.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -52,7 +53,9 @@ namespace ExtAuthz {
   COUNTER(request_header_limits_reached)                                                           \
   COUNTER(response_header_limits_reached)                                                          \
   COUNTER(shadow_denied)                                                                           \
-  COUNTER(shadow_error)
+  COUNTER(shadow_error)                                                                            \
+  COUNTER(decision_cache_hit)                                                                      \
+  COUNTER(decision_cache_miss)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -287,6 +290,9 @@ public:
     return disallowed_headers_matcher_;
   }
 
+  // Returns nullptr if decision caching is disabled.
+  DecisionCache* decisionCache() const { return decision_cache_.get(); }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -355,6 +361,8 @@ private:
   Filters::Common::ExtAuthz::MatcherSharedPtr allowed_headers_matcher_;
   Filters::Common::ExtAuthz::MatcherSharedPtr disallowed_headers_matcher_;
 
+  DecisionCachePtr decision_cache_;
+
 public:
   // TODO(nezdolik): deprecate cluster scope stats counters in favor of filter scope stats
   // (ExtAuthzFilterStats stats_).
@@ -580,6 +588,9 @@ private:
   bool initiating_call_{};
   bool buffer_data_{};
   bool skip_check_{false};
+  // Key of this request in the decision cache, set when the decision may be cached.
+  absl::optional<std::string> decision_cache_key_;
+  bool served_from_decision_cache_{false};
   envoy::service::auth::v3::CheckRequest check_request_;
 };
 
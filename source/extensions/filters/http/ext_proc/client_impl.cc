@@ -1,5 +1,7 @@
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 
+#include <algorithm>
+
 #include "source/extensions/filters/common/ext_proc/grpc_client_impl.h"
 
 namespace Envoy {
@@ -7,15 +9,185 @@ namespace Extensions {
 namespace HttpFilters {
 namespace ExternalProcessing {
 
+namespace {
+
+constexpr absl::string_view kExternalMethod = "envoy.service.ext_proc.v3.ExternalProcessor.Process";
+
+/**
+ * The view of a shared stream handed to a single HTTP stream.
+ */
+class MultiplexedProcessorStream : public ExternalProcessorStream {
+public:
+  MultiplexedProcessorStream(SharedProcessorStreamSharedPtr shared, uint64_t id,
+                             ExternalProcessorCallbacks& callbacks)
+      : shared_(std::move(shared)), id_(id) {
+    shared_->subscribe(id_, callbacks);
+  }
+  ~MultiplexedProcessorStream() override { close(); }
+
+  void send(ProcessingRequest&& request, bool) override {
+    // The end of a single HTTP stream's messages is signalled on close(), as the shared stream
+    // itself must stay open.
+    if (!closed_) {
+      request.set_multiplexed_stream_id(id_);
+      shared_->send(std::move(request));
+    }
+  }
+
+  bool close() override {
+    if (closed_) {
+      return false;
+    }
+    closed_ = true;
+    shared_->unsubscribe(id_);
+    if (!shared_->closed()) {
+      // A message with an ID but no request tells the server it may release the ID's state.
+      ProcessingRequest end_of_stream;
+      end_of_stream.set_multiplexed_stream_id(id_);
+      shared_->send(std::move(end_of_stream));
+    }
+    return true;
+  }
+
+  // There is no per HTTP stream half close on a shared stream, so this closes immediately.
+  bool halfCloseAndDeleteOnRemoteClose() override { return close(); }
+
+  const StreamInfo::StreamInfo& streamInfo() const override { return shared_->streamInfo(); }
+  StreamInfo::StreamInfo& streamInfo() override { return shared_->streamInfo(); }
+
+  void notifyFilterDestroy() override { shared_->unsubscribe(id_); }
+
+private:
+  const SharedProcessorStreamSharedPtr shared_;
+  const uint64_t id_;
+  bool closed_{false};
+};
+
+} // namespace
+
 ExternalProcessorClientPtr createExternalProcessorClient(Grpc::AsyncClientManager& client_manager,
                                                          Stats::Scope& scope) {
-  static constexpr absl::string_view kExternalMethod =
-      "envoy.service.ext_proc.v3.ExternalProcessor.Process";
   return std::make_unique<
       CommonExtProc::ProcessorClientImpl<ProcessingRequest, ProcessingResponse>>(
       client_manager, scope, kExternalMethod);
 }
 
+SharedProcessorStreamSharedPtr
+SharedProcessorStream::create(Grpc::RawAsyncClientSharedPtr client) {
+  auto stream = SharedProcessorStreamSharedPtr(new SharedProcessorStream(std::move(client)));
+  const auto* descriptor =
+      Protobuf::DescriptorPool::generated_pool()->FindMethodByName(std::string(kExternalMethod));
+  // The stream is not tied to any HTTP stream, so none of the per-request stream options apply.
+  stream->stream_ = stream->client_.start(*descriptor, *stream, Http::AsyncClient::StreamOptions());
+  if (stream->stream_ == nullptr) {
+    return nullptr;
+  }
+  return stream;
+}
+
+SharedProcessorStream::~SharedProcessorStream() {
+  if (!closed_ && stream_ != nullptr) {
+    stream_.resetStream();
+  }
+}
+
+void SharedProcessorStream::subscribe(uint64_t id, ExternalProcessorCallbacks& callbacks) {
+  subscribers_[id] = &callbacks;
+}
+
+void SharedProcessorStream::unsubscribe(uint64_t id) { subscribers_.erase(id); }
+
+void SharedProcessorStream::send(ProcessingRequest&& request) {
+  if (!closed_) {
+    stream_.sendMessage(std::move(request), false);
+  }
+}
+
+void SharedProcessorStream::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) {
+  auto it = subscribers_.find(response->multiplexed_stream_id());
+  if (it == subscribers_.end()) {
+    ENVOY_LOG(debug, "Discarding response for unknown multiplexed stream {}",
+              response->multiplexed_stream_id());
+    return;
+  }
+  it->second->onReceiveMessage(std::move(response));
+}
+
+void SharedProcessorStream::onRemoteClose(Grpc::Status::GrpcStatus status,
+                                          const std::string& message) {
+  ENVOY_LOG(debug, "Shared gRPC stream closed remotely with status {}: {}", status, message);
+  closed_ = true;
+
+  // Subscribers may close their streams, and so unsubscribe, while being notified.
+  const SharedProcessorStreamSharedPtr self = shared_from_this();
+  std::vector<uint64_t> ids;
+  ids.reserve(subscribers_.size());
+  for (const auto& subscriber : subscribers_) {
+    ids.push_back(subscriber.first);
+  }
+  for (const uint64_t id : ids) {
+    auto it = subscribers_.find(id);
+    if (it == subscribers_.end()) {
+      continue;
+    }
+    ExternalProcessorCallbacks& callbacks = *it->second;
+    subscribers_.erase(it);
+    callbacks.logStreamInfo();
+    if (status == Grpc::Status::Ok) {
+      callbacks.onGrpcClose();
+    } else {
+      callbacks.onGrpcError(status, message);
+    }
+  }
+}
+
+ExternalProcessorStreamPtr
+MultiplexedStreamPool::start(ExternalProcessorCallbacks& callbacks,
+                             const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  SharedProcessorStreamSharedPtr shared = pickStream(config_with_hash_key);
+  if (shared == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<MultiplexedProcessorStream>(std::move(shared), next_stream_id_++,
+                                                      callbacks);
+}
+
+SharedProcessorStreamSharedPtr
+MultiplexedStreamPool::pickStream(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  std::vector<SharedProcessorStreamSharedPtr>& streams = streams_[config_with_hash_key];
+  streams.erase(std::remove_if(streams.begin(), streams.end(),
+                               [](const SharedProcessorStreamSharedPtr& stream) {
+                                 return stream->closed();
+                               }),
+                streams.end());
+
+  SharedProcessorStreamSharedPtr least_loaded;
+  for (const SharedProcessorStreamSharedPtr& stream : streams) {
+    if (least_loaded == nullptr || stream->activeStreams() < least_loaded->activeStreams()) {
+      least_loaded = stream;
+    }
+  }
+  // Only open another stream when all of the existing ones are in use.
+  if (least_loaded != nullptr &&
+      (least_loaded->activeStreams() == 0 || streams.size() >= max_streams_)) {
+    return least_loaded;
+  }
+
+  auto client_or_error =
+      client_manager_.getOrCreateRawAsyncClientWithHashKey(config_with_hash_key, scope_, true);
+  if (!client_or_error.status().ok()) {
+    ENVOY_LOG_PERIODIC(error, std::chrono::seconds(10), "Creating raw async client failed {}",
+                       client_or_error.status());
+    return least_loaded;
+  }
+  SharedProcessorStreamSharedPtr stream = SharedProcessorStream::create(client_or_error.value());
+  if (stream == nullptr) {
+    return least_loaded;
+  }
+  streams.push_back(stream);
+  return stream;
+}
+
 } // namespace ExternalProcessing
 } // namespace HttpFilters
 } // namespace Extensions
@@ -6,10 +6,14 @@
 #include "envoy/grpc/async_client_manager.h"
 #include "envoy/service/ext_proc/v3/external_processor.pb.h"
 #include "envoy/stream_info/stream_info.h"
+#include "envoy/thread_local/thread_local_object.h"
 
+#include "source/common/grpc/typed_async_client.h"
 #include "source/common/http/sidestream_watermark.h"
 #include "source/extensions/filters/common/ext_proc/grpc_client.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -35,6 +39,73 @@ using ClientBasePtr = CommonExtProc::ClientBasePtr<ProcessingRequest, Processing
 ExternalProcessorClientPtr createExternalProcessorClient(Grpc::AsyncClientManager& client_manager,
                                                          Stats::Scope& scope);
 
+/**
+ * A long-lived gRPC stream to the external processor that carries the messages of many HTTP
+ * streams. Messages are correlated with their HTTP stream by ``multiplexed_stream_id``.
+ */
+class SharedProcessorStream : public Grpc::AsyncStreamCallbacks<ProcessingResponse>,
+                              public std::enable_shared_from_this<SharedProcessorStream>,
+                              public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  // Returns nullptr if the stream could not be started.
+  static std::shared_ptr<SharedProcessorStream> create(Grpc::RawAsyncClientSharedPtr client);
+  ~SharedProcessorStream() override;
+
+  bool closed() const { return closed_; }
+  size_t activeStreams() const { return subscribers_.size(); }
+
+  void subscribe(uint64_t id, ExternalProcessorCallbacks& callbacks);
+  void unsubscribe(uint64_t id);
+  void send(ProcessingRequest&& request);
+  StreamInfo::StreamInfo& streamInfo() { return stream_.streamInfo(); }
+
+  // Grpc::AsyncStreamCallbacks
+  void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+  void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override;
+  void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
+  void onRemoteClose(Grpc::Status::GrpcStatus status, const std::string& message) override;
+
+private:
+  explicit SharedProcessorStream(Grpc::RawAsyncClientSharedPtr client) : client_(client) {}
+
+  Grpc::AsyncClient<ProcessingRequest, ProcessingResponse> client_;
+  Grpc::AsyncStream<ProcessingRequest> stream_;
+  absl::flat_hash_map<uint64_t, ExternalProcessorCallbacks*> subscribers_;
+  bool closed_{false};
+};
+
+using SharedProcessorStreamSharedPtr = std::shared_ptr<SharedProcessorStream>;
+
+/**
+ * Per worker pool of shared gRPC streams. Each HTTP stream gets an ExternalProcessorStream that
+ * tags its messages with a worker unique ID and sends them over one of at most max_streams shared
+ * streams per gRPC service, picking the least loaded one.
+ */
+class MultiplexedStreamPool : public ThreadLocal::ThreadLocalObject,
+                              public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  MultiplexedStreamPool(Grpc::AsyncClientManager& client_manager, Stats::Scope& scope,
+                        uint32_t max_streams)
+      : client_manager_(client_manager), scope_(scope), max_streams_(max_streams) {}
+
+  // Returns nullptr if no shared stream could be started.
+  ExternalProcessorStreamPtr start(ExternalProcessorCallbacks& callbacks,
+                                   const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+
+private:
+  SharedProcessorStreamSharedPtr
+  pickStream(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+
+  Grpc::AsyncClientManager& client_manager_;
+  Stats::Scope& scope_;
+  const uint32_t max_streams_;
+  uint64_t next_stream_id_{1};
+  absl::flat_hash_map<Grpc::GrpcServiceConfigWithHashKey,
+                      std::vector<SharedProcessorStreamSharedPtr>>
+      streams_;
+};
+
 } // namespace ExternalProcessing
 } // namespace HttpFilters
 } // namespace Extensions
@@ -68,6 +68,12 @@ absl::Status verifyFilterConfig(
                                       "be set to none-default at the same time.");
   }
 
+  if (config.has_multiplexed_streams_per_worker() &&
+      (config.observability_mode() || config.has_http_service())) {
+    return absl::InvalidArgumentError("multiplexed_streams_per_worker can only be used with a "
+                                      "grpc_service and without observability_mode.");
+  }
+
   return verifyProcessingModeConfig(config);
 }
 
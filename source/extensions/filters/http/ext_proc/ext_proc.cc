@@ -311,6 +311,17 @@ FilterConfig::FilterConfig(const ExternalProcessor& config,
 
   thread_local_stream_manager_slot_->set(
       [](Envoy::Event::Dispatcher&) { return std::make_shared<ThreadLocalStreamManager>(); });
+
+  if (config.has_multiplexed_streams_per_worker()) {
+    multiplexed_stream_pool_slot_ =
+        ThreadLocal::TypedSlot<MultiplexedStreamPool>::makeUnique(context.threadLocal());
+    multiplexed_stream_pool_slot_->set(
+        [&context, &scope, max_streams = config.multiplexed_streams_per_worker().value()](
+            Envoy::Event::Dispatcher&) {
+          return std::make_shared<MultiplexedStreamPool>(
+              context.clusterManager().grpcAsyncClientManager(), scope, max_streams);
+        });
+  }
 }
 
 void ExtProcLoggingInfo::recordGrpcCall(
@@ -780,9 +791,15 @@ Filter::StreamOpenState Filter::openStream() {
                        .setSampled(absl::nullopt)
                        .setRemoteCloseTimeout(config_->remoteCloseTimeout());
 
-    ExternalProcessorClient* grpc_client = dynamic_cast<ExternalProcessorClient*>(client_.get());
-    ExternalProcessorStreamPtr stream_object =
-        grpc_client->start(*this, config_with_hash_key_, options, watermark_callbacks_);
+    ExternalProcessorStreamPtr stream_object;
+    if (MultiplexedStreamPool* pool = config_->multiplexedStreamPool(); pool != nullptr) {
+      stream_object = pool->start(*this, config_with_hash_key_);
+    } else {
+      ExternalProcessorClient* grpc_client =
+          dynamic_cast<ExternalProcessorClient*>(client_.get());
+      stream_object =
+          grpc_client->start(*this, config_with_hash_key_, options, watermark_callbacks_);
+    }
 
     if (processing_complete_ || stream_object == nullptr) {
       // Stream failed while starting and either onGrpcError or onGrpcClose was already called.
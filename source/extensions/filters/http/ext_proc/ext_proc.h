@@ -331,6 +331,11 @@ public:
     return grpc_service_;
   }
 
+  // Returns nullptr unless processing requests are multiplexed over shared gRPC streams.
+  MultiplexedStreamPool* multiplexedStreamPool() {
+    return multiplexed_stream_pool_slot_ != nullptr ? &**multiplexed_stream_pool_slot_ : nullptr;
+  }
+
   bool gracefulGrpcClose() const { return graceful_grpc_close_; }
 
   std::chrono::milliseconds remoteCloseTimeout() const { return remote_close_timeout_; }
@@ -390,6 +395,7 @@ private:
   const std::function<std::unique_ptr<OnProcessingResponse>()> on_processing_response_factory_cb_;
 
   ThreadLocal::SlotPtr thread_local_stream_manager_slot_;
+  ThreadLocal::TypedSlotPtr<MultiplexedStreamPool> multiplexed_stream_pool_slot_;
   envoy::extensions::filters::http::ext_proc::v3::ExternalProcessor::RouteCacheAction
       route_cache_action_;
   const envoy::extensions::filters::http::ext_proc::v3::ProcessingMode processing_mode_;
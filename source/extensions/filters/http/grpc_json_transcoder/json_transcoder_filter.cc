@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
 
+#include <limits>
 #include <memory>
 #include <unordered_set>
 
@@ -18,6 +19,7 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/http/grpc_json_transcoder/http_body_utils.h"
 
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_join.h"
 #include "google/api/annotations.pb.h"
 #include "google/api/http.pb.h"
@@ -546,6 +548,9 @@ Http::FilterHeadersStatus JsonTranscoderFilter::decodeHeaders(Http::RequestHeade
     if (checkAndRejectIfRequestTranscoderFailed(RcDetails::get().GrpcTranscodeFailed)) {
       return Http::FilterHeadersStatus::StopIteration;
     }
+    if (!end_stream) {
+      maybeStreamHttpBodyRequest(headers);
+    }
   }
 
   headers.removeContentLength();
@@ -591,6 +596,10 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::Continue;
   }
 
+  if (streamed_request_body_remaining_.has_value()) {
+    return decodeStreamedHttpBodyData(data, end_stream);
+  }
+
   if (method_->request_type_is_http_body_) {
     stats_->transcoder_request_buffer_bytes_.add(data.length());
     request_data_.move(data);
@@ -651,7 +660,12 @@ Http::FilterTrailersStatus JsonTranscoderFilter::decodeTrailers(Http::RequestTra
     return Http::FilterTrailersStatus::Continue;
   }
 
-  if (method_->request_type_is_http_body_) {
+  if (streamed_request_body_remaining_.has_value()) {
+    if (streamed_request_body_remaining_.value() != 0) {
+      rejectStreamedHttpBodyLengthMismatch();
+      return Http::FilterTrailersStatus::StopIteration;
+    }
+  } else if (method_->request_type_is_http_body_) {
     maybeSendHttpBodyRequestMessage(nullptr);
   } else {
     request_in_.finish();
@@ -953,6 +967,72 @@ void JsonTranscoderFilter::maybeSendHttpBodyRequestMessage(Buffer::Instance* dat
   first_request_sent_ = true;
 }
 
+void JsonTranscoderFilter::maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers) {
+  if (method_->descriptor_->client_streaming() || headers.ContentLength() == nullptr ||
+      !Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.grpc_json_transcoder_stream_http_body_requests")) {
+    return;
+  }
+  uint64_t content_length;
+  if (!absl::SimpleAtoi(headers.getContentLengthValue(), &content_length) || content_length == 0) {
+    return;
+  }
+  // Bodies over the limit are still buffered, so that they are rejected as before.
+  if (content_length >
+      per_route_config_->max_request_body_size_.value_or(decoder_callbacks_->bufferLimit())) {
+    return;
+  }
+
+  Buffer::OwnedImpl envelope;
+  HttpBodyUtils::appendHttpBodyEnvelope(envelope, method_->request_body_field_path, content_type_,
+                                        content_length, unknown_params_);
+  const uint64_t message_length =
+      initial_request_data_.length() + envelope.length() + content_length;
+  if (message_length > std::numeric_limits<uint32_t>::max()) {
+    return;
+  }
+
+  // The frame header, the fields set from the path and query arguments and the envelope are sent
+  // ahead of the first body chunk. The body itself is never buffered.
+  stats_->transcoder_request_buffer_bytes_.sub(initial_request_data_.length());
+  request_data_.move(initial_request_data_);
+  request_data_.move(envelope);
+  Envoy::Grpc::Encoder().prependFrameHeader(Envoy::Grpc::GRPC_FH_DEFAULT, request_data_,
+                                            message_length);
+  stats_->transcoder_request_buffer_bytes_.add(request_data_.length());
+  content_type_.clear();
+  streamed_request_body_remaining_ = content_length;
+}
+
+Http::FilterDataStatus JsonTranscoderFilter::decodeStreamedHttpBodyData(Buffer::Instance& data,
+                                                                        bool end_stream) {
+  uint64_t& remaining = streamed_request_body_remaining_.value();
+  if (data.length() > remaining || (end_stream && data.length() < remaining)) {
+    rejectStreamedHttpBodyLengthMismatch();
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+  remaining -= data.length();
+
+  if (!first_request_sent_) {
+    stats_->transcoder_request_buffer_bytes_.sub(request_data_.length());
+    data.prepend(request_data_);
+    first_request_sent_ = true;
+  }
+  ENVOY_STREAM_LOG(debug,
+                   "continuing request during decodeData, streamed data size={}, remaining={}",
+                   *decoder_callbacks_, data.length(), remaining);
+  return Http::FilterDataStatus::Continue;
+}
+
+void JsonTranscoderFilter::rejectStreamedHttpBodyLengthMismatch() {
+  ENVOY_STREAM_LOG(debug, "Request body length does not match content-length",
+                   *decoder_callbacks_);
+  error_ = true;
+  decoder_callbacks_->sendLocalReply(
+      Http::Code::BadRequest, "Bad request", nullptr, absl::nullopt,
+      absl::StrCat(RcDetails::get().GrpcTranscodeFailed, "{BAD_REQUEST}"));
+}
+
 bool JsonTranscoderFilter::buildResponseFromHttpBodyOutput(
     Http::ResponseHeaderMap& response_headers, Buffer::Instance& data) {
   std::vector<Grpc::Frame> frames;
@@ -182,6 +182,13 @@ private:
   bool checkAndRejectIfResponseTranscoderFailed();
   bool readToBuffer(Protobuf::io::ZeroCopyInputStream& stream, Buffer::Instance& data);
   void maybeSendHttpBodyRequestMessage(Buffer::Instance* data);
+  /**
+   * For unary HttpBody requests with a known content length, prepares the gRPC frame header and
+   * the message envelope so that the body can be forwarded as it arrives instead of buffered.
+   */
+  void maybeStreamHttpBodyRequest(const Http::RequestHeaderMap& headers);
+  Http::FilterDataStatus decodeStreamedHttpBodyData(Buffer::Instance& data, bool end_stream);
+  void rejectStreamedHttpBodyLengthMismatch();
   /**
    * Builds response from HttpBody protobuf.
    * Returns true if at least one gRPC frame has processed.
@@ -222,6 +229,8 @@ private:
   Buffer::OwnedImpl request_data_;
   bool first_request_sent_{false};
   std::string content_type_;
+  // The number of body bytes still expected when a unary HttpBody request is streamed.
+  absl::optional<uint64_t> streamed_request_body_remaining_;
 
   bool error_{false};
   bool has_body_{false};
@@ -4,6 +4,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/base64.h"
+#include "source/common/common/bounded_thread_pool.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/logger.h"
 #include "source/common/http/message_impl.h"
@@ -15,7 +16,9 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/tracing/http_tracer_impl.h"
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 
 namespace Envoy {
@@ -40,6 +43,39 @@ static std::string convertClaimDoubleToString(double double_value) {
   const uint64_t int_claim_value = static_cast<uint64_t>(double_value);
   return std::to_string(int_claim_value);
 }
+
+class AuthenticatorImpl;
+
+/**
+ * A signature verification, shared by the authenticator that started it and the pool thread
+ * performing it.
+ */
+class PendingVerification : public std::enable_shared_from_this<PendingVerification> {
+public:
+  PendingVerification(AuthenticatorImpl& authenticator, Event::Dispatcher& dispatcher,
+                      std::unique_ptr<JwtVerify::Jwt>&& jwt, JwksConstSharedPtr jwks)
+      : jwt_(std::move(jwt)), authenticator_(&authenticator), dispatcher_(dispatcher),
+        jwks_(std::move(jwks)) {}
+
+  // Verifies the signature and hands the JWT back to the dispatcher of the authenticator, if the
+  // authenticator still exists. Called on a thread of the verification pool.
+  void verifyAndPost();
+
+  // Detaches the verification from its authenticator, which is being destroyed.
+  void detach();
+
+  std::unique_ptr<JwtVerify::Jwt> jwt_;
+
+private:
+  absl::Mutex mutex_;
+  AuthenticatorImpl* authenticator_ ABSL_GUARDED_BY(mutex_);
+  Event::Dispatcher& dispatcher_;
+  const JwksConstSharedPtr jwks_;
+  Status status_{Status::Ok};
+};
+
+using PendingVerificationSharedPtr = std::shared_ptr<PendingVerification>;
+
 /**
  * Object to implement Authenticator interface.
  */
@@ -56,6 +92,12 @@ public:
         create_jwks_fetcher_cb_(create_jwks_fetcher_cb), check_audience_(check_audience),
         provider_(provider), is_allow_failed_(allow_failed), is_allow_missing_(allow_missing),
         time_source_(time_source) {}
+  ~AuthenticatorImpl() override {
+    if (verification_) {
+      verification_->detach();
+    }
+  }
+
   // Following functions are for JwksFetcher::JwksReceiver interface
   void onJwksSuccess(Envoy::JwtVerify::JwksPtr&& jwks) override;
   void onJwksError(Failure reason) override;
@@ -68,6 +110,9 @@ public:
 
   TimeSource& timeSource() { return time_source_; }
 
+  // Called on the worker thread once the verification pool has verified the signature.
+  void onVerificationComplete(std::unique_ptr<JwtVerify::Jwt>&& jwt, const Status& status);
+
 private:
   // Returns the name of the authenticator. For debug logging only.
   std::string name() const;
@@ -75,6 +120,13 @@ private:
   // Verify with a specific public key.
   void verifyKey();
 
+  // Continue once the signature of the JWT has been verified.
+  void onKeyVerified(const Status& status);
+
+  // Lookup the current token in the cache shared by all workers. On a hit, a copy of the cached
+  // JWT is owned by this authenticator.
+  bool lookupSharedJwtCache();
+
   // Handle Good Jwt either Cache JWT or verified public key.
   void handleGoodJwt(bool cache_hit);
 
@@ -103,6 +155,9 @@ private:
   // The Jwks fetcher object
   Common::JwksFetcherPtr fetcher_;
 
+  // The pending signature verification on the verification pool.
+  PendingVerificationSharedPtr verification_;
+
   // The token data
   std::vector<JwtLocationConstPtr> tokens_;
   JwtLocationConstPtr curr_token_;
@@ -174,6 +229,7 @@ void AuthenticatorImpl::startVerify() {
   ENVOY_LOG(debug, "{}: startVerify: tokens size {}", name(), tokens_.size());
   curr_token_ = std::move(tokens_.back());
   tokens_.pop_back();
+  owned_jwt_.reset();
 
   bool use_jwt_cache = false;
   Status status;
@@ -185,6 +241,7 @@ void AuthenticatorImpl::startVerify() {
       use_jwt_cache = true;
     } else {
       jwks_cache_.stats().jwt_cache_miss_.inc();
+      use_jwt_cache = lookupSharedJwtCache();
     }
   }
 
@@ -323,12 +380,66 @@ void AuthenticatorImpl::onDestroy() {
   if (fetcher_) {
     fetcher_->cancel();
   }
+  if (verification_) {
+    verification_->detach();
+    verification_.reset();
+  }
+}
+
+bool AuthenticatorImpl::lookupSharedJwtCache() {
+  SharedJwtCache* shared_jwt_cache = jwks_data_->getSharedJwtCache();
+  if (shared_jwt_cache == nullptr) {
+    return false;
+  }
+  const JwtConstSharedPtr shared_jwt = shared_jwt_cache->lookup(curr_token_->token());
+  if (shared_jwt == nullptr) {
+    jwks_cache_.stats().jwt_shared_cache_miss_.inc();
+    return false;
+  }
+  jwks_cache_.stats().jwt_shared_cache_hit_.inc();
+  // The copy is moved into the thread local cache once the claims are checked, so that later
+  // requests on this worker do not take the shared cache lock.
+  owned_jwt_ = std::make_unique<JwtVerify::Jwt>(*shared_jwt);
+  jwt_ = owned_jwt_.get();
+  return true;
 }
 
 // Verify with a specific public key.
 void AuthenticatorImpl::verifyKey() {
-  const Status status = JwtVerify::verifyJwtWithoutTimeChecking(*jwt_, *jwks_data_->getJwksObj());
+  Thread::BoundedThreadPool* verification_pool = jwks_cache_.verificationPool();
+  if (verification_pool == nullptr) {
+    onKeyVerified(JwtVerify::verifyJwtWithoutTimeChecking(*jwt_, *jwks_data_->getJwksObj()));
+    return;
+  }
+
+  // The JWT is owned by the verification until it completes.
+  ASSERT(owned_jwt_ != nullptr && jwt_ == owned_jwt_.get());
+  jwt_ = nullptr;
+  verification_ = std::make_shared<PendingVerification>(
+      *this, jwks_data_->dispatcher(), std::move(owned_jwt_), jwks_data_->getJwksSharedObj());
+  if (verification_pool->post(
+          [verification = verification_]() { verification->verifyAndPost(); })) {
+    return;
+  }
+
+  // The pool is saturated, so verify here rather than queueing without bound.
+  ENVOY_LOG(debug, "{}: verification pool full, verifying inline", name());
+  jwks_cache_.stats().jwt_verification_pool_full_.inc();
+  owned_jwt_ = std::move(verification_->jwt_);
+  jwt_ = owned_jwt_.get();
+  verification_.reset();
+  onKeyVerified(JwtVerify::verifyJwtWithoutTimeChecking(*jwt_, *jwks_data_->getJwksObj()));
+}
+
+void AuthenticatorImpl::onVerificationComplete(std::unique_ptr<JwtVerify::Jwt>&& jwt,
+                                               const Status& status) {
+  verification_.reset();
+  owned_jwt_ = std::move(jwt);
+  jwt_ = owned_jwt_.get();
+  onKeyVerified(status);
+}
 
+void AuthenticatorImpl::onKeyVerified(const Status& status) {
   if (status != Status::Ok) {
     doneWithStatus(status);
     return;
@@ -421,7 +532,12 @@ void AuthenticatorImpl::handleGoodJwt(bool cache_hit) {
       setPayloadMetadata(jwt_->payload_pb_);
     }
   }
-  if (provider_ && !cache_hit) {
+  // The JWT is owned here when it was just verified or copied from the shared cache.
+  if (provider_ && owned_jwt_ != nullptr) {
+    SharedJwtCache* shared_jwt_cache = jwks_data_->getSharedJwtCache();
+    if (!cache_hit && shared_jwt_cache != nullptr) {
+      shared_jwt_cache->insert(curr_token_->token(), *owned_jwt_);
+    }
     // move the ownership of "owned_jwt_" into the function.
     jwks_data_->getJwtCache().insert(curr_token_->token(), std::move(owned_jwt_));
   }
@@ -507,6 +623,32 @@ void AuthenticatorImpl::doneWithStatus(const Status& status) {
   startVerify();
 }
 
+void PendingVerification::verifyAndPost() {
+  status_ = JwtVerify::verifyJwtWithoutTimeChecking(*jwt_, *jwks_);
+
+  // The authenticator is destroyed on its dispatcher before the dispatcher itself, so the
+  // dispatcher is alive for as long as the authenticator is attached.
+  absl::MutexLock lock(mutex_);
+  if (authenticator_ == nullptr) {
+    return;
+  }
+  dispatcher_.post([self = shared_from_this()]() {
+    AuthenticatorImpl* authenticator;
+    {
+      absl::MutexLock lock(self->mutex_);
+      authenticator = self->authenticator_;
+    }
+    if (authenticator != nullptr) {
+      authenticator->onVerificationComplete(std::move(self->jwt_), self->status_);
+    }
+  });
+}
+
+void PendingVerification::detach() {
+  absl::MutexLock lock(mutex_);
+  authenticator_ = nullptr;
+}
+
 } // namespace
 
 AuthenticatorPtr Authenticator::create(const CheckAudience* check_audience,
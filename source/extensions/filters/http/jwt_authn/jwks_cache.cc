@@ -5,6 +5,7 @@
 
 #include "envoy/common/time.h"
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/logger.h"
@@ -27,11 +28,20 @@ namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace JwtAuthn {
+
+SINGLETON_MANAGER_REGISTRATION(jwt_authn_verification_pool);
+
 namespace {
 
 using JwtVerify::Jwks;
 using JwtVerify::Status;
 
+// The maximum size of JWT to be cached, matching the thread local JWT cache.
+constexpr uint32_t kMaxJwtSizeForCache = 4 * 1024; // 4KiB
+
+// The maximum number of signatures a pool thread verifies per wakeup.
+constexpr size_t kMaxVerificationBatchSize = 16;
+
 class JwksDataImpl : public JwksCache::JwksData, public Logger::Loggable<Logger::Id::jwt> {
 public:
   JwksDataImpl(const JwtProvider& jwt_provider, Server::Configuration::FactoryContext& context,
@@ -61,8 +71,14 @@ public:
     bool enable_jwt_cache = jwt_provider_.has_jwt_cache_config();
     const auto& config = jwt_provider_.jwt_cache_config();
     tls_.set([enable_jwt_cache, config](Envoy::Event::Dispatcher& dispatcher) {
-      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource());
+      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher);
     });
+    if (enable_jwt_cache && config.has_shared_jwt_cache_size()) {
+      shared_jwt_cache_ = std::make_unique<SharedJwtCache>(
+          config.shared_jwt_cache_size().value(),
+          config.jwt_max_token_size() == 0 ? kMaxJwtSizeForCache : config.jwt_max_token_size(),
+          time_source_);
+    }
 
     const auto inline_jwks =
         THROW_OR_RETURN_VALUE(Config::DataSource::read(jwt_provider_.local_jwks(), true,
@@ -156,6 +172,8 @@ public:
 
   const Jwks* getJwksObj() const override { return tls_->jwks_.get(); }
 
+  JwksConstSharedPtr getJwksSharedObj() const override { return tls_->jwks_; }
+
   bool isExpired() const override { return time_source_.monotonicTime() >= tls_->expire_; }
 
   const JwtVerify::Jwks* setRemoteJwks(JwksConstPtr&& jwks) override {
@@ -169,13 +187,20 @@ public:
 
   JwtCache& getJwtCache() override { return *tls_->jwt_cache_; }
 
+  SharedJwtCache* getSharedJwtCache() override { return shared_jwt_cache_.get(); }
+
+  Event::Dispatcher& dispatcher() override { return tls_->dispatcher_; }
+
 private:
   struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
     ThreadLocalCache(bool enable_jwt_cache,
                      const envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig& config,
-                     TimeSource& time_source)
-        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source)) {}
+                     Event::Dispatcher& dispatcher)
+        : dispatcher_(dispatcher),
+          jwt_cache_(JwtCache::create(enable_jwt_cache, config, dispatcher.timeSource())) {}
 
+    // The dispatcher of the thread.
+    Event::Dispatcher& dispatcher_;
     // The jwks object.
     JwksConstSharedPtr jwks_;
     // The JwtCache object
@@ -205,6 +230,8 @@ private:
   ThreadLocal::TypedSlot<ThreadLocalCache> tls_;
   // async fetcher
   JwksAsyncFetcherPtr async_fetcher_;
+  // The JWT cache shared by all threads, if configured.
+  SharedJwtCachePtr shared_jwt_cache_;
   absl::optional<Matchers::StringMatcherImpl> sub_matcher_;
   absl::optional<absl::Duration> max_exp_;
 };
@@ -217,6 +244,13 @@ public:
   JwksCacheImpl(const JwtAuthentication& config, Server::Configuration::FactoryContext& context,
                 CreateJwksFetcherCb fetcher_fn, JwtAuthnFilterStats& stats)
       : stats_(stats) {
+    if (config.verification_threads() > 0) {
+      verification_pool_ = Thread::BoundedThreadPool::get(
+          context.serverFactoryContext().singletonManager(),
+          SINGLETON_MANAGER_REGISTERED_NAME(jwt_authn_verification_pool),
+          context.serverFactoryContext().api().threadFactory(), "jwt_verify",
+          kMaxVerificationBatchSize, config.verification_threads());
+    }
     for (const auto& [name, provider] : config.providers()) {
       auto jwks_data = std::make_unique<JwksDataImpl>(provider, context, fetcher_fn, stats);
       if (issuer_ptr_map_.find(provider.issuer()) == issuer_ptr_map_.end()) {
@@ -253,6 +287,8 @@ public:
 
   JwtAuthnFilterStats& stats() override { return stats_; }
 
+  Thread::BoundedThreadPool* verificationPool() override { return verification_pool_.get(); }
+
 private:
   JwksData* findIssuerMap(const std::string& issuer) {
     const auto& it = issuer_ptr_map_.find(issuer);
@@ -268,6 +304,8 @@ private:
   absl::node_hash_map<std::string, JwksDataImplPtr> jwks_data_map_;
   // The Jwks data pointer map indexed by issuer.
   absl::node_hash_map<std::string, JwksData*> issuer_ptr_map_;
+  // The process wide pool verifying signatures off the worker threads, if configured.
+  Thread::BoundedThreadPoolSharedPtr verification_pool_;
 };
 
 } // namespace
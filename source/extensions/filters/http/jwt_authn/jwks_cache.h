@@ -5,12 +5,15 @@
 #include "envoy/api/api.h"
 #include "envoy/common/pure.h"
 #include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
 
+#include "source/common/common/bounded_thread_pool.h"
 #include "source/common/jwt/jwks.h"
 #include "source/extensions/filters/http/common/jwks_fetcher.h"
 #include "source/extensions/filters/http/jwt_authn/jwks_async_fetcher.h"
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
+#include "source/extensions/filters/http/jwt_authn/shared_jwt_cache.h"
 #include "source/extensions/filters/http/jwt_authn/stats.h"
 
 #include "absl/strings/string_view.h"
@@ -72,6 +75,9 @@ public:
     // Get the Jwks object.
     virtual const JwtVerify::Jwks* getJwksObj() const PURE;
 
+    // Get the Jwks object, sharing its ownership.
+    virtual JwksConstSharedPtr getJwksSharedObj() const PURE;
+
     // Return true if jwks object is expired.
     virtual bool isExpired() const PURE;
 
@@ -80,6 +86,12 @@ public:
 
     // Get Token Cache.
     virtual JwtCache& getJwtCache() PURE;
+
+    // Get the token cache shared by all worker threads, nullptr if it is not configured.
+    virtual SharedJwtCache* getSharedJwtCache() PURE;
+
+    // Get the dispatcher of the calling worker thread.
+    virtual Event::Dispatcher& dispatcher() PURE;
   };
 
   // If there is only one provider in the config, return the data for that provider.
@@ -94,6 +106,9 @@ public:
 
   virtual JwtAuthnFilterStats& stats() PURE;
 
+  // Get the pool verifying signatures off the worker threads, nullptr if it is not configured.
+  virtual Thread::BoundedThreadPool* verificationPool() PURE;
+
   // Factory function to create an instance.
   static JwksCachePtr
   create(const envoy::extensions::filters::http::jwt_authn::v3::JwtAuthentication& config,
@@ -0,0 +1,79 @@
+#include "source/extensions/filters/http/jwt_authn/shared_jwt_cache.h"
+
+#include "source/common/common/utility.h"
+
+#include "openssl/sha.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+namespace {
+
+std::string tokenDigest(absl::string_view token) {
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(token.data()), token.size(),
+         reinterpret_cast<uint8_t*>(digest.data()));
+  return digest;
+}
+
+} // namespace
+
+SharedJwtCache::SharedJwtCache(uint32_t max_size, uint32_t max_token_size,
+                               TimeSource& time_source)
+    : max_shard_size_((max_size + NumShards - 1) / NumShards), max_token_size_(max_token_size),
+      time_source_(time_source) {}
+
+SharedJwtCache::Shard& SharedJwtCache::shardFor(const std::string& digest) {
+  // The digest is uniformly distributed, so its first byte is as good as any hash.
+  return shards_[static_cast<uint8_t>(digest[0]) % NumShards];
+}
+
+JwtConstSharedPtr SharedJwtCache::lookup(absl::string_view token) {
+  if (token.size() > max_token_size_) {
+    return nullptr;
+  }
+  const std::string digest = tokenDigest(token);
+  Shard& shard = shardFor(digest);
+  absl::MutexLock lock(shard.mutex_);
+  auto it = shard.entries_.find(digest);
+  if (it == shard.entries_.end()) {
+    return nullptr;
+  }
+  const JwtConstSharedPtr& jwt = it->second->second;
+  if (jwt->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) ==
+      JwtVerify::Status::JwtExpired) {
+    shard.lru_.erase(it->second);
+    shard.entries_.erase(it);
+    return nullptr;
+  }
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+  return jwt;
+}
+
+void SharedJwtCache::insert(absl::string_view token, const JwtVerify::Jwt& jwt) {
+  if (token.size() > max_token_size_) {
+    return;
+  }
+  std::string digest = tokenDigest(token);
+  // Copy the JWT outside of the lock.
+  auto entry = std::make_shared<const JwtVerify::Jwt>(jwt);
+  Shard& shard = shardFor(digest);
+  absl::MutexLock lock(shard.mutex_);
+  if (auto it = shard.entries_.find(digest); it != shard.entries_.end()) {
+    // Another worker verified the same token concurrently.
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+    return;
+  }
+  if (shard.lru_.size() >= max_shard_size_) {
+    shard.entries_.erase(shard.lru_.back().first);
+    shard.lru_.pop_back();
+  }
+  shard.lru_.emplace_front(digest, std::move(entry));
+  shard.entries_.emplace(std::move(digest), shard.lru_.begin());
+}
+
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
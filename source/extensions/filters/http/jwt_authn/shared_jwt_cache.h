@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+
+#include "source/common/jwt/jwt.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+
+class SharedJwtCache;
+using SharedJwtCachePtr = std::unique_ptr<SharedJwtCache>;
+using JwtConstSharedPtr = std::shared_ptr<const JwtVerify::Jwt>;
+
+// Cache of verified JWTs shared by all worker threads. The key is the SHA-256 digest of the JWT
+// string, so that memory use does not depend on the token size. The cache is split into shards
+// with their own lock and LRU list, to keep contention between workers low.
+class SharedJwtCache {
+public:
+  SharedJwtCache(uint32_t max_size, uint32_t max_token_size, TimeSource& time_source);
+
+  // Lookup a JWT in the cache. Returns nullptr if it is not found or has expired.
+  JwtConstSharedPtr lookup(absl::string_view token);
+
+  // Insert a copy of a verified JWT into the cache.
+  void insert(absl::string_view token, const JwtVerify::Jwt& jwt);
+
+  static constexpr size_t NumShards = 16;
+
+private:
+  struct Shard {
+    using LruList = std::list<std::pair<std::string, JwtConstSharedPtr>>;
+
+    absl::Mutex mutex_;
+    // Most recently used entries are at the front.
+    LruList lru_ ABSL_GUARDED_BY(mutex_);
+    absl::flat_hash_map<std::string, LruList::iterator> entries_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shardFor(const std::string& digest);
+
+  const size_t max_shard_size_;
+  const uint32_t max_token_size_;
+  TimeSource& time_source_;
+  std::array<Shard, NumShards> shards_;
+};
+
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
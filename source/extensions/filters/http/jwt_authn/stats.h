@@ -17,7 +17,10 @@ namespace JwtAuthn {
   COUNTER(jwks_fetch_success)                                                                      \
   COUNTER(jwks_fetch_failed)                                                                       \
   COUNTER(jwt_cache_hit)                                                                           \
-  COUNTER(jwt_cache_miss)
+  COUNTER(jwt_cache_miss)                                                                          \
+  COUNTER(jwt_shared_cache_hit)                                                                    \
+  COUNTER(jwt_shared_cache_miss)                                                                   \
+  COUNTER(jwt_verification_pool_full)
 
 /**
  * Wrapper struct for jwt_authn filter stats. @see stats_macros.h
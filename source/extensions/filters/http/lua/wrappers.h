@@ -8,6 +8,7 @@
 #include "source/extensions/filters/common/lua/lua.h"
 #include "source/extensions/filters/common/lua/wrappers.h"
 
+#include "absl/container/inlined_vector.h"
 #include "openssl/evp.h"
 
 namespace Envoy {
@@ -30,7 +31,8 @@ public:
 
 private:
   HeaderMapWrapper& parent_;
-  std::vector<const Http::HeaderEntry*> entries_;
+  // Iterating typical header maps does not allocate beyond the Lua userdata itself.
+  absl::InlinedVector<const Http::HeaderEntry*, 32> entries_;
   uint64_t current_{};
 };
 
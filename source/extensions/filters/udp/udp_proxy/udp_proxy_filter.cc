@@ -447,7 +447,8 @@ void UdpProxyFilter::UdpActiveSession::onReadReady() {
   uint32_t packets_dropped = 0;
   const Api::IoErrorPtr result = Network::Utility::readPacketsFromSocket(
       udp_socket_->ioHandle(), *addresses_.local_, *this, filter_.config_->timeSource(),
-      filter_.config_->upstreamSocketConfig().prefer_gro_, /*allow_mmsg=*/true, packets_dropped);
+      filter_.config_->upstreamSocketConfig().prefer_gro_, /*allow_mmsg=*/true, packets_dropped,
+      filter_.config_->upstreamSocketConfig().batch_gro_reads_);
 
   if (result == nullptr) {
     udp_socket_->ioHandle().activateFileEvents(Event::FileReadyType::Read);
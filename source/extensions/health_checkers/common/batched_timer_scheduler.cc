@@ -0,0 +1,83 @@
+#include "source/extensions/health_checkers/common/batched_timer_scheduler.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+BatchedTimerScheduler::BatchedTimerScheduler(Event::Dispatcher& dispatcher,
+                                             std::chrono::milliseconds window)
+    : dispatcher_(dispatcher), window_(window),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })) {
+  ASSERT(window_.count() > 0);
+}
+
+Event::TimerPtr BatchedTimerScheduler::createTimer(Event::TimerCb cb) {
+  return std::make_unique<BatchedTimer>(*this, std::move(cb));
+}
+
+void BatchedTimerScheduler::BatchedTimer::disableTimer() {
+  if (!batch_.has_value()) {
+    return;
+  }
+  auto it = parent_.batches_.find(batch_->first);
+  ASSERT(it != parent_.batches_.end());
+  it->second.erase(batch_->second);
+  batch_.reset();
+}
+
+void BatchedTimerScheduler::BatchedTimer::enableTimer(std::chrono::milliseconds duration,
+                                                      const ScopeTrackedObject*) {
+  parent_.schedule(*this, duration);
+}
+
+void BatchedTimerScheduler::BatchedTimer::enableHRTimer(std::chrono::microseconds duration,
+                                                        const ScopeTrackedObject*) {
+  parent_.schedule(*this, duration);
+}
+
+void BatchedTimerScheduler::schedule(BatchedTimer& timer, std::chrono::microseconds duration) {
+  timer.disableTimer();
+
+  // Round up to the end of the window the deadline falls in. The result is always later than now,
+  // so a timer enabled from a callback never lands in the batch that is running.
+  const auto deadline = (dispatcher_.timeSource().monotonicTime() + duration).time_since_epoch();
+  const MonotonicTime batch_time{(deadline / window_ + 1) * window_};
+  const bool earliest = batches_.empty() || batch_time < batches_.begin()->first;
+  Batch& batch = batches_[batch_time];
+  timer.batch_.emplace(batch_time, batch.insert(batch.end(), &timer));
+  if (earliest) {
+    armTimer();
+  }
+}
+
+void BatchedTimerScheduler::onTimer() {
+  ++wakeups_;
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  while (!batches_.empty() && batches_.begin()->first <= now) {
+    // Callbacks may enable or disable any timer, so take the timers one at a time rather than
+    // iterating over the batch.
+    Batch& batch = batches_.begin()->second;
+    while (!batch.empty()) {
+      BatchedTimer* timer = batch.front();
+      batch.pop_front();
+      timer->batch_.reset();
+      timer->cb_();
+    }
+    batches_.erase(batches_.begin());
+  }
+  armTimer();
+}
+
+void BatchedTimerScheduler::armTimer() {
+  if (batches_.empty()) {
+    timer_->disableTimer();
+    return;
+  }
+  const auto delay = batches_.begin()->first - dispatcher_.timeSource().monotonicTime();
+  timer_->enableTimer(
+      std::max(std::chrono::milliseconds(0), std::chrono::ceil<std::chrono::milliseconds>(delay)));
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Creates timers that share a single dispatcher timer. The deadline of each timer is rounded up
+ * to the end of a batch window, and all the timers due in the same window run together from one
+ * wakeup of the dispatcher. This trades up to one window of delay per timer for far fewer timer
+ * events when there are many timers, e.g. the health check intervals of thousands of hosts.
+ */
+class BatchedTimerScheduler {
+public:
+  BatchedTimerScheduler(Event::Dispatcher& dispatcher, std::chrono::milliseconds window);
+
+  /**
+   * @return a timer that runs cb on the dispatcher. The timer must be destroyed before the
+   *         scheduler.
+   */
+  Event::TimerPtr createTimer(Event::TimerCb cb);
+
+  /**
+   * @return the number of times the shared dispatcher timer has fired.
+   */
+  uint64_t wakeups() const { return wakeups_; }
+
+private:
+  class BatchedTimer;
+  using Batch = std::list<BatchedTimer*>;
+
+  class BatchedTimer : public Event::Timer {
+  public:
+    BatchedTimer(BatchedTimerScheduler& parent, Event::TimerCb cb)
+        : parent_(parent), cb_(std::move(cb)) {}
+    ~BatchedTimer() override { disableTimer(); }
+
+    // Event::Timer
+    void disableTimer() override;
+    void enableTimer(std::chrono::milliseconds duration, const ScopeTrackedObject* scope) override;
+    void enableHRTimer(std::chrono::microseconds duration,
+                       const ScopeTrackedObject* scope) override;
+    bool enabled() override { return batch_.has_value(); }
+
+  private:
+    friend class BatchedTimerScheduler;
+
+    BatchedTimerScheduler& parent_;
+    const Event::TimerCb cb_;
+    // The batch the timer is in while it is enabled, and its position in the batch.
+    absl::optional<std::pair<MonotonicTime, Batch::iterator>> batch_;
+  };
+
+  void schedule(BatchedTimer& timer, std::chrono::microseconds duration);
+  void onTimer();
+  void armTimer();
+
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds window_;
+  const Event::TimerPtr timer_;
+  // Enabled timers by the end of their batch window. Batches emptied by disabled timers are only
+  // removed once they are due.
+  std::map<MonotonicTime, Batch> batches_;
+  uint64_t wakeups_{};
+};
+
+} // namespace Upstream
+} // namespace Envoy
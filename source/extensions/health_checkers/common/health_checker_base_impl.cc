@@ -43,7 +43,14 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) {
             onClusterMemberUpdate(hosts_added, hosts_removed);
-          })} {}
+          })} {
+  const std::chrono::milliseconds interval_batch_window(
+      PROTOBUF_GET_MS_OR_DEFAULT(config, interval_batch_window, 0));
+  if (interval_batch_window.count() > 0) {
+    interval_scheduler_ =
+        std::make_unique<BatchedTimerScheduler>(dispatcher, interval_batch_window);
+  }
+}
 
 std::shared_ptr<const Network::TransportSocketOptionsImpl>
 HealthCheckerImplBase::initTransportSocketOptions(
@@ -159,6 +166,11 @@ HealthCheckerImplBase::intervalWithJitter(uint64_t base_time_ms,
   return std::chrono::milliseconds(final_ms);
 }
 
+Event::TimerPtr HealthCheckerImplBase::createIntervalTimer(Event::TimerCb cb) {
+  return interval_scheduler_ != nullptr ? interval_scheduler_->createTimer(std::move(cb))
+                                        : dispatcher_.createTimer(std::move(cb));
+}
+
 void HealthCheckerImplBase::addHosts(const HostVector& hosts) {
   for (const HostSharedPtr& host : hosts) {
     if (host->disableActiveHealthCheck()) {
@@ -252,7 +264,7 @@ void HealthCheckerImplBase::start() {
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
     HealthCheckerImplBase& parent, HostSharedPtr host)
     : host_(host), parent_(parent),
-      interval_timer_(parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
+      interval_timer_(parent.createIntervalTimer([this]() -> void { onIntervalBase(); })),
       timeout_timer_(parent.dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })),
       time_source_(parent.dispatcher_.timeSource()) {
 
@@ -14,6 +14,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
 #include "source/common/network/transport_socket_options_impl.h"
+#include "source/extensions/health_checkers/common/batched_timer_scheduler.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -138,6 +139,7 @@ private:
   std::chrono::milliseconds interval(HealthState state, HealthTransition changed_state) const;
   std::chrono::milliseconds intervalWithJitter(uint64_t base_time_ms,
                                                std::chrono::milliseconds interval_jitter) const;
+  Event::TimerPtr createIntervalTimer(Event::TimerCb cb);
   void onClusterMemberUpdate(const HostVector& hosts_added, const HostVector& hosts_removed);
   void runCallbacks(HostSharedPtr host, HealthTransition changed_state,
                     HealthState current_check_result);
@@ -158,6 +160,8 @@ private:
   const std::chrono::milliseconds unhealthy_interval_;
   const std::chrono::milliseconds unhealthy_edge_interval_;
   const std::chrono::milliseconds healthy_edge_interval_;
+  // Runs the interval timers of the sessions if interval_batch_window is set.
+  std::unique_ptr<BatchedTimerScheduler> interval_scheduler_;
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
@@ -37,6 +37,9 @@ namespace {
 // Ref: https://github.com/envoyproxy/envoy/issues/35117
 constexpr uint32_t DEFAULT_QUERY_TIMEOUT_SECONDS = 5;
 constexpr uint32_t DEFAULT_QUERY_TRIES = 4;
+constexpr uint32_t DEFAULT_CACHE_MAX_ENTRIES = 1024;
+constexpr uint64_t DEFAULT_CACHE_NEGATIVE_TTL_SECONDS = 5;
+constexpr uint32_t DEFAULT_CACHE_PREFETCH_PERCENT = 10;
 } // namespace
 
 DnsResolverImpl::DnsResolverImpl(
@@ -67,6 +70,17 @@ DnsResolverImpl::DnsResolverImpl(
   AresOptions options = defaultAresOptions();
   initializeChannel(&options.options_, options.optmask_);
 
+  if (config.has_response_cache()) {
+    const auto& cache_config = config.response_cache();
+    response_cache_ = std::make_unique<DnsResponseCache>(
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache_config, max_entries, DEFAULT_CACHE_MAX_ENTRIES),
+        std::chrono::seconds(PROTOBUF_GET_SECONDS_OR_DEFAULT(
+            cache_config, negative_ttl, DEFAULT_CACHE_NEGATIVE_TTL_SECONDS)),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(cache_config, prefetch_percent,
+                                        DEFAULT_CACHE_PREFETCH_PERCENT),
+        dispatcher.timeSource());
+  }
+
   // Initialize the periodic UDP channel refresh timer if configured.
   if (max_udp_channel_duration_ > std::chrono::milliseconds::zero()) {
     udp_channel_refresh_timer_ = dispatcher.createTimer([this] { onUdpChannelRefreshTimer(); });
@@ -476,13 +490,86 @@ void DnsResolverImpl::onUdpChannelRefreshTimer() {
   }
 }
 
+void DnsResolverImpl::resetNetworking() {
+  reinitializeChannel();
+  // Responses cached before a network change may not be valid after it.
+  if (response_cache_ != nullptr) {
+    response_cache_->clear();
+  }
+}
+
 ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
                                          DnsLookupFamily dns_lookup_family, ResolveCb callback) {
-  ENVOY_LOG_EVENT(trace, "cares_dns_resolution_start", "dns resolution for {} started", dns_name);
+  if (response_cache_ == nullptr) {
+    return startResolution(dns_name, dns_lookup_family, std::move(callback));
+  }
+
+  DnsResponseCache::Key key{dns_name, dns_lookup_family};
+  absl::optional<DnsResponseCache::Hit> hit = response_cache_->lookup(key);
+  if (hit.has_value()) {
+    stats_.cache_hits_.inc();
+    ENVOY_LOG_EVENT(trace, "cares_cache_hit", "dns resolution for {} served from cache", dns_name);
+    // Start the refresh before invoking the callback, which might destroy this resolver.
+    if (hit->prefetch_ && !in_flight_.contains(key)) {
+      stats_.cache_prefetches_.inc();
+      in_flight_.emplace(key, std::vector<CoalescedQueryPtr>());
+      startCachedResolution(key);
+    }
+    callback(ResolutionStatus::Completed, "cares_cache_hit", std::move(hit->responses_));
+    return nullptr;
+  }
+
+  auto it = in_flight_.find(key);
+  if (it != in_flight_.end()) {
+    stats_.cache_coalesced_.inc();
+    it->second.push_back(std::make_unique<CoalescedQuery>(std::move(callback)));
+    return it->second.back().get();
+  }
+
+  stats_.cache_misses_.inc();
+  std::vector<CoalescedQueryPtr> queries;
+  queries.push_back(std::make_unique<CoalescedQuery>(std::move(callback)));
+  ActiveDnsQuery* query = queries.back().get();
+  in_flight_.emplace(key, std::move(queries));
+  // If the resolution completed inline the query has already been called back and destroyed.
+  return startCachedResolution(key) != nullptr ? query : nullptr;
+}
+
+ActiveDnsQuery* DnsResolverImpl::startCachedResolution(const DnsResponseCache::Key& key) {
+  return startResolution(key.first, key.second,
+                         [this, key](ResolutionStatus status, absl::string_view details,
+                                     std::list<DnsResponse>&& responses) {
+                           onCachedResolution(key, status, details, std::move(responses));
+                         });
+}
 
-  // TODO(hennna): Add DNS caching which will allow testing the edge case of a
-  // failed initial call to getAddrInfo followed by a synchronous IPv4
-  // resolution.
+void DnsResolverImpl::onCachedResolution(const DnsResponseCache::Key& key, ResolutionStatus status,
+                                         absl::string_view details,
+                                         std::list<DnsResponse>&& responses) {
+  if (status == ResolutionStatus::Completed) {
+    response_cache_->insert(key, responses);
+  }
+
+  auto node = in_flight_.extract(key);
+  if (node.empty()) {
+    return;
+  }
+  std::vector<CoalescedQueryPtr>& queries = node.mapped();
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if (queries[i]->cancelled_) {
+      continue;
+    }
+    // The last caller can take the responses, the others get a copy.
+    queries[i]->callback_(status, details,
+                          i + 1 == queries.size() ? std::move(responses)
+                                                  : std::list<DnsResponse>(responses));
+  }
+}
+
+ActiveDnsQuery* DnsResolverImpl::startResolution(const std::string& dns_name,
+                                                 DnsLookupFamily dns_lookup_family,
+                                                 ResolveCb callback) {
+  ENVOY_LOG_EVENT(trace, "cares_dns_resolution_start", "dns resolution for {} started", dns_name);
 
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
@@ -13,7 +13,9 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -29,7 +31,11 @@ namespace Network {
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
   COUNTER(timeouts)                                                                                \
-  COUNTER(reinits)
+  COUNTER(reinits)                                                                                 \
+  COUNTER(cache_hits)                                                                              \
+  COUNTER(cache_misses)                                                                            \
+  COUNTER(cache_coalesced)                                                                         \
+  COUNTER(cache_prefetches)
 
 /**
  * Struct definition for all DNS stats. @see stats_macros.h
@@ -60,7 +66,7 @@ public:
   // Network::DnsResolver
   ActiveDnsQuery* resolve(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
                           ResolveCb callback) override;
-  void resetNetworking() override { reinitializeChannel(); }
+  void resetNetworking() override;
 
 private:
   friend class DnsResolverImplPeer;
@@ -167,11 +173,34 @@ private:
     const AvailableInterfaces available_interfaces_;
   };
 
+  // A caller waiting for a resolution shared with other callers resolving the same name.
+  class CoalescedQuery : public ActiveDnsQuery {
+  public:
+    explicit CoalescedQuery(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+    void addTrace(uint8_t) override {}
+    std::string getTraces() override { return {}; }
+
+    const ResolveCb callback_;
+    bool cancelled_{};
+  };
+  using CoalescedQueryPtr = std::unique_ptr<CoalescedQuery>;
+
   struct AresOptions {
     ares_options options_;
     int optmask_;
   };
 
+  // Starts a c-ares resolution, bypassing the response cache.
+  ActiveDnsQuery* startResolution(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+                                  ResolveCb callback);
+  // Starts a resolution whose result is cached and handed to the callers coalesced on key.
+  ActiveDnsQuery* startCachedResolution(const DnsResponseCache::Key& key);
+  void onCachedResolution(const DnsResponseCache::Key& key, ResolutionStatus status,
+                          absl::string_view details, std::list<DnsResponse>&& responses);
+
   // Callback for events on sockets tracked in events_.
   void onEventCallback(os_fd_t fd, uint32_t events);
   // c-ares callback when a socket state changes, indicating that libevent
@@ -211,6 +240,11 @@ private:
   const bool filter_unroutable_families_;
   Stats::ScopeSharedPtr scope_;
   CaresDnsResolverStats stats_;
+  // Null if response caching is disabled.
+  std::unique_ptr<DnsResponseCache> response_cache_;
+  // Callers waiting for the cached resolution in flight for each key. A key without callers is a
+  // prefetch.
+  absl::flat_hash_map<DnsResponseCache::Key, std::vector<CoalescedQueryPtr>> in_flight_;
 };
 
 DECLARE_FACTORY(CaresDnsResolverFactory);
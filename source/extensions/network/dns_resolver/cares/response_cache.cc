@@ -0,0 +1,75 @@
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Network {
+
+DnsResponseCache::DnsResponseCache(uint32_t max_entries, std::chrono::seconds negative_ttl,
+                                   uint32_t prefetch_percent, TimeSource& time_source)
+    : max_entries_(max_entries), negative_ttl_(negative_ttl), prefetch_percent_(prefetch_percent),
+      time_source_(time_source) {}
+
+absl::optional<DnsResponseCache::Hit> DnsResponseCache::lookup(const Key& key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return absl::nullopt;
+  }
+
+  Entry& entry = *it->second;
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now >= entry.expiry_) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+
+  // Round up so that a response served just before expiry isn't handed out with a TTL of zero.
+  const auto remaining = std::chrono::ceil<std::chrono::seconds>(entry.expiry_ - now);
+  Hit hit;
+  for (const DnsResponse& response : entry.responses_) {
+    hit.responses_.emplace_back(response.addrInfo().address_, remaining);
+  }
+  if (!entry.prefetch_started_ && entry.expiry_ - now <= entry.prefetch_window_) {
+    entry.prefetch_started_ = true;
+    hit.prefetch_ = true;
+  }
+  return hit;
+}
+
+void DnsResponseCache::insert(const Key& key, const std::list<DnsResponse>& responses) {
+  std::chrono::seconds ttl = negative_ttl_;
+  if (!responses.empty()) {
+    ttl = std::chrono::seconds::max();
+    for (const DnsResponse& response : responses) {
+      ttl = std::min(ttl, response.addrInfo().ttl_);
+    }
+  }
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  if (ttl.count() <= 0) {
+    return;
+  }
+
+  if (entries_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, responses, time_source_.monotonicTime() + ttl,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(ttl) *
+                                prefetch_percent_ / 100});
+  index_.emplace(key, entries_.begin());
+}
+
+void DnsResponseCache::clear() {
+  index_.clear();
+  entries_.clear();
+}
+
+} // namespace Network
+} // namespace Envoy
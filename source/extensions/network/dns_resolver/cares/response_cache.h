@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <utility>
+
+#include "envoy/common/time.h"
+#include "envoy/network/dns.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * LRU cache of the responses of a DNS resolver, keyed by name and lookup family. Entries expire
+ * after their TTL. Not thread safe, the owning resolver only uses it on its dispatcher.
+ */
+class DnsResponseCache {
+public:
+  using Key = std::pair<std::string, DnsLookupFamily>;
+
+  struct Hit {
+    // The cached responses, with their TTLs reduced to the time left until the entry expires.
+    std::list<DnsResponse> responses_;
+    // Whether the entry is close enough to expiry that it should be refreshed. Only reported once
+    // per entry, so the caller starts at most one refresh.
+    bool prefetch_{};
+  };
+
+  DnsResponseCache(uint32_t max_entries, std::chrono::seconds negative_ttl,
+                   uint32_t prefetch_percent, TimeSource& time_source);
+
+  /**
+   * @return the cached responses for key, or nullopt if there is no unexpired entry.
+   */
+  absl::optional<Hit> lookup(const Key& key);
+
+  /**
+   * Caches the responses of a completed resolution. Positive responses are cached for the
+   * smallest of their TTLs and empty ones for the negative TTL. Responses with a TTL of zero
+   * are not cached.
+   */
+  void insert(const Key& key, const std::list<DnsResponse>& responses);
+
+  void clear();
+  size_t size() const { return entries_.size(); }
+
+private:
+  struct Entry {
+    Key key_;
+    std::list<DnsResponse> responses_;
+    MonotonicTime expiry_;
+    // The remaining time below which the entry is refreshed.
+    std::chrono::milliseconds prefetch_window_;
+    bool prefetch_started_{};
+  };
+
+  const uint32_t max_entries_;
+  const std::chrono::seconds negative_ttl_;
+  const uint32_t prefetch_percent_;
+  TimeSource& time_source_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  absl::flat_hash_map<Key, std::list<Entry>::iterator> index_;
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,301 @@
+#include "source/extensions/private_key_providers/software/software_private_key_provider.h"
+
+#include <chrono>
+#include <memory>
+
+#include "envoy/server/transport_socket_config.h"
+
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Software {
+
+SINGLETON_MANAGER_REGISTRATION(software_private_key_signing_pool);
+
+namespace {
+
+// The number of jobs a signing thread takes from the queue at once, so that a burst of handshakes
+// costs one wakeup per batch rather than per operation.
+constexpr size_t MaxSigningBatchSize = 16;
+
+bool sign(EVP_PKEY* pkey, uint16_t signature_algorithm, const std::vector<uint8_t>& in,
+          std::vector<uint8_t>& out) {
+  if (EVP_PKEY_id(pkey) != SSL_get_signature_algorithm_key_type(signature_algorithm)) {
+    return false;
+  }
+
+  // The digest is null for Ed25519, which signs the input as is.
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm);
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, pkey)) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+
+  size_t out_len = EVP_PKEY_size(pkey);
+  out.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), out.data(), &out_len, in.data(), in.size())) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+bool decrypt(EVP_PKEY* pkey, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey);
+  if (rsa == nullptr) {
+    return false;
+  }
+
+  size_t out_len = RSA_size(rsa);
+  out.resize(out_len);
+  if (!RSA_decrypt(rsa, &out_len, out.data(), out.size(), in.data(), in.size(), RSA_NO_PADDING)) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+SoftwarePrivateKeyConnection* getConnection(SSL* ssl) {
+  return ssl == nullptr ? nullptr
+                        : static_cast<SoftwarePrivateKeyConnection*>(SSL_get_ex_data(
+                              ssl, SoftwarePrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  SoftwarePrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure
+                        : ops->start(signature_algorithm, in, in_len, out, out_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t* out, size_t* out_len,
+                                           size_t max_out, const uint8_t* in, size_t in_len) {
+  SoftwarePrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure
+                        : ops->start(absl::nullopt, in, in_len, out, out_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  SoftwarePrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure : ops->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+SoftwarePrivateKeyOperation::SoftwarePrivateKeyOperation(
+    SoftwarePrivateKeyConnection& connection, bssl::UniquePtr<EVP_PKEY> pkey,
+    absl::optional<uint16_t> signature_algorithm, const uint8_t* in, size_t in_len)
+    : connection_(&connection), pkey_(std::move(pkey)), signature_algorithm_(signature_algorithm),
+      in_(in, in + in_len) {}
+
+void SoftwarePrivateKeyOperation::perform() {
+  success_ = signature_algorithm_.has_value()
+                 ? sign(pkey_.get(), signature_algorithm_.value(), in_, out_)
+                 : decrypt(pkey_.get(), in_, out_);
+}
+
+void SoftwarePrivateKeyOperation::performAndPost() {
+  perform();
+
+  // The connection is destroyed on its dispatcher before the dispatcher itself, so the dispatcher
+  // is alive for as long as the connection is attached.
+  absl::MutexLock lock(mutex_);
+  if (connection_ == nullptr) {
+    return;
+  }
+  connection_->dispatcher().post([self = shared_from_this()]() {
+    SoftwarePrivateKeyConnection* connection;
+    {
+      absl::MutexLock lock(self->mutex_);
+      connection = self->connection_;
+    }
+    if (connection != nullptr) {
+      connection->onOperationComplete();
+    }
+  });
+}
+
+void SoftwarePrivateKeyOperation::detach() {
+  absl::MutexLock lock(mutex_);
+  connection_ = nullptr;
+}
+
+SoftwarePrivateKeyConnection::SoftwarePrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                                           Event::Dispatcher& dispatcher,
+                                                           bssl::UniquePtr<EVP_PKEY> pkey,
+                                                           Thread::BoundedThreadPool& pool,
+                                                           SoftwarePrivateKeyStats& stats)
+    : cb_(cb), dispatcher_(dispatcher), pkey_(std::move(pkey)), pool_(pool), stats_(stats) {}
+
+SoftwarePrivateKeyConnection::~SoftwarePrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->detach();
+  }
+}
+
+ssl_private_key_result_t SoftwarePrivateKeyConnection::start(
+    absl::optional<uint16_t> signature_algorithm, const uint8_t* in, size_t in_len, uint8_t* out,
+    size_t* out_len, size_t max_out) {
+  if (operation_ != nullptr) {
+    // BoringSSL has at most one private key operation in flight per connection.
+    return ssl_private_key_failure;
+  }
+
+  operation_ = std::make_shared<SoftwarePrivateKeyOperation>(*this, bssl::UpRef(pkey_),
+                                                             signature_algorithm, in, in_len);
+  operation_started_ = dispatcher_.timeSource().monotonicTime();
+  operation_complete_ = false;
+  if (pool_.post([operation = operation_]() { operation->performAndPost(); })) {
+    stats_.offloaded_.inc();
+    return ssl_private_key_retry;
+  }
+
+  // The pool is saturated, so perform the operation here rather than queueing without bound.
+  ENVOY_LOG(debug, "software private key provider: signing pool full, performing inline");
+  stats_.pool_full_.inc();
+  SoftwarePrivateKeyOperationSharedPtr operation = std::move(operation_);
+  operation->perform();
+  return output(*operation, out, out_len, max_out);
+}
+
+void SoftwarePrivateKeyConnection::onOperationComplete() {
+  ASSERT(operation_ != nullptr);
+  operation_complete_ = true;
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      dispatcher_.timeSource().monotonicTime() - operation_started_);
+  stats_.offload_duration_.recordValue(duration.count());
+  cb_.onPrivateKeyMethodComplete();
+}
+
+ssl_private_key_result_t SoftwarePrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  // This can happen if the handshake is driven before the pool has performed the operation.
+  if (!operation_complete_) {
+    return ssl_private_key_retry;
+  }
+
+  SoftwarePrivateKeyOperationSharedPtr operation = std::move(operation_);
+  return output(*operation, out, out_len, max_out);
+}
+
+ssl_private_key_result_t
+SoftwarePrivateKeyConnection::output(const SoftwarePrivateKeyOperation& operation, uint8_t* out,
+                                     size_t* out_len, size_t max_out) {
+  if (!operation.success_ || operation.out_.size() > max_out) {
+    ENVOY_LOG(debug, "software private key provider: private key operation failed");
+    stats_.failed_.inc();
+    return ssl_private_key_failure;
+  }
+  memcpy(out, operation.out_.data(), operation.out_.size()); // NOLINT(safe-memcpy)
+  *out_len = operation.out_.size();
+  return ssl_private_key_success;
+}
+
+SoftwarePrivateKeyMethodProvider::SoftwarePrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::software::v3::SoftwarePrivateKeyMethodConfig&
+        config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : pool_(signingPool(factory_context.serverFactoryContext().singletonManager(),
+                        factory_context.serverFactoryContext().api().threadFactory(),
+                        PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, 1))),
+      stats_{ALL_SOFTWARE_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(factory_context.statsScope(), "software_key_provider"),
+          POOL_HISTOGRAM_PREFIX(factory_context.statsScope(), "software_key_provider"))} {
+  const std::string private_key = THROW_OR_RETURN_VALUE(
+      Config::DataSource::read(config.private_key(), false,
+                               factory_context.serverFactoryContext().api()),
+      std::string);
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(private_key.data(), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+  case EVP_PKEY_EC:
+  case EVP_PKEY_ED25519:
+    break;
+  default:
+    throw EnvoyException("Not supported key type, only RSA, EC and Ed25519 are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+}
+
+void SoftwarePrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the software provider twice for same context");
+  }
+  SSL_set_ex_data(ssl, connectionIndex(),
+                  new SoftwarePrivateKeyConnection(cb, dispatcher, bssl::UpRef(pkey_), *pool_,
+                                                   stats_));
+}
+
+void SoftwarePrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  SoftwarePrivateKeyConnection* ops =
+      static_cast<SoftwarePrivateKeyConnection*>(SSL_get_ex_data(ssl, connectionIndex()));
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool SoftwarePrivateKeyMethodProvider::checkFips() {
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA: {
+    RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa != nullptr && RSA_check_fips(rsa);
+  }
+  case EVP_PKEY_EC: {
+    const EC_KEY* ec_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+    return ec_key != nullptr && EC_KEY_check_fips(ec_key);
+  }
+  default:
+    return false;
+  }
+}
+
+Thread::BoundedThreadPoolSharedPtr
+SoftwarePrivateKeyMethodProvider::signingPool(Singleton::Manager& singleton_manager,
+                                              Thread::ThreadFactory& thread_factory,
+                                              uint32_t thread_count) {
+  return Thread::BoundedThreadPool::get(
+      singleton_manager, SINGLETON_MANAGER_REGISTERED_NAME(software_private_key_signing_pool),
+      thread_factory, "tls_sign", MaxSigningBatchSize, thread_count);
+}
+
+int SoftwarePrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace Software
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
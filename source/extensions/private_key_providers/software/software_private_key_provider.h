@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/software/v3/software.pb.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/bounded_thread_pool.h"
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Software {
+
+#define ALL_SOFTWARE_PRIVATE_KEY_STATS(COUNTER, HISTOGRAM)                                         \
+  COUNTER(failed)                                                                                  \
+  COUNTER(offloaded)                                                                               \
+  COUNTER(pool_full)                                                                               \
+  HISTOGRAM(offload_duration, Milliseconds)
+
+/**
+ * Software private key provider stats. @see stats_macros.h
+ */
+struct SoftwarePrivateKeyStats {
+  ALL_SOFTWARE_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+class SoftwarePrivateKeyConnection;
+
+/**
+ * A sign or decrypt operation, shared by the connection that started it and the pool thread
+ * performing it.
+ */
+class SoftwarePrivateKeyOperation
+    : public std::enable_shared_from_this<SoftwarePrivateKeyOperation> {
+public:
+  SoftwarePrivateKeyOperation(SoftwarePrivateKeyConnection& connection,
+                              bssl::UniquePtr<EVP_PKEY> pkey,
+                              absl::optional<uint16_t> signature_algorithm, const uint8_t* in,
+                              size_t in_len);
+
+  /**
+   * Performs the operation, storing its output in out_. Safe to call from any thread.
+   */
+  void perform();
+
+  /**
+   * Performs the operation and hands it back to the dispatcher of the connection, if the
+   * connection still exists. Called on a thread of the signing pool.
+   */
+  void performAndPost();
+
+  /**
+   * Detaches the operation from its connection, which is being destroyed.
+   */
+  void detach();
+
+  // Set by perform().
+  bool success_{};
+  std::vector<uint8_t> out_;
+
+private:
+  absl::Mutex mutex_;
+  SoftwarePrivateKeyConnection* connection_ ABSL_GUARDED_BY(mutex_);
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  // Unset for decrypt operations.
+  const absl::optional<uint16_t> signature_algorithm_;
+  const std::vector<uint8_t> in_;
+};
+
+using SoftwarePrivateKeyOperationSharedPtr = std::shared_ptr<SoftwarePrivateKeyOperation>;
+
+/**
+ * SoftwarePrivateKeyConnection holds the private key operation state of an SSL connection.
+ */
+class SoftwarePrivateKeyConnection : public Logger::Loggable<Logger::Id::connection> {
+public:
+  SoftwarePrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                               Event::Dispatcher& dispatcher, bssl::UniquePtr<EVP_PKEY> pkey,
+                               Thread::BoundedThreadPool& pool, SoftwarePrivateKeyStats& stats);
+  ~SoftwarePrivateKeyConnection();
+
+  /**
+   * Starts a sign operation, or a decrypt operation if signature_algorithm is unset.
+   */
+  ssl_private_key_result_t start(absl::optional<uint16_t> signature_algorithm, const uint8_t* in,
+                                 size_t in_len, uint8_t* out, size_t* out_len, size_t max_out);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+  /**
+   * Called on the dispatcher of the connection once the pool has performed the operation.
+   */
+  void onOperationComplete();
+
+  Event::Dispatcher& dispatcher() { return dispatcher_; }
+
+private:
+  ssl_private_key_result_t output(const SoftwarePrivateKeyOperation& operation, uint8_t* out,
+                                  size_t* out_len, size_t max_out);
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Thread::BoundedThreadPool& pool_;
+  SoftwarePrivateKeyStats& stats_;
+  SoftwarePrivateKeyOperationSharedPtr operation_;
+  MonotonicTime operation_started_;
+  bool operation_complete_{};
+};
+
+/**
+ * SoftwarePrivateKeyMethodProvider performs the private key operations of SSL connections with
+ * BoringSSL on a pool of threads.
+ */
+class SoftwarePrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                         public Logger::Loggable<Logger::Id::connection> {
+public:
+  SoftwarePrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::software::v3::SoftwarePrivateKeyMethodConfig&
+          config,
+      Server::Configuration::TransportSocketFactoryContext& private_key_provider_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+  /**
+   * @return the process wide pool performing the private key operations of all the providers,
+   *         grown to at least thread_count threads.
+   */
+  static Thread::BoundedThreadPoolSharedPtr signingPool(Singleton::Manager& singleton_manager,
+                                                        Thread::ThreadFactory& thread_factory,
+                                                        uint32_t thread_count);
+
+private:
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Thread::BoundedThreadPoolSharedPtr pool_;
+  SoftwarePrivateKeyStats stats_;
+};
+
+} // namespace Software
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
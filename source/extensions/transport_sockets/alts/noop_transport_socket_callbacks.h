@@ -28,6 +28,7 @@ public:
   void setTransportSocketIsReadable() override {}
   void raiseEvent(Network::ConnectionEvent) override {}
   void flushWriteBuffer() override {}
+  uint64_t compactBuffers() override { return parent_.compactBuffers(); }
 
 private:
   Network::TransportSocketCallbacks& parent_;
@@ -86,6 +86,7 @@ private:
       parent_->raiseEvent(event);
     }
     void flushWriteBuffer() override { parent_->flushWriteBuffer(); }
+    uint64_t compactBuffers() override { return parent_->compactBuffers(); }
 
   private:
     Network::TransportSocketCallbacks* parent_;
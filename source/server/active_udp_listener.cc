@@ -56,6 +56,7 @@ void ActiveUdpListenerBase::onData(Network::UdpRecvData&& data) {
   if (dest == worker_index_) {
     onDataWorker(std::move(data));
   } else {
+    udp_stats_.downstream_rx_datagram_forwarded_.inc();
     udp_listener_worker_router_.deliver(dest, std::move(data));
   }
 }
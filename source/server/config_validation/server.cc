@@ -60,8 +60,11 @@ ValidationInstance::ValidationInstance(
       api_(new Api::ValidationImpl(thread_factory, store, time_system, file_system,
                                    random_generator_, bootstrap_, process_context)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
-      access_log_manager_(options.fileFlushIntervalMsec(), options.fileFlushMinSizeKB(), *api_,
-                          *dispatcher_, access_log_lock, store),
+      access_log_manager_(
+          options.fileFlushIntervalMsec(), options.fileFlushMinSizeKB(),
+          options.fileFlushThreadBufferSizeKB(),
+          options.fileFlushOverflowPolicy() == Server::FileFlushOverflowPolicy::Drop, *api_,
+          *dispatcher_, access_log_lock, store),
       grpc_context_(stats_store_.symbolTable()), http_context_(stats_store_.symbolTable()),
       router_context_(stats_store_.symbolTable()), time_system_(time_system),
       server_contexts_(*this), quic_stat_names_(stats_store_.symbolTable()) {
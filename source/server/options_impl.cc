@@ -141,6 +141,15 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_min_size_kb("", "file-flush-min-size-kb",
                                                    "Minimum size in KB for log flushing", false, 64,
                                                    "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> file_flush_thread_buffer_size_kb(
+      "", "file-flush-thread-buffer-size-kb",
+      "Size in KB of the lock-free log buffer of each thread, 0 (default) to disable", false, 0,
+      "uint32_t", cmd);
+  TCLAP::ValueArg<std::string> file_flush_overflow_policy(
+      "", "file-flush-overflow-policy",
+      "What to do with log lines that do not fit in the log buffer of a thread, one of 'buffer' "
+      "(default) or 'drop'.",
+      false, "buffer", "string", cmd);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -296,6 +305,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   service_zone_ = service_zone.getValue();
   file_flush_interval_msec_ = std::chrono::milliseconds(file_flush_interval_msec.getValue());
   file_flush_min_size_kb_ = file_flush_min_size_kb.getValue();
+  file_flush_thread_buffer_size_kb_ = file_flush_thread_buffer_size_kb.getValue();
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
@@ -320,6 +330,15 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
         fmt::format("error: unknown drain-strategy '{}'", mode.getValue()));
   }
 
+  if (file_flush_overflow_policy.getValue() == "buffer") {
+    file_flush_overflow_policy_ = Server::FileFlushOverflowPolicy::Buffer;
+  } else if (file_flush_overflow_policy.getValue() == "drop") {
+    file_flush_overflow_policy_ = Server::FileFlushOverflowPolicy::Drop;
+  } else {
+    throw MalformedArgvException(fmt::format("error: unknown file-flush-overflow-policy '{}'",
+                                             file_flush_overflow_policy.getValue()));
+  }
+
   if (hot_restart_version_option.getValue()) {
     std::cerr << hot_restart_version_cb(!hot_restart_disabled_);
     throw NoServingException("NoServingException");
@@ -437,6 +456,11 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_thread_buffer_size(fileFlushThreadBufferSizeKB());
+  command_line_options->set_file_flush_overflow_policy(
+      fileFlushOverflowPolicy() == Server::FileFlushOverflowPolicy::Drop
+          ? envoy::admin::v3::CommandLineOptions::Drop
+          : envoy::admin::v3::CommandLineOptions::Buffer);
 
   command_line_options->mutable_drain_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(drainTime().count()));
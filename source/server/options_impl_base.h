@@ -73,6 +73,12 @@ public:
   void setFileFlushMinSizeKB(uint64_t file_flush_min_size_kb) {
     file_flush_min_size_kb_ = file_flush_min_size_kb;
   }
+  void setFileFlushThreadBufferSizeKB(uint64_t file_flush_thread_buffer_size_kb) {
+    file_flush_thread_buffer_size_kb_ = file_flush_thread_buffer_size_kb;
+  }
+  void setFileFlushOverflowPolicy(Server::FileFlushOverflowPolicy file_flush_overflow_policy) {
+    file_flush_overflow_policy_ = file_flush_overflow_policy;
+  }
   void setServiceClusterName(const std::string& service_cluster) {
     service_cluster_ = service_cluster;
   }
@@ -144,6 +150,12 @@ public:
     return file_flush_interval_msec_;
   }
   uint64_t fileFlushMinSizeKB() const override { return file_flush_min_size_kb_; }
+  uint64_t fileFlushThreadBufferSizeKB() const override {
+    return file_flush_thread_buffer_size_kb_;
+  }
+  Server::FileFlushOverflowPolicy fileFlushOverflowPolicy() const override {
+    return file_flush_overflow_policy_;
+  }
   const std::string& serviceClusterName() const override { return service_cluster_; }
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
@@ -209,6 +221,9 @@ private:
   std::string service_zone_;
   std::chrono::milliseconds file_flush_interval_msec_{10000};
   uint64_t file_flush_min_size_kb_{64};
+  uint64_t file_flush_thread_buffer_size_kb_{0};
+  Server::FileFlushOverflowPolicy file_flush_overflow_policy_{
+      Server::FileFlushOverflowPolicy::Buffer};
   std::chrono::seconds drain_time_{600};
   std::chrono::seconds parent_shutdown_time_{900};
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
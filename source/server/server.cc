@@ -96,8 +96,11 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           process_context ? ProcessContextOptRef(std::ref(*process_context)) : absl::nullopt,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
-      access_log_manager_(options.fileFlushIntervalMsec(), options.fileFlushMinSizeKB(), *api_,
-                          *dispatcher_, access_log_lock, store),
+      access_log_manager_(
+          options.fileFlushIntervalMsec(), options.fileFlushMinSizeKB(),
+          options.fileFlushThreadBufferSizeKB(),
+          options.fileFlushOverflowPolicy() == Server::FileFlushOverflowPolicy::Drop, *api_,
+          *dispatcher_, access_log_lock, store),
       handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
@@ -32,7 +32,8 @@ class AccessLogManagerImplTest : public testing::Test {
 protected:
   AccessLogManagerImplTest()
       : file_(new NiceMock<Filesystem::MockFile>), thread_factory_(Thread::threadFactoryForTest()),
-        access_log_manager_(timeout_40ms_, flush_size_kb_, api_, dispatcher_, lock_, store_) {
+        access_log_manager_(timeout_40ms_, flush_size_kb_, 0, false, api_, dispatcher_, lock_,
+                            store_) {
     EXPECT_CALL(file_system_,
                 createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
                     Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})))
@@ -446,6 +447,126 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, ThreadBufferFlushedOnDemand) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, flush_size_kb_, 1, false, api_,
+                                          dispatcher_, lock_, store_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // Writes below the flush threshold stay in the thread buffer until flushed.
+  log_file->write("test");
+  log_file->write("test2");
+  {
+    absl::MutexLock lock(file_->mutex_);
+    EXPECT_EQ(0, file_->num_writes_);
+  }
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(
+            9UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+        EXPECT_EQ(0, data.compare("testtest2"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->flush();
+
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_completed").value());
+  EXPECT_EQ(0UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, ThreadBufferFlushedAtThreshold) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, flush_size_kb_, 1, false, api_,
+                                          dispatcher_, lock_, store_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // The flush thread is woken up once the thread buffer is half full, without the timer.
+  const std::string data(512, 'a');
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&](absl::string_view written) -> Api::IoCallSizeResult {
+        EXPECT_EQ(data, written);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(written.length()));
+      }));
+  log_file->write(data);
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, ThreadBufferOverflowBuffered) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, flush_size_kb_, 1, false, api_,
+                                          dispatcher_, lock_, store_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  // Data that does not fit goes to the shared buffer, and so does everything the thread writes
+  // after it until the next flush, which keeps the data in order.
+  const std::string big(2048, 'b');
+  log_file->write("first");
+  log_file->write(big);
+  log_file->write("second");
+  log_file->flush();
+  EXPECT_EQ(absl::StrCat("first", big, "second"), written);
+
+  written.clear();
+  log_file->write("third");
+  log_file->flush();
+  EXPECT_EQ("third", written);
+
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(4UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, ThreadBufferOverflowDropped) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, flush_size_kb_, 1, true, api_,
+                                          dispatcher_, lock_, store_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("first");
+  log_file->write(std::string(2048, 'b'));
+  log_file->write("second");
+  log_file->flush();
+  EXPECT_EQ("firstsecond", written);
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -293,6 +293,34 @@ TEST_F(OwnedImplTest, PrependBuffer) {
   EXPECT_EQ(0, prefixBuffer.length());
 }
 
+TEST_F(OwnedImplTest, ShrinkToFit) {
+  Buffer::OwnedImpl buffer;
+  EXPECT_EQ(0, buffer.shrinkToFit());
+
+  // More slices than fit in the inline ring.
+  for (int i = 0; i < 20; i++) {
+    buffer.appendSliceForTest("abcde");
+  }
+  // The remaining slices do not fit in the inline ring yet.
+  buffer.drain(10 * 5);
+  EXPECT_EQ(0, buffer.shrinkToFit());
+
+  buffer.drain(8 * 5);
+  EXPECT_GT(buffer.shrinkToFit(), 0);
+  EXPECT_EQ(0, buffer.shrinkToFit());
+  EXPECT_EQ("abcdeabcde", buffer.toString());
+  EXPECT_EQ(2, buffer.getRawSlices().size());
+
+  // The inline ring grows again when needed.
+  for (int i = 0; i < 20; i++) {
+    buffer.appendSliceForTest("12345");
+  }
+  EXPECT_EQ(110, buffer.length());
+  buffer.drain(buffer.length());
+  EXPECT_GT(buffer.shrinkToFit(), 0);
+  EXPECT_EQ(0, buffer.length());
+}
+
 TEST_F(OwnedImplTest, ExtractOwnedSlice) {
   // Create a buffer with two owned slices.
   Buffer::OwnedImpl buffer;
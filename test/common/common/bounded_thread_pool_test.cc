@@ -0,0 +1,69 @@
+#include <atomic>
+
+#include "source/common/common/bounded_thread_pool.h"
+#include "source/common/singleton/manager_impl.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Thread {
+namespace {
+
+SINGLETON_MANAGER_REGISTRATION(test_bounded_thread_pool);
+
+// Tests that the pool refuses jobs once its queue is full, and runs every queued job before it is
+// destroyed.
+TEST(BoundedThreadPoolTest, QueueIsBounded) {
+  std::atomic<size_t> completed{0};
+  absl::Notification started;
+  absl::Notification release;
+  {
+    BoundedThreadPool pool(threadFactoryForTest(), "test_pool", 4);
+    pool.grow(1);
+    ASSERT_TRUE(pool.post([&]() {
+      started.Notify();
+      release.WaitForNotification();
+      ++completed;
+    }));
+    // The only thread is busy, so every further job stays queued.
+    started.WaitForNotification();
+    for (size_t i = 0; i < BoundedThreadPool::MaxQueuedJobsPerThread; ++i) {
+      EXPECT_TRUE(pool.post([&completed]() { ++completed; }));
+    }
+    EXPECT_FALSE(pool.post([&completed]() { ++completed; }));
+    release.Notify();
+  }
+  EXPECT_EQ(BoundedThreadPool::MaxQueuedJobsPerThread + 1, completed);
+}
+
+// Tests that get() shares one pool per singleton name, and only ever grows it.
+TEST(BoundedThreadPoolTest, GetSharesPool) {
+  Singleton::ManagerImpl singleton_manager;
+  const auto get = [&singleton_manager](uint32_t thread_count) {
+    return BoundedThreadPool::get(singleton_manager,
+                                  SINGLETON_MANAGER_REGISTERED_NAME(test_bounded_thread_pool),
+                                  threadFactoryForTest(), "test_pool", 1, thread_count);
+  };
+  BoundedThreadPoolSharedPtr pool = get(2);
+  EXPECT_EQ(pool, get(1));
+
+  // Two blocking jobs only both start if the pool kept its second thread.
+  absl::BlockingCounter started(2);
+  absl::Notification release;
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(pool->post([&]() {
+      started.DecrementCount();
+      release.WaitForNotification();
+    }));
+  }
+  started.Wait();
+  release.Notify();
+}
+
+} // namespace
+} // namespace Thread
+} // namespace Envoy
@@ -14,6 +14,7 @@
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/json/json_utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/string_accessor_impl.h"
@@ -72,6 +73,14 @@ public:
                               const StreamInfo::StreamInfo& stream_info) const override {
     return formatter_->formatValue(context, stream_info);
   }
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    return formatter_->formatTo(context, stream_info, output);
+  }
+  bool formatJsonTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                    std::string& output) const override {
+    return formatter_->formatJsonTo(context, stream_info, output);
+  }
 
 private:
   FormatterProviderPtr formatter_;
@@ -250,6 +259,15 @@ TEST(SubstitutionFormatterTest, plainStringFormatter) {
 
   EXPECT_EQ("plain", formatter.format({}, stream_info));
   EXPECT_THAT(formatter.formatValue({}, stream_info), ProtoEq(ValueUtil::stringValue("plain")));
+
+  std::string output = "prefix:";
+  EXPECT_TRUE(formatter.formatTo({}, stream_info, output));
+  EXPECT_EQ("prefix:plain", output);
+
+  PlainStringFormatter quoted("a \"b\"");
+  output.clear();
+  EXPECT_TRUE(quoted.formatJsonTo({}, stream_info, output));
+  EXPECT_EQ("\"a \\\"b\\\"\"", output);
 }
 
 TEST(SubstitutionFormatterTest, plainNumberFormatter) {
@@ -258,6 +276,55 @@ TEST(SubstitutionFormatterTest, plainNumberFormatter) {
 
   EXPECT_EQ("400", formatter.format({}, stream_info));
   EXPECT_THAT(formatter.formatValue({}, stream_info), ProtoEq(ValueUtil::numberValue(400)));
+
+  std::string output;
+  EXPECT_TRUE(formatter.formatTo({}, stream_info, output));
+  EXPECT_EQ("400", output);
+  output.clear();
+  EXPECT_TRUE(formatter.formatJsonTo({}, stream_info, output));
+  EXPECT_EQ("400", output);
+}
+
+// The direct writes of the built-in providers must produce the same output as format() and the
+// JSON serialization of formatValue().
+TEST(SubstitutionFormatterTest, directWrites) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"},
+                                                {"x-quoted", "say \"hi\""}};
+  Context formatter_context;
+  formatter_context.setRequestHeaders(request_header);
+
+  stream_info.protocol_ = Http::Protocol::Http11;
+  stream_info.bytes_received_ = 1234;
+  EXPECT_CALL(stream_info, currentDuration())
+      .WillRepeatedly(Return(std::chrono::nanoseconds(5000000)));
+
+  std::vector<std::unique_ptr<FormatterProvider>> providers;
+  providers.push_back(std::make_unique<StreamInfoFormatter>("PROTOCOL"));
+  providers.push_back(std::make_unique<StreamInfoFormatter>("BYTES_RECEIVED"));
+  providers.push_back(std::make_unique<StreamInfoFormatter>("DURATION"));
+  providers.push_back(std::make_unique<StreamInfoFormatter>("REQUEST_DURATION"));
+  providers.push_back(std::make_unique<StreamInfoFormatter>("UPSTREAM_TRANSPORT_FAILURE_REASON"));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>(":method", "", absl::nullopt));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>(":method", "", 2));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>("x-quoted", "", absl::nullopt));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>("missing", "", absl::nullopt));
+  providers.push_back(std::make_unique<ResponseHeaderFormatter>("missing", "", absl::nullopt));
+  providers.push_back(std::make_unique<ResponseTrailerFormatter>("missing", "", absl::nullopt));
+
+  for (const auto& provider : providers) {
+    const absl::optional<std::string> expected = provider->format(formatter_context, stream_info);
+    std::string output = "prefix";
+    EXPECT_EQ(expected.has_value(), provider->formatTo(formatter_context, stream_info, output));
+    EXPECT_EQ(absl::StrCat("prefix", expected.value_or("")), output);
+
+    std::string expected_json;
+    Json::Utility::appendValueToString(provider->formatValue(formatter_context, stream_info),
+                                       expected_json);
+    output.clear();
+    EXPECT_TRUE(provider->formatJsonTo(formatter_context, stream_info, output));
+    EXPECT_EQ(expected_json, output);
+  }
 }
 
 TEST(SubstitutionFormatterTest, inFlightDuration) {
@@ -0,0 +1,354 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Drives the server side HTTP/1 and HTTP/2 codecs with pre-serialized request byte streams and
+// lightweight (non-gmock) stream callbacks, so that the numbers reflect the codec hot paths rather
+// than the mocks. Each benchmark iteration creates a new server connection and dispatches
+// kRequestsPerConnection requests through it, encoding a small response for every request.
+// Allocations per request are only reported when built with --define tcmalloc=gperftools.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/http/codec.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/random_generator.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/http/http1/codec_impl.h"
+#include "source/common/http/http2/codec_impl.h"
+#include "source/common/http/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/common/memory/allocation_counter.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+constexpr uint32_t kRequestsPerConnection = 100;
+constexpr uint64_t kResponseBodySize = 128;
+
+RequestHeaderMapPtr makeRequestHeaders(bool has_body) {
+  auto headers = RequestHeaderMapImpl::create();
+  headers->setReferenceMethod(has_body ? Headers::get().MethodValues.Post
+                                       : Headers::get().MethodValues.Get);
+  headers->setPath("/api/v1/items/12345?include=details&format=json");
+  headers->setHost("api.example.com");
+  headers->setScheme("https");
+  headers->addCopy(LowerCaseString("user-agent"), "Mozilla/5.0 (X11; Linux x86_64) benchmark/1.0");
+  headers->addCopy(LowerCaseString("accept"), "application/json, text/plain, */*");
+  headers->addCopy(LowerCaseString("accept-encoding"), "gzip, deflate, br");
+  headers->addCopy(LowerCaseString("accept-language"), "en-US,en;q=0.9");
+  headers->addCopy(LowerCaseString("cookie"), "session=0123456789abcdef0123456789abcdef");
+  headers->addCopy(LowerCaseString("x-request-id"), "4b8f2a70-6f3e-4c83-9f4e-1a2b3c4d5e6f");
+  return headers;
+}
+
+/**
+ * Server connection callbacks and request decoder shared by all streams of a connection. Streams
+ * are decoded one at a time, so the response encoder of the latest stream is the one to reply on.
+ */
+class BenchmarkServerCallbacks : public ServerConnectionCallbacks, public RequestDecoder {
+public:
+  BenchmarkServerCallbacks() : response_body_(kResponseBodySize, 'a') {
+    response_headers_.setStatus(200);
+    response_headers_.setContentType("application/json");
+    response_headers_.setContentLength(kResponseBodySize);
+  }
+
+  // Http::ConnectionCallbacks
+  void onGoAway(GoAwayErrorCode) override {}
+
+  // Http::ServerConnectionCallbacks
+  RequestDecoder& newStream(ResponseEncoder& response_encoder, bool) override {
+    response_encoder_ = &response_encoder;
+    return *this;
+  }
+
+  // Http::StreamDecoder
+  void decodeData(Buffer::Instance& data, bool end_stream) override {
+    request_body_bytes_ += data.length();
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeMetadata(MetadataMapPtr&&) override {}
+
+  // Http::RequestDecoder
+  void decodeHeaders(RequestHeaderMapSharedPtr&& headers, bool end_stream) override {
+    benchmark::DoNotOptimize(headers->getPathValue());
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeTrailers(RequestTrailerMapPtr&&) override { respond(); }
+  void sendLocalReply(Code, absl::string_view, const std::function<void(ResponseHeaderMap&)>&,
+                      const absl::optional<Grpc::Status::GrpcStatus>, absl::string_view) override {}
+  StreamInfo::StreamInfo& streamInfo() override { return stream_info_; }
+  AccessLog::InstanceSharedPtrVector accessLogHandlers() override { return {}; }
+  RequestDecoderHandlePtr getRequestDecoderHandle() override {
+    return std::make_unique<Handle>(*this);
+  }
+
+  uint64_t responses_{};
+  uint64_t request_body_bytes_{};
+
+private:
+  class Handle : public RequestDecoderHandle {
+  public:
+    explicit Handle(RequestDecoder& decoder) : decoder_(decoder) {}
+    OptRef<RequestDecoder> get() override { return decoder_; }
+
+  private:
+    RequestDecoder& decoder_;
+  };
+
+  void respond() {
+    ASSERT(response_encoder_ != nullptr);
+    response_encoder_->encodeHeaders(response_headers_, false);
+    Buffer::OwnedImpl body(response_body_);
+    response_encoder_->encodeData(body, true);
+    response_encoder_ = nullptr;
+    ++responses_;
+  }
+
+  TestResponseHeaderMapImpl response_headers_;
+  const std::string response_body_;
+  ResponseEncoder* response_encoder_{};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+};
+
+/**
+ * Network connection whose writes are drained and accounted for, standing in for the socket.
+ */
+class BenchmarkConnection {
+public:
+  BenchmarkConnection() {
+    ON_CALL(connection_, write(_, _)).WillByDefault(Invoke([this](Buffer::Instance& data, bool) {
+      bytes_written_ += data.length();
+      data.drain(data.length());
+    }));
+  }
+
+  void clearDeferredDeleteList() { connection_.dispatcher_.to_delete_.clear(); }
+
+  NiceMock<Network::MockConnection> connection_;
+  uint64_t bytes_written_{};
+};
+
+void reportCounters(benchmark::State& state, uint64_t requests, uint64_t bytes_read,
+                    uint64_t bytes_written, uint64_t allocations) {
+  state.SetItemsProcessed(requests);
+  state.SetBytesProcessed(bytes_read);
+  state.counters["ns_per_request"] = benchmark::Counter(
+      requests / 1e9, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["bytes_read_per_request"] =
+      benchmark::Counter(requests == 0 ? 0 : static_cast<double>(bytes_read) / requests);
+  state.counters["bytes_written_per_request"] =
+      benchmark::Counter(requests == 0 ? 0 : static_cast<double>(bytes_written) / requests);
+  if (Memory::TestUtil::AllocationCounter::enabled()) {
+    state.counters["allocations_per_request"] =
+        benchmark::Counter(requests == 0 ? 0 : static_cast<double>(allocations) / requests);
+  }
+}
+
+std::string http1Request(uint64_t body_size) {
+  std::string request;
+  RequestHeaderMapPtr headers = makeRequestHeaders(body_size > 0);
+  absl::StrAppend(&request, headers->getMethodValue(), " ", headers->getPathValue(),
+                  " HTTP/1.1\r\n");
+  absl::StrAppend(&request, "host: ", headers->getHostValue(), "\r\n");
+  headers->iterate([&request](const HeaderEntry& header) -> HeaderMap::Iterate {
+    if (header.key().getStringView()[0] != ':') {
+      absl::StrAppend(&request, header.key().getStringView(), ": ",
+                      header.value().getStringView(), "\r\n");
+    }
+    return HeaderMap::Iterate::Continue;
+  });
+  if (body_size > 0) {
+    absl::StrAppend(&request, "content-length: ", body_size, "\r\n");
+  }
+  absl::StrAppend(&request, "\r\n", std::string(body_size, 'b'));
+  return request;
+}
+
+// Measures HTTP/1 server request parsing and response serialization. The Arg is the request body
+// size, 0 meaning a GET without a body.
+void http1ServerCodec(benchmark::State& state) {
+  const uint64_t body_size = state.range(0);
+  std::string input;
+  for (uint32_t i = 0; i < kRequestsPerConnection; ++i) {
+    absl::StrAppend(&input, http1Request(body_size));
+  }
+
+  Stats::IsolatedStoreImpl stats_store;
+  Http1::CodecStats::AtomicPtr http1_stats;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  Http1Settings settings;
+  uint64_t requests = 0;
+  uint64_t bytes_read = 0;
+  uint64_t bytes_written = 0;
+  uint64_t allocations = 0;
+
+  for (auto _ : state) { // NOLINT
+    BenchmarkConnection connection;
+    BenchmarkServerCallbacks callbacks;
+    Buffer::OwnedImpl data(input);
+    Memory::TestUtil::AllocationCounter allocation_counter;
+    auto codec = std::make_unique<Http1::ServerConnectionImpl>(
+        connection.connection_, Http1::CodecStats::atomicGet(http1_stats, *stats_store.rootScope()),
+        callbacks, settings, DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+        envoy::config::core::v3::HttpProtocolOptions::ALLOW, overload_manager);
+
+    // The HTTP/1 codec pauses after each request, so pipelined requests need one dispatch each.
+    while (data.length() > 0) {
+      const Status status = codec->dispatch(data);
+      if (!status.ok()) {
+        state.SkipWithError(std::string(status.message()).c_str());
+        break;
+      }
+    }
+    codec.reset();
+    connection.clearDeferredDeleteList();
+
+    requests += callbacks.responses_;
+    bytes_read += input.size();
+    bytes_written += connection.bytes_written_;
+    allocations += allocation_counter.allocations();
+  }
+  reportCounters(state, requests, bytes_read, bytes_written, allocations);
+}
+BENCHMARK(http1ServerCodec)->Arg(0)->Arg(1024)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Records the bytes an HTTP/2 client sends for kRequestsPerConnection requests, while running the
+ * exchange against a live server so that SETTINGS and flow control windows evolve exactly as they
+ * will when the recording is replayed into a fresh server connection.
+ */
+std::string recordHttp2Requests(uint64_t body_size) {
+  Stats::IsolatedStoreImpl stats_store;
+  Http2::CodecStats::AtomicPtr client_stats;
+  Http2::CodecStats::AtomicPtr server_stats;
+  Random::RandomGeneratorImpl random;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  NiceMock<MockConnectionCallbacks> client_callbacks;
+  NiceMock<MockResponseDecoder> response_decoder;
+  envoy::config::core::v3::Http2ProtocolOptions http2_options =
+      ::Envoy::Http2::Utility::initializeAndValidateOptions(
+          envoy::config::core::v3::Http2ProtocolOptions())
+          .value();
+
+  NiceMock<Network::MockConnection> client_connection;
+  NiceMock<Network::MockConnection> server_connection;
+  std::string recording;
+  Buffer::OwnedImpl to_server;
+  Buffer::OwnedImpl to_client;
+  ON_CALL(client_connection, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) {
+        recording.append(data.toString());
+        to_server.move(data);
+      }));
+  ON_CALL(server_connection, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) { to_client.move(data); }));
+
+  BenchmarkServerCallbacks server_callbacks;
+  Http2::ClientConnectionImpl client(
+      client_connection, client_callbacks,
+      Http2::CodecStats::atomicGet(client_stats, *stats_store.rootScope()), random, http2_options,
+      DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+      Http2::ProdNghttp2SessionFactory::get());
+  Http2::ServerConnectionImpl server(
+      server_connection, server_callbacks,
+      Http2::CodecStats::atomicGet(server_stats, *stats_store.rootScope()), random, http2_options,
+      DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+      envoy::config::core::v3::HttpProtocolOptions::ALLOW, overload_manager);
+
+  auto drive = [&]() {
+    while (to_server.length() > 0 || to_client.length() > 0) {
+      if (to_server.length() > 0) {
+        RELEASE_ASSERT(server.dispatch(to_server).ok(), "");
+      }
+      if (to_client.length() > 0) {
+        RELEASE_ASSERT(client.dispatch(to_client).ok(), "");
+      }
+    }
+  };
+
+  RequestHeaderMapPtr headers = makeRequestHeaders(body_size > 0);
+  for (uint32_t i = 0; i < kRequestsPerConnection; ++i) {
+    RequestEncoder& encoder = client.newStream(response_decoder);
+    RELEASE_ASSERT(encoder.encodeHeaders(*headers, body_size == 0).ok(), "");
+    if (body_size > 0) {
+      Buffer::OwnedImpl body(std::string(body_size, 'b'));
+      encoder.encodeData(body, true);
+    }
+    drive();
+  }
+  client_connection.dispatcher_.to_delete_.clear();
+  server_connection.dispatcher_.to_delete_.clear();
+  return recording;
+}
+
+// Measures HTTP/2 server request decoding (including HPACK) and response encoding. The Arg is
+// the request body size, 0 meaning a GET without a body.
+void http2ServerCodec(benchmark::State& state) {
+  const uint64_t body_size = state.range(0);
+  const std::string input = recordHttp2Requests(body_size);
+
+  Stats::IsolatedStoreImpl stats_store;
+  Http2::CodecStats::AtomicPtr http2_stats;
+  Random::RandomGeneratorImpl random;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  envoy::config::core::v3::Http2ProtocolOptions http2_options =
+      ::Envoy::Http2::Utility::initializeAndValidateOptions(
+          envoy::config::core::v3::Http2ProtocolOptions())
+          .value();
+  uint64_t requests = 0;
+  uint64_t bytes_read = 0;
+  uint64_t bytes_written = 0;
+  uint64_t allocations = 0;
+
+  for (auto _ : state) { // NOLINT
+    BenchmarkConnection connection;
+    BenchmarkServerCallbacks callbacks;
+    Buffer::OwnedImpl data(input);
+    Memory::TestUtil::AllocationCounter allocation_counter;
+    auto codec = std::make_unique<Http2::ServerConnectionImpl>(
+        connection.connection_, callbacks,
+        Http2::CodecStats::atomicGet(http2_stats, *stats_store.rootScope()), random,
+        http2_options, DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+        envoy::config::core::v3::HttpProtocolOptions::ALLOW, overload_manager);
+
+    const Status status = codec->dispatch(data);
+    if (!status.ok()) {
+      state.SkipWithError(std::string(status.message()).c_str());
+    }
+    codec.reset();
+    connection.clearDeferredDeleteList();
+
+    requests += callbacks.responses_;
+    bytes_read += input.size();
+    bytes_written += connection.bytes_written_;
+    allocations += allocation_counter.allocations();
+  }
+  reportCounters(state, requests, bytes_read, bytes_written, allocations);
+}
+BENCHMARK(http2ServerCodec)->Arg(0)->Arg(1024)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
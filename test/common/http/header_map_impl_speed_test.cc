@@ -1,6 +1,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
+#include "test/common/memory/allocation_counter.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -19,14 +20,28 @@ static void addDummyHeaders(HeaderMap& headers, size_t num_headers,
   }
 }
 
+/**
+ * Report the average number of heap allocations per benchmark iteration, when allocation counting
+ * is supported by the malloc library in use.
+ */
+static void reportAllocations(benchmark::State& state,
+                              const Memory::TestUtil::AllocationCounter& counter) {
+  if (Memory::TestUtil::AllocationCounter::enabled()) {
+    state.counters["allocations"] =
+        benchmark::Counter(counter.allocations(), benchmark::Counter::kAvgIterations);
+  }
+}
+
 /** Measure the construction/destruction speed of RequestHeaderMapImpl.*/
 static void headerMapImplCreate(benchmark::State& state) {
   // Make sure first time construction is not counted.
   Http::ResponseHeaderMapImpl::create();
+  Memory::TestUtil::AllocationCounter allocation_counter;
   for (auto _ : state) { // NOLINT
     auto headers = Http::ResponseHeaderMapImpl::create();
     benchmark::DoNotOptimize(headers->size());
   }
+  reportAllocations(state, allocation_counter);
 }
 BENCHMARK(headerMapImplCreate);
 
@@ -42,9 +57,11 @@ static void headerMapImplSetReference(benchmark::State& state) {
   const std::string value("01234567890123456789");
   auto headers = Http::ResponseHeaderMapImpl::create();
   addDummyHeaders(*headers, state.range(0));
+  Memory::TestUtil::AllocationCounter allocation_counter;
   for (auto _ : state) { // NOLINT
     headers->setReference(key, value);
   }
+  reportAllocations(state, allocation_counter);
   benchmark::DoNotOptimize(headers->size());
 }
 BENCHMARK(headerMapImplSetReference)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
@@ -200,6 +217,7 @@ static void headerMapImplPopulate(benchmark::State& state) {
       {LowerCaseString("set-cookie"), "_cookie1=12345678; path = /; secure"},
       {LowerCaseString("set-cookie"), "_cookie2=12345678; path = /; secure"},
   };
+  Memory::TestUtil::AllocationCounter allocation_counter;
   for (auto _ : state) { // NOLINT
     auto headers = Http::ResponseHeaderMapImpl::create();
     for (const auto& key_value : headers_to_add) {
@@ -207,6 +225,7 @@ static void headerMapImplPopulate(benchmark::State& state) {
     }
     benchmark::DoNotOptimize(headers->size());
   }
+  reportAllocations(state, allocation_counter);
 }
 BENCHMARK(headerMapImplPopulate);
 
@@ -7,6 +7,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/header_utility.h"
 
+#include "test/common/memory/allocation_counter.h"
 #include "test/test_common/printers.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
@@ -134,6 +135,19 @@ TEST(HeaderMapImplTest, InlineInsert) {
   EXPECT_EQ("hello", headers.get(Headers::get().Host)[0]->value().getStringView());
 }
 
+// Overwriting an existing inline header by reference is on the hot path of every codec and must
+// not touch the heap.
+TEST(HeaderMapImplTest, InlineSetReferenceOverwriteDoesNotAllocate) {
+  const std::string value("01234567890123456789");
+  auto headers = ResponseHeaderMapImpl::create();
+  headers->setReferenceConnection(value);
+
+  Memory::TestUtil::AllocationCounter allocation_counter;
+  headers->setReferenceConnection(value);
+  EXPECT_ALLOCATIONS_LE(allocation_counter.allocations(), 0);
+  EXPECT_EQ(value, headers->getConnectionValue());
+}
+
 TEST(HeaderMapImplTest, InlineAppend) {
   {
     TestRequestHeaderMapImpl headers;
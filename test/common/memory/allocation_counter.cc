@@ -0,0 +1,74 @@
+#include "test/common/memory/allocation_counter.h"
+
+#include "source/common/common/assert.h"
+
+#include "absl/base/call_once.h"
+
+#if defined(GPERFTOOLS_TCMALLOC) && !defined(ENVOY_MEMORY_DEBUG_ENABLED)
+#include "gperftools/malloc_hook.h"
+#define ENVOY_ALLOCATION_COUNTER_ENABLED
+#endif
+
+namespace Envoy {
+namespace Memory {
+namespace TestUtil {
+
+namespace {
+// The innermost live counter on this thread. This is a plain pointer so that reading it from
+// within the malloc hooks never allocates.
+thread_local AllocationCounter* current_counter = nullptr;
+} // namespace
+
+struct AllocationCounterHooks {
+  static void onNew(const void*, size_t size) {
+    AllocationCounter* counter = current_counter;
+    if (counter != nullptr) {
+      ++counter->allocations_;
+      counter->allocated_bytes_ += size;
+    }
+  }
+
+  static void onDelete(const void* ptr) {
+    AllocationCounter* counter = current_counter;
+    if (counter != nullptr && ptr != nullptr) {
+      ++counter->deallocations_;
+    }
+  }
+
+  static void install() {
+#ifdef ENVOY_ALLOCATION_COUNTER_ENABLED
+    static absl::once_flag once;
+    absl::call_once(once, []() {
+      MallocHook::AddNewHook(&AllocationCounterHooks::onNew);
+      MallocHook::AddDeleteHook(&AllocationCounterHooks::onDelete);
+    });
+#endif
+  }
+};
+
+AllocationCounter::AllocationCounter() : parent_(current_counter) {
+  AllocationCounterHooks::install();
+  current_counter = this;
+}
+
+AllocationCounter::~AllocationCounter() {
+  ASSERT(current_counter == this, "AllocationCounter objects must be destroyed in LIFO order");
+  current_counter = parent_;
+  if (parent_ != nullptr) {
+    parent_->allocations_ += allocations_;
+    parent_->deallocations_ += deallocations_;
+    parent_->allocated_bytes_ += allocated_bytes_;
+  }
+}
+
+bool AllocationCounter::enabled() {
+#ifdef ENVOY_ALLOCATION_COUNTER_ENABLED
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace TestUtil
+} // namespace Memory
+} // namespace Envoy
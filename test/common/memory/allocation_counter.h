@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Memory {
+namespace TestUtil {
+
+// Counts heap allocations made by the current thread while the object is in scope, so that tests
+// and benchmarks can attribute allocations to a region of code rather than relying on process
+// wide totals from Memory::Stats. Counting is implemented with gperftools tcmalloc malloc hooks
+// and is only available when Envoy is built with --define tcmalloc=gperftools; on other builds
+// enabled() returns false and all counts remain zero.
+//
+// Counters may be nested. Allocations are attributed to the innermost counter while it is live and
+// are folded into the enclosing counter when the inner one is destroyed.
+//
+//   AllocationCounter counter;
+//   doSomething();
+//   EXPECT_ALLOCATIONS_LE(counter.allocations(), 2);
+class AllocationCounter {
+public:
+  AllocationCounter();
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+  /**
+   * @return whether allocations can be counted with the current malloc library.
+   */
+  static bool enabled();
+
+  /**
+   * @return the number of allocations made on this thread since construction or the last reset().
+   */
+  uint64_t allocations() const { return allocations_; }
+
+  /**
+   * @return the number of deallocations made on this thread since construction or the last
+   *         reset().
+   */
+  uint64_t deallocations() const { return deallocations_; }
+
+  /**
+   * @return the number of bytes requested by the counted allocations.
+   */
+  uint64_t allocatedBytes() const { return allocated_bytes_; }
+
+  /**
+   * Zeroes the counts. Counts accumulated before the reset are not propagated to an enclosing
+   * counter.
+   */
+  void reset() { allocations_ = deallocations_ = allocated_bytes_ = 0; }
+
+private:
+  friend struct AllocationCounterHooks;
+
+  AllocationCounter* const parent_;
+  uint64_t allocations_{};
+  uint64_t deallocations_{};
+  uint64_t allocated_bytes_{};
+};
+
+// Checks the number of allocations counted against an upper bound, but only when allocation
+// counting is supported. On other platforms an info log is emitted, indicating that the check is
+// being skipped.
+#define EXPECT_ALLOCATIONS_LE(allocations, upper_bound)                                            \
+  do {                                                                                             \
+    if (::Envoy::Memory::TestUtil::AllocationCounter::enabled()) {                                 \
+      EXPECT_LE(allocations, upper_bound);                                                         \
+    } else {                                                                                       \
+      ENVOY_LOG_MISC(info,                                                                         \
+                     "Skipping allocation test of actual={} versus upper bound={} as allocation "  \
+                     "counting is not supported by this malloc library",                           \
+                     allocations, upper_bound);                                                    \
+    }                                                                                              \
+  } while (false)
+
+} // namespace TestUtil
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,75 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test/common/memory/allocation_counter.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace TestUtil {
+namespace {
+
+// Keeps the compiler from eliding the allocations under test.
+template <class T> void escape(T& value) { asm volatile("" : : "g"(&value) : "memory"); }
+
+TEST(AllocationCounterTest, CountsAllocationsInScope) {
+  AllocationCounter counter;
+  {
+    auto value = std::make_unique<uint64_t>(42);
+    escape(value);
+  }
+  if (!AllocationCounter::enabled()) {
+    EXPECT_EQ(0, counter.allocations());
+    EXPECT_EQ(0, counter.deallocations());
+    EXPECT_EQ(0, counter.allocatedBytes());
+    return;
+  }
+  EXPECT_EQ(1, counter.allocations());
+  EXPECT_EQ(1, counter.deallocations());
+  EXPECT_GE(counter.allocatedBytes(), sizeof(uint64_t));
+}
+
+TEST(AllocationCounterTest, Reset) {
+  AllocationCounter counter;
+  std::vector<int> values(100);
+  escape(values);
+  counter.reset();
+  EXPECT_EQ(0, counter.allocations());
+  EXPECT_EQ(0, counter.allocatedBytes());
+}
+
+TEST(AllocationCounterTest, NestedCountersPropagateToParent) {
+  AllocationCounter outer;
+  {
+    AllocationCounter inner;
+    std::string value(64, 'a');
+    escape(value);
+    EXPECT_ALLOCATIONS_LE(inner.allocations(), 1);
+    EXPECT_EQ(0, outer.allocations());
+  }
+  if (AllocationCounter::enabled()) {
+    EXPECT_EQ(1, outer.allocations());
+    EXPECT_EQ(1, outer.deallocations());
+  }
+}
+
+TEST(AllocationCounterTest, OtherThreadsAreNotCounted) {
+  AllocationCounter counter;
+  std::thread thread([]() {
+    auto value = std::make_unique<std::string>(64, 'a');
+    escape(value);
+  });
+  const uint64_t allocations_after_spawn = counter.allocations();
+  thread.join();
+  // Spawning and joining the thread may allocate on this thread, but the string allocated by the
+  // thread itself must not be attributed to this counter.
+  EXPECT_ALLOCATIONS_LE(counter.allocations() - allocations_after_spawn, 0);
+}
+
+} // namespace
+} // namespace TestUtil
+} // namespace Memory
+} // namespace Envoy
@@ -46,7 +46,7 @@ public:
 
 class UdpListenerImplTest : public UdpListenerImplTestBase {
 public:
-  void setup(bool prefer_gro = false) {
+  void setup(bool prefer_gro = false, bool batch_gro_reads = false) {
     UdpListenerImplTestBase::setup();
     ON_CALL(override_syscall_, supportsUdpGro()).WillByDefault(Return(false));
     // Return the real version by default.
@@ -75,6 +75,9 @@ public:
     if (prefer_gro) {
       config.mutable_prefer_gro()->set_value(prefer_gro);
     }
+    if (batch_gro_reads) {
+      config.mutable_batch_gro_reads()->set_value(batch_gro_reads);
+    }
     listener_ =
         std::make_unique<UdpListenerImpl>(dispatcherImpl(), server_socket_, listener_callbacks_,
                                           dispatcherImpl().timeSource(), config);
@@ -851,6 +854,105 @@ TEST_P(UdpListenerImplTest, UdpGroReadLimit) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+/**
+ * Test that with batched GRO reads several coalesced messages are received by one recvmmsg call
+ * and each is segmented by its own gso_size.
+ */
+TEST_P(UdpListenerImplTest, UdpGroBatchedRecvmmsg) {
+  setup(true, true);
+
+  absl::FixedArray<std::string> client_data({"Equal!!!", "Length!!", "Messages", "trail"});
+  for (const auto& i : client_data) {
+    client_.write(i, *send_to_addr_);
+  }
+
+  // The first three packets are coalesced by the kernel into one message, the last one is
+  // received on its own without a UDP_GRO control message.
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsUdpGro).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, supportsMmsg).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+
+  const auto set_message = [&](mmsghdr& mmsg, absl::string_view payload, uint16_t gso_size) {
+    msghdr* msg = &mmsg.msg_hdr;
+    if (client_.localAddress()->ip()->version() == Address::IpVersion::v4) {
+      sockaddr_in ipv4_addr;
+      memset(&ipv4_addr, 0, sizeof(sockaddr_in));
+      ipv4_addr.sin_family = AF_INET;
+      ipv4_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      ipv4_addr.sin_port = client_.localAddress()->ip()->port();
+      *reinterpret_cast<sockaddr_in*>(msg->msg_name) = ipv4_addr;
+      msg->msg_namelen = sizeof(sockaddr_in);
+    } else {
+      sockaddr_in6 ipv6_addr;
+      memset(&ipv6_addr, 0, sizeof(sockaddr_in6));
+      ipv6_addr.sin6_family = AF_INET6;
+      ipv6_addr.sin6_addr = in6addr_loopback;
+      ipv6_addr.sin6_port = client_.localAddress()->ip()->port();
+      *reinterpret_cast<sockaddr_in6*>(msg->msg_name) = ipv6_addr;
+      msg->msg_namelen = sizeof(sockaddr_in6);
+    }
+
+    EXPECT_EQ(msg->msg_iovlen, 1);
+    EXPECT_EQ(msg->msg_iov[0].iov_len, MAX_UDP_GRO_MESSAGE_SIZE);
+    memcpy(msg->msg_iov[0].iov_base, payload.data(), payload.length());
+    mmsg.msg_len = payload.length();
+
+    memset(msg->msg_control, 0, msg->msg_controllen);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+    if (send_to_addr_->ip()->version() == Address::IpVersion::v4) {
+      cmsg->cmsg_level = IPPROTO_IP;
+      cmsg->cmsg_type = IP_PKTINFO;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+      reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg))->ipi_addr.s_addr =
+          send_to_addr_->ip()->ipv4()->address();
+    } else {
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+      cmsg->cmsg_level = IPPROTO_IPV6;
+      cmsg->cmsg_type = IPV6_PKTINFO;
+      auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi6_ifindex = 0;
+      *(reinterpret_cast<absl::uint128*>(pktinfo->ipi6_addr.s6_addr)) =
+          send_to_addr_->ip()->ipv6()->address();
+    }
+
+    if (gso_size != 0) {
+      cmsg = CMSG_NXTHDR(msg, cmsg);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_GRO;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      *reinterpret_cast<uint16_t*>(CMSG_DATA(cmsg)) = gso_size;
+    }
+  };
+
+  EXPECT_CALL(os_sys_calls, recvmmsg(_, _, _, _, _))
+      .WillOnce(Invoke([&](os_fd_t, struct mmsghdr* msgvec, unsigned int vlen, int,
+                           struct timespec*) {
+        EXPECT_EQ(vlen, NUM_GRO_MESSAGES_PER_RECEIVE);
+        set_message(msgvec[0], absl::StrCat(client_data[0], client_data[1], client_data[2]), 8);
+        set_message(msgvec[1], client_data[3], 0);
+        return Api::SysCallIntResult{2, 0};
+      }))
+      .WillRepeatedly(Return(Api::SysCallIntResult{-1, EAGAIN}));
+
+  EXPECT_CALL(listener_callbacks_, onReadReady()).WillOnce(Invoke([&]() { dispatcher_->exit(); }));
+  EXPECT_CALL(listener_callbacks_, onData(_))
+      .Times(4u)
+      .WillRepeatedly(Invoke([&](const UdpRecvData& data) -> void {
+        validateRecvCallbackParams(data, client_data.size());
+
+        const std::string data_str = data.buffer_->toString();
+        EXPECT_EQ(data_str, client_data[num_packets_received_by_listener_ - 1]);
+      }));
+
+  EXPECT_CALL(listener_callbacks_, onWriteReady(_)).WillOnce(Invoke([&](const Socket& socket) {
+    EXPECT_EQ(&socket.ioHandle(), &server_socket_->ioHandle());
+  }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
 #endif
 
 } // namespace
@@ -0,0 +1,110 @@
+// Benchmarks the UDP receive path of Utility::readPacketsFromSocket() over loopback. The
+// packets_per_second counter is the receive rate of a single core, as each benchmark reads on one
+// thread.
+
+#include <memory>
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/event/real_time_system.h"
+#include "source/common/network/listen_socket_impl.h"
+#include "source/common/network/socket_option_factory.h"
+#include "source/common/network/utility.h"
+
+#include "test/test_common/network_utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+enum class ReadMethod { RecvMsg, RecvMmsg, RecvMmsgWithGro };
+
+class CountingUdpPacketProcessor : public UdpPacketProcessor {
+public:
+  // UdpPacketProcessor
+  void processPacket(Address::InstanceConstSharedPtr, Address::InstanceConstSharedPtr,
+                     Buffer::InstancePtr buffer, MonotonicTime, uint8_t,
+                     Buffer::OwnedImpl) override {
+    benchmark::DoNotOptimize(buffer->length());
+    ++packets_;
+  }
+  void onDatagramsDropped(uint32_t dropped) override { dropped_ += dropped; }
+  uint64_t maxDatagramSize() const override { return DEFAULT_UDP_MAX_DATAGRAM_SIZE; }
+  size_t numPacketsExpectedPerEventLoop() const override { return MAX_NUM_PACKETS_PER_EVENT_LOOP; }
+  const IoHandle::UdpSaveCmsgConfig& saveCmsgConfig() const override { return save_cmsg_config_; }
+
+  uint64_t packets_{};
+  uint64_t dropped_{};
+
+private:
+  const IoHandle::UdpSaveCmsgConfig save_cmsg_config_{};
+};
+
+// Sends state.range(1) datagrams of 1200 bytes per iteration, outside of the timed region, and
+// reads them with the method given by state.range(0). Datagrams the kernel drops because the
+// receive buffer is full are reported by the dropped counter.
+static void udpReadPackets(benchmark::State& state) {
+  const auto method = static_cast<ReadMethod>(state.range(0));
+  const uint64_t packets_per_batch = state.range(1);
+  const bool allow_gro = method == ReadMethod::RecvMmsgWithGro;
+  const bool allow_mmsg = method != ReadMethod::RecvMsg;
+  if (allow_gro && !Api::OsSysCallsSingleton::get().supportsUdpGro()) {
+    state.SkipWithError("GRO is not supported");
+    return;
+  }
+  if (allow_mmsg && !Api::OsSysCallsSingleton::get().supportsMmsg()) {
+    state.SkipWithError("recvmmsg is not supported");
+    return;
+  }
+
+  UdpListenSocket server(Test::getCanonicalLoopbackAddress(Address::IpVersion::v4), nullptr,
+                         true);
+  server.addOptions(SocketOptionFactory::buildRxQueueOverFlowOptions());
+  if (allow_gro) {
+    server.addOptions(SocketOptionFactory::buildUdpGroOptions());
+  }
+  if (!Socket::applyOptions(server.options(), server,
+                            envoy::config::core::v3::SocketOption::STATE_BOUND)) {
+    state.SkipWithError("failed to apply socket options");
+    return;
+  }
+  const Address::InstanceConstSharedPtr& server_address =
+      server.connectionInfoProvider().localAddress();
+
+  Test::UdpSyncPeer client(Address::IpVersion::v4);
+  const std::string payload(1200, 'a');
+  Event::RealTimeSystem time_system;
+  CountingUdpPacketProcessor processor;
+  uint32_t packets_dropped = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    for (uint64_t i = 0; i < packets_per_batch; ++i) {
+      client.write(payload, *server_address);
+    }
+    state.ResumeTiming();
+
+    // Loopback delivers the datagrams on send, so read until the socket would block. No error
+    // means the read stopped at MAX_NUM_PACKETS_PER_EVENT_LOOP.
+    while (Utility::readPacketsFromSocket(server.ioHandle(), *server_address, processor,
+                                          time_system, allow_gro, allow_mmsg, packets_dropped,
+                                          /*batch_gro_reads=*/allow_gro) == nullptr) {
+    }
+  }
+
+  state.counters["packets_per_second"] =
+      benchmark::Counter(processor.packets_, benchmark::Counter::kIsRate);
+  state.counters["dropped"] = processor.dropped_;
+}
+BENCHMARK(udpReadPackets)
+    ->ArgsProduct({{static_cast<int64_t>(ReadMethod::RecvMsg),
+                    static_cast<int64_t>(ReadMethod::RecvMmsg),
+                    static_cast<int64_t>(ReadMethod::RecvMmsgWithGro)},
+                   {16, 256}})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,271 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// HTTP/3 counterpart of test/common/http/codec_impl_speed_test.cc: feeds pre-serialized HTTP/3
+// request streams (QPACK headers plus DATA frames) into EnvoyQuicServerStream objects hosted by a
+// mock session, and encodes a small response for every request. Packet encryption and UDP I/O are
+// not part of the measurement, and neither are the allocations made setting up the mock session.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/quic/envoy_quic_alarm_factory.h"
+#include "source/common/quic/envoy_quic_connection_helper.h"
+#include "source/common/quic/envoy_quic_server_connection.h"
+#include "source/common/quic/envoy_quic_server_stream.h"
+#include "source/server/active_listener_base.h"
+
+#include "test/common/memory/allocation_counter.h"
+#include "test/common/quic/test_utils.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+#include "quiche/quic/core/deterministic_connection_id_generator.h"
+#include "quiche/quic/test_tools/quic_config_peer.h"
+#include "quiche/quic/test_tools/quic_connection_peer.h"
+
+namespace Envoy {
+namespace Quic {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+constexpr uint32_t kRequestsPerConnection = 100;
+constexpr uint64_t kResponseBodySize = 128;
+constexpr uint64_t kFlowControlWindow = 16 * 1024 * 1024;
+
+/**
+ * Request decoder for the stream currently being decoded. Each request is answered from within
+ * the decoder callbacks, as soon as its end of stream has been seen.
+ */
+class BenchmarkRequestDecoder : public Http::RequestDecoder {
+public:
+  BenchmarkRequestDecoder() : response_body_(kResponseBodySize, 'a') {
+    response_headers_.setStatus(200);
+    response_headers_.setContentType("application/json");
+    response_headers_.setContentLength(kResponseBodySize);
+  }
+
+  void setResponseEncoder(Http::ResponseEncoder& encoder) { response_encoder_ = &encoder; }
+
+  // Http::StreamDecoder
+  void decodeData(Buffer::Instance&, bool end_stream) override {
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeMetadata(Http::MetadataMapPtr&&) override {}
+
+  // Http::RequestDecoder
+  void decodeHeaders(Http::RequestHeaderMapSharedPtr&& headers, bool end_stream) override {
+    benchmark::DoNotOptimize(headers->getPathValue());
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeTrailers(Http::RequestTrailerMapPtr&&) override { respond(); }
+  void sendLocalReply(Http::Code, absl::string_view,
+                      const std::function<void(Http::ResponseHeaderMap&)>&,
+                      const absl::optional<Grpc::Status::GrpcStatus>, absl::string_view) override {}
+  StreamInfo::StreamInfo& streamInfo() override { return stream_info_; }
+  AccessLog::InstanceSharedPtrVector accessLogHandlers() override { return {}; }
+  Http::RequestDecoderHandlePtr getRequestDecoderHandle() override {
+    return std::make_unique<Handle>(*this);
+  }
+
+  uint64_t responses_{};
+
+private:
+  class Handle : public Http::RequestDecoderHandle {
+  public:
+    explicit Handle(Http::RequestDecoder& decoder) : decoder_(decoder) {}
+    OptRef<Http::RequestDecoder> get() override { return decoder_; }
+
+  private:
+    Http::RequestDecoder& decoder_;
+  };
+
+  void respond() {
+    ASSERT(response_encoder_ != nullptr);
+    response_encoder_->encodeHeaders(response_headers_, false);
+    Buffer::OwnedImpl body(response_body_);
+    response_encoder_->encodeData(body, true);
+    response_encoder_ = nullptr;
+    ++responses_;
+  }
+
+  Http::TestResponseHeaderMapImpl response_headers_;
+  const std::string response_body_;
+  Http::ResponseEncoder* response_encoder_{};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+};
+
+/**
+ * Owns the per process QUIC plumbing. runConnection() builds a fresh connection and session and
+ * pushes kRequestsPerConnection request streams through it.
+ */
+class Http3ServerCodecBenchmark {
+public:
+  Http3ServerCodecBenchmark()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("bench_thread")),
+        connection_helper_(*dispatcher_),
+        alarm_factory_(*dispatcher_, *connection_helper_.GetClock()),
+        quic_version_(quic::CurrentSupportedHttp3Versions()[0]),
+        quic_stat_names_(listener_config_.listenerScope().symbolTable()),
+        stats_({ALL_HTTP3_CODEC_STATS(
+            POOL_COUNTER_PREFIX(listener_config_.listenerScope(), "http3."),
+            POOL_GAUGE_PREFIX(listener_config_.listenerScope(), "http3."))}) {
+    quic_config_.SetInitialStreamFlowControlWindowToSend(kFlowControlWindow);
+    quic_config_.SetInitialSessionFlowControlWindowToSend(kFlowControlWindow);
+    ON_CALL(writer_, WritePacket(_, _, _, _, _, _))
+        .WillByDefault(Invoke([](const char*, size_t buf_len, const quic::QuicIpAddress&,
+                                 const quic::QuicSocketAddress&, quic::PerPacketOptions*,
+                                 const quic::QuicPacketWriterParams&) {
+          return quic::WriteResult{quic::WRITE_STATUS_OK, static_cast<int>(buf_len)};
+        }));
+  }
+
+  // Returns the number of responses encoded. Response bytes are added to bytes_written and the
+  // allocations made while processing the requests to allocations.
+  uint64_t runConnection(const std::string& request_payload, uint64_t& bytes_written,
+                         uint64_t& allocations) {
+    NiceMock<MockEnvoyQuicServerConnection> connection(
+        connection_helper_, alarm_factory_, writer_, quic::ParsedQuicVersionVector{quic_version_},
+        *listener_config_.socket_, connection_id_generator_);
+    NiceMock<MockEnvoyQuicSession> session(quic_config_, {quic_version_}, &connection, *dispatcher_,
+                                           kFlowControlWindow, quic_stat_names_,
+                                           listener_config_.listenerScope());
+    ON_CALL(session, ShouldYield(_)).WillByDefault(Return(false));
+    ON_CALL(session, WritevData(_, _, _, _, _, _))
+        .WillByDefault(Invoke([&bytes_written](quic::QuicStreamId, size_t write_length,
+                                               quic::QuicStreamOffset,
+                                               quic::StreamSendingState state,
+                                               quic::TransmissionType, quic::EncryptionLevel) {
+          bytes_written += write_length;
+          return quic::QuicConsumedData{write_length, state != quic::NO_FIN};
+        }));
+    ON_CALL(connection, SendControlFrame(_)).WillByDefault(Invoke([](const quic::QuicFrame& frame) {
+      quic::DeleteFrame(&const_cast<quic::QuicFrame&>(frame));
+      return true;
+    }));
+
+    session.Initialize();
+    quic::QuicConfig* config = session.config();
+    quic::test::QuicConfigPeer::SetReceivedMaxBidirectionalStreams(config,
+                                                                   2 * kRequestsPerConnection);
+    quic::test::QuicConfigPeer::SetReceivedMaxUnidirectionalStreams(
+        config, quic::kDefaultMaxStreamsPerConnection);
+    quic::test::QuicConfigPeer::SetReceivedInitialMaxStreamDataBytesUnidirectional(
+        config, kFlowControlWindow);
+    quic::test::QuicConfigPeer::SetReceivedInitialMaxStreamDataBytesIncomingBidirectional(
+        config, kFlowControlWindow);
+    quic::test::QuicConfigPeer::SetReceivedInitialMaxStreamDataBytesOutgoingBidirectional(
+        config, kFlowControlWindow);
+    quic::test::QuicConfigPeer::SetReceivedInitialSessionFlowControlWindow(config,
+                                                                           kFlowControlWindow);
+    connection.SetEncrypter(
+        quic::ENCRYPTION_FORWARD_SECURE,
+        std::make_unique<quic::test::TaggingEncrypter>(quic::ENCRYPTION_FORWARD_SECURE));
+    connection.SetDefaultEncryptionLevel(quic::ENCRYPTION_FORWARD_SECURE);
+    quic::test::QuicConnectionPeer::SetAddressValidated(&connection);
+    session.OnConfigNegotiated();
+    quic::SettingsFrame settings;
+    settings.values[quic::SETTINGS_H3_DATAGRAM] = 1;
+    session.OnSettingsFrame(settings);
+
+    BenchmarkRequestDecoder decoder;
+    Memory::TestUtil::AllocationCounter allocation_counter;
+    for (uint32_t i = 0; i < kRequestsPerConnection; ++i) {
+      const quic::QuicStreamId stream_id =
+          quic::QuicUtils::GetFirstBidirectionalStreamId(quic_version_.transport_version,
+                                                         quic::Perspective::IS_CLIENT) +
+          i * quic::QuicUtils::StreamIdDelta(quic_version_.transport_version);
+      auto* stream = new EnvoyQuicServerStream(stream_id, &session, quic::BIDIRECTIONAL, stats_,
+                                               http3_options_,
+                                               envoy::config::core::v3::HttpProtocolOptions::ALLOW);
+      stream->setRequestDecoder(decoder);
+      decoder.setResponseEncoder(*stream);
+      session.ActivateStream(std::unique_ptr<EnvoyQuicServerStream>(stream));
+      stream->OnStreamFrame(
+          quic::QuicStreamFrame(stream_id, /*fin=*/true, /*offset=*/0, request_payload));
+    }
+    session.CleanUpClosedStreams();
+    allocations += allocation_counter.allocations();
+    session.close(Network::ConnectionCloseType::NoFlush);
+    return decoder.responses_;
+  }
+
+private:
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  EnvoyQuicConnectionHelper connection_helper_;
+  EnvoyQuicAlarmFactory alarm_factory_;
+  NiceMock<quic::test::MockPacketWriter> writer_;
+  quic::ParsedQuicVersion quic_version_;
+  quic::QuicConfig quic_config_;
+  NiceMock<Network::MockListenerConfig> listener_config_;
+  quic::DeterministicConnectionIdGenerator connection_id_generator_{
+      quic::kQuicDefaultConnectionIdLength};
+  QuicStatNames quic_stat_names_;
+  Http::Http3::CodecStats stats_;
+  envoy::config::core::v3::Http3ProtocolOptions http3_options_;
+};
+
+std::string http3Request(uint64_t body_size) {
+  quiche::HttpHeaderBlock headers;
+  headers[":method"] = body_size > 0 ? "POST" : "GET";
+  headers[":path"] = "/api/v1/items/12345?include=details&format=json";
+  headers[":authority"] = "api.example.com";
+  headers[":scheme"] = "https";
+  headers["user-agent"] = "Mozilla/5.0 (X11; Linux x86_64) benchmark/1.0";
+  headers["accept"] = "application/json, text/plain, */*";
+  headers["accept-encoding"] = "gzip, deflate, br";
+  headers["accept-language"] = "en-US,en;q=0.9";
+  headers["cookie"] = "session=0123456789abcdef0123456789abcdef";
+  headers["x-request-id"] = "4b8f2a70-6f3e-4c83-9f4e-1a2b3c4d5e6f";
+  if (body_size > 0) {
+    headers["content-length"] = absl::StrCat(body_size);
+    return absl::StrCat(spdyHeaderToHttp3StreamPayload(headers),
+                        bodyToHttp3StreamPayload(std::string(body_size, 'b')));
+  }
+  return spdyHeaderToHttp3StreamPayload(headers);
+}
+
+// Measures HTTP/3 server stream request decoding (including QPACK) and response encoding. The Arg
+// is the request body size, 0 meaning a GET without a body.
+void http3ServerCodec(benchmark::State& state) {
+  const uint64_t body_size = state.range(0);
+  const std::string request = http3Request(body_size);
+  Http3ServerCodecBenchmark harness;
+  uint64_t requests = 0;
+  uint64_t bytes_written = 0;
+  uint64_t allocations = 0;
+
+  for (auto _ : state) { // NOLINT
+    requests += harness.runConnection(request, bytes_written, allocations);
+  }
+
+  state.SetItemsProcessed(requests);
+  state.SetBytesProcessed(requests * request.size());
+  state.counters["ns_per_request"] = benchmark::Counter(
+      requests / 1e9, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["bytes_read_per_request"] = benchmark::Counter(request.size());
+  state.counters["bytes_written_per_request"] =
+      benchmark::Counter(requests == 0 ? 0 : static_cast<double>(bytes_written) / requests);
+  if (Memory::TestUtil::AllocationCounter::enabled()) {
+    state.counters["allocations_per_request"] =
+        benchmark::Counter(requests == 0 ? 0 : static_cast<double>(allocations) / requests);
+  }
+}
+BENCHMARK(http3ServerCodec)->Arg(0)->Arg(1024)->Arg(16 * 1024)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Quic
+} // namespace Envoy
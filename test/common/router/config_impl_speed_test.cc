@@ -4,6 +4,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/router/config_impl.h"
 
+#include "test/common/memory/allocation_counter.h"
 #include "test/mocks/server/server_factory_context.h"
 #include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/utility.h"
@@ -358,6 +359,16 @@ static RouteConfiguration genMixedRouteConfig(int n) {
   return route_config;
 }
 
+// Reports the average number of heap allocations per route() call, when allocation counting is
+// supported by the malloc library in use.
+static void reportAllocations(benchmark::State& state,
+                              const Memory::TestUtil::AllocationCounter& counter) {
+  if (Memory::TestUtil::AllocationCounter::enabled()) {
+    state.counters["allocations"] =
+        benchmark::Counter(counter.allocations(), benchmark::Counter::kAvgIterations);
+  }
+}
+
 // N plain prefix routes, no query/cookie matching. Request matches the last route.
 static void bmPlainRoutes(benchmark::State& state) {
   const int n = state.range(0);
@@ -372,9 +383,11 @@ static void bmPlainRoutes(benchmark::State& state) {
                                          {":method", "GET"},
                                          {":path", path},
                                          {"x-forwarded-proto", "http"}};
+  Memory::TestUtil::AllocationCounter allocation_counter;
   for (auto _ : state) { // NOLINT
     config->route(headers, stream_info, 0);
   }
+  reportAllocations(state, allocation_counter);
 }
 
 // N routes, first half with non-matching query params. Request matches the last route.
@@ -390,9 +403,11 @@ static void bmMixedRoutes(benchmark::State& state) {
                                          {":method", "GET"},
                                          {":path", "/api/foo?id=target"},
                                          {"x-forwarded-proto", "http"}};
+  Memory::TestUtil::AllocationCounter allocation_counter;
   for (auto _ : state) { // NOLINT
     config->route(headers, stream_info, 0);
   }
+  reportAllocations(state, allocation_counter);
 }
 
 BENCHMARK(bmPlainRoutes)->RangeMultiplier(2)->Ranges({{64, 2 << 10}});
@@ -11,6 +11,7 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -712,11 +713,19 @@ public:
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
   bool autoSniSanMatch() const override { return false; }
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                           CertificateValidationContext::AsyncChainVerification>&
+  asyncChainVerification() const override {
+    return async_chain_verification_;
+  }
 
 private:
   std::string s_;
   std::vector<std::string> strs_;
   std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher> matchers_;
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+                     AsyncChainVerification>
+      async_chain_verification_;
 };
 
 TEST(DefaultCertValidatorTest, TestUnexpectedSanMatcherType) {
@@ -788,6 +797,11 @@ public:
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
   bool autoSniSanMatch() const override { return false; }
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                           CertificateValidationContext::AsyncChainVerification>&
+  asyncChainVerification() const override {
+    return async_chain_verification_;
+  }
 
 private:
   std::string ca_name_;
@@ -796,6 +810,9 @@ private:
   std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher> empty_matchers_;
   absl::optional<envoy::config::core::v3::TypedExtensionConfig> custom_config_;
   Api::ApiPtr api_ = Api::createApiForTest();
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+                     AsyncChainVerification>
+      async_chain_verification_;
 };
 
 TEST(DefaultCertValidatorTest, DefaultValidatorCaExpirationStats) {
@@ -891,6 +908,177 @@ TEST(DefaultCertValidatorTest, TestEmptyCertChainErrorDetails) {
   EXPECT_EQ(results.error_details.value(), "verify cert failed: empty cert chain");
 }
 
+class AsyncChainVerificationTest : public testing::Test {
+protected:
+  class TestValidateResultCallback : public Ssl::ValidateResultCallback {
+  public:
+    TestValidateResultCallback(Event::Dispatcher& dispatcher, absl::optional<bool>& succeeded)
+        : dispatcher_(dispatcher), succeeded_(succeeded) {}
+
+    Event::Dispatcher& dispatcher() override { return dispatcher_; }
+    void onCertValidationResult(bool succeeded, Ssl::ClientValidationStatus, const std::string&,
+                                uint8_t) override {
+      succeeded_ = succeeded;
+      dispatcher_.exit();
+    }
+
+  private:
+    Event::Dispatcher& dispatcher_;
+    absl::optional<bool>& succeeded_;
+  };
+
+  AsyncChainVerificationTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        stats_(generateSslStats(*store_.rootScope())),
+        cert_chain_(readCertChainFromFile(TestEnvironment::substitute(
+            "{{ test_rundir }}/test/common/tls/test_data/test_long_cert_chain.pem"))) {
+    ON_CALL(context_.api_, threadFactory())
+        .WillByDefault(testing::ReturnRef(api_->threadFactory()));
+    // The leaf is followed by the three intermediates of the chain.
+    bssl::UniquePtr<X509> leaf = readCertFromFile(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/common/tls/test_data/test_random_cert.pem"));
+    EXPECT_NE(0, sk_X509_insert(cert_chain_.get(), leaf.release(), 0));
+  }
+
+  void initialize(const envoy::extensions::transport_sockets::tls::v3::
+                      CertificateValidationContext::AsyncChainVerification& async_config) {
+    config_ = std::make_unique<TestCertificateValidationContextConfig>(
+        envoy::config::core::v3::TypedExtensionConfig(), false,
+        std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher>{},
+        TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+            "{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")));
+    config_->setAsyncChainVerification(async_config);
+    validator_ = std::make_unique<DefaultCertValidator>(config_.get(), stats_, context_);
+    ASSERT_TRUE(
+        validator_->initializeSslContexts({ssl_ctx_.get()}, false, *store_.rootScope()).ok());
+  }
+
+  ValidationResults verify(Ssl::ValidateResultCallbackPtr callback) {
+    return validator_->doVerifyCertChain(*cert_chain_, std::move(callback),
+                                         /*transport_socket_options=*/nullptr, *ssl_ctx_, {},
+                                         false, "");
+  }
+
+  uint64_t counter(const std::string& name) {
+    return store_.counterFromString("ssl.chain_verification." + name).value();
+  }
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Stats::TestUtil::TestStore store_;
+  SslStats stats_;
+  SSLContextPtr ssl_ctx_{SSL_CTX_new(TLS_method())};
+  bssl::UniquePtr<STACK_OF(X509)> cert_chain_;
+  TestCertificateValidationContextConfigPtr config_;
+  std::unique_ptr<DefaultCertValidator> validator_;
+};
+
+// Chains verified synchronously are cached, so verifying them again skips the trust store.
+TEST_F(AsyncChainVerificationTest, CachesVerifiedChains) {
+  initialize({});
+
+  ValidationResults results = verify(nullptr);
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, results.detailed_status);
+  EXPECT_EQ(1, counter("cache_miss"));
+
+  results = verify(nullptr);
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_FALSE(results.validated_chain.empty());
+  EXPECT_EQ(1, counter("cache_hit"));
+  EXPECT_EQ(0, counter("offloaded"));
+}
+
+// Long chains are verified on the pool and the result is delivered on the dispatcher.
+TEST_F(AsyncChainVerificationTest, OffloadsLongChains) {
+  envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+      AsyncChainVerification async_config;
+  async_config.mutable_cache_size()->set_value(0);
+  initialize(async_config);
+
+  absl::optional<bool> succeeded;
+  ValidationResults results =
+      verify(std::make_unique<TestValidateResultCallback>(*dispatcher_, succeeded));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending, results.status);
+  EXPECT_EQ(1, counter("offloaded"));
+
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  ASSERT_TRUE(succeeded.has_value());
+  EXPECT_TRUE(succeeded.value());
+}
+
+// Chains shorter than the minimum length are verified inline even if a callback is provided.
+TEST_F(AsyncChainVerificationTest, VerifiesShortChainsInline) {
+  envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+      AsyncChainVerification async_config;
+  async_config.mutable_min_chain_length()->set_value(5);
+  initialize(async_config);
+
+  absl::optional<bool> succeeded;
+  ValidationResults results =
+      verify(std::make_unique<TestValidateResultCallback>(*dispatcher_, succeeded));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_EQ(0, counter("offloaded"));
+  EXPECT_FALSE(succeeded.has_value());
+}
+
+// When the pool is full the chain is verified inline. The other checks run once, and the verified
+// chain is cached as it would be by the pool.
+TEST_F(AsyncChainVerificationTest, VerifiesInlineWhenPoolFull) {
+  envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+      AsyncChainVerification async_config;
+  async_config.mutable_thread_count()->set_value(1);
+  initialize(async_config);
+
+  // Keep the only thread of the pool busy and fill its queue.
+  Thread::BoundedThreadPoolSharedPtr pool = DefaultCertValidator::chainVerificationPool(
+      context_.singletonManager(), api_->threadFactory(), 1);
+  absl::Notification started;
+  absl::Notification release;
+  ASSERT_TRUE(pool->post([&]() {
+    started.Notify();
+    release.WaitForNotification();
+  }));
+  started.WaitForNotification();
+  for (size_t i = 0; i < Thread::BoundedThreadPool::MaxQueuedJobsPerThread; ++i) {
+    ASSERT_TRUE(pool->post([]() {}));
+  }
+
+  absl::optional<bool> succeeded;
+  ValidationResults results =
+      verify(std::make_unique<TestValidateResultCallback>(*dispatcher_, succeeded));
+  release.Notify();
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, results.detailed_status);
+  EXPECT_FALSE(results.validated_chain.empty());
+  EXPECT_EQ(1, counter("pool_full"));
+  EXPECT_EQ(0, counter("offloaded"));
+  EXPECT_EQ(0U, stats_.fail_verify_san_.value());
+  EXPECT_EQ(0U, stats_.fail_verify_error_.value());
+  EXPECT_FALSE(succeeded.has_value());
+
+  results = verify(std::make_unique<TestValidateResultCallback>(*dispatcher_, succeeded));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+  EXPECT_FALSE(results.validated_chain.empty());
+  EXPECT_EQ(1, counter("cache_miss"));
+  EXPECT_EQ(1, counter("cache_hit"));
+  EXPECT_EQ(0, counter("offloaded"));
+}
+
+// Results of verifications still running when the validator is destroyed are dropped.
+TEST_F(AsyncChainVerificationTest, DropsResultsAfterValidatorDestroyed) {
+  initialize({});
+
+  absl::optional<bool> succeeded;
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending,
+            verify(std::make_unique<TestValidateResultCallback>(*dispatcher_, succeeded)).status);
+  validator_.reset();
+
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(succeeded.has_value());
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -116,6 +116,16 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
+  const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                           CertificateValidationContext::AsyncChainVerification>&
+  asyncChainVerification() const override {
+    return async_chain_verification_;
+  }
+  void setAsyncChainVerification(
+      const envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+          AsyncChainVerification& async_chain_verification) {
+    async_chain_verification_ = async_chain_verification;
+  }
 
 private:
   bool allow_expired_certificate_{false};
@@ -128,6 +138,9 @@ private:
   const std::string ca_cert_name_{"TEST_CA_CERT_NAME"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
   const bool auto_sni_san_match_{false};
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+                     AsyncChainVerification>
+      async_chain_verification_;
 };
 
 } // namespace Tls
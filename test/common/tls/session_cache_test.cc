@@ -0,0 +1,80 @@
+#include <string>
+
+#include "source/common/singleton/manager_impl.h"
+#include "source/common/tls/session_cache.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+TEST(SharedSessionCacheImplTest, InsertLookupRemove) {
+  SharedSessionCacheImpl cache;
+  cache.reserve(64);
+
+  EXPECT_FALSE(cache.lookup("id").has_value());
+  cache.insert("id", "session");
+  EXPECT_EQ("session", cache.lookup("id").value());
+
+  cache.insert("id", "replaced");
+  EXPECT_EQ("replaced", cache.lookup("id").value());
+  EXPECT_EQ(1U, cache.size());
+
+  cache.remove("id");
+  EXPECT_FALSE(cache.lookup("id").has_value());
+  EXPECT_EQ(0U, cache.size());
+
+  // Removing a missing session is a no-op.
+  cache.remove("id");
+}
+
+TEST(SharedSessionCacheImplTest, NoCapacity) {
+  SharedSessionCacheImpl cache;
+  cache.insert("id", "session");
+  EXPECT_FALSE(cache.lookup("id").has_value());
+  EXPECT_EQ(0U, cache.size());
+}
+
+TEST(SharedSessionCacheImplTest, EvictsLeastRecentlyUsed) {
+  SharedSessionCacheImpl cache;
+  cache.reserve(SharedSessionCacheImpl::NumShards);
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.insert(absl::StrCat("id", i), "session");
+    // The most recently inserted session is never evicted.
+    EXPECT_TRUE(cache.lookup(absl::StrCat("id", i)).has_value());
+  }
+  EXPECT_LE(cache.size(), SharedSessionCacheImpl::NumShards);
+  EXPECT_FALSE(cache.lookup("id0").has_value());
+}
+
+TEST(SharedSessionCacheImplTest, ReserveNeverShrinks) {
+  SharedSessionCacheImpl cache;
+  cache.reserve(10 * SharedSessionCacheImpl::NumShards);
+  cache.reserve(1);
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.insert(absl::StrCat("id", i), "session");
+  }
+  EXPECT_GT(cache.size(), SharedSessionCacheImpl::NumShards);
+  EXPECT_LE(cache.size(), 10 * SharedSessionCacheImpl::NumShards);
+}
+
+TEST(SharedSessionCacheImplTest, SingletonOutlivesUsers) {
+  Singleton::ManagerImpl singleton_manager;
+  SharedSessionCacheImpl::get(singleton_manager, 64)->insert("id", "session");
+
+  // The cache is pinned, so the session is still there once all references were released.
+  auto cache = SharedSessionCacheImpl::get(singleton_manager, 1);
+  EXPECT_EQ("session", cache->lookup("id").value());
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -1,4 +1,10 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tls/ktls.h"
 
 #include "test/test_common/environment.h"
 
@@ -192,5 +198,127 @@ static void testParams(benchmark::internal::Benchmark* b) {
 
 BENCHMARK(testThroughput)->Unit(::benchmark::kMicrosecond)->Apply(testParams);
 
+// Returns a connected pair of loopback TCP sockets, as kernel TLS is only available for TCP.
+static std::pair<int, int> tcpSocketPair() {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t address_len = sizeof(address);
+  RELEASE_ASSERT(bind(listener, reinterpret_cast<sockaddr*>(&address), address_len) == 0, "bind");
+  RELEASE_ASSERT(listen(listener, 1) == 0, "listen");
+  RELEASE_ASSERT(getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_len) == 0,
+                 "getsockname");
+  int client = socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(connect(client, reinterpret_cast<sockaddr*>(&address), address_len) == 0,
+                 "connect");
+  int server = accept(listener, nullptr, nullptr);
+  RELEASE_ASSERT(server >= 0, "accept");
+  ::close(listener);
+  for (int fd : {client, server}) {
+    RELEASE_ASSERT(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0, "fcntl");
+  }
+  return {server, client};
+}
+
+// Compares writing TLS 1.2 AES-GCM records with BoringSSL to handing record encryption to the
+// kernel and writing the buffer with writev(). Skipped where the kernel has no TLS support.
+static void testKernelTlsThroughput(benchmark::State& state) {
+  std::string error;
+  std::unique_ptr<bazel::tools::cpp::runfiles::Runfiles> runfiles(
+      bazel::tools::cpp::runfiles::Runfiles::Create("tls_throughput_benchmark", &error));
+  Envoy::TestEnvironment::setRunfiles(runfiles.get());
+
+  const auto [server_fd, client_fd] = tcpSocketPair();
+
+  bssl::UniquePtr<SSL_CTX> server_ctx(SSL_CTX_new(TLS_method()));
+  bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+  std::string cert_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem");
+  std::string key_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem");
+  RELEASE_ASSERT(
+      SSL_CTX_use_certificate_file(server_ctx.get(), cert_path.c_str(), SSL_FILETYPE_PEM) > 0,
+      "SSL_CTX_use_certificate_file");
+  RELEASE_ASSERT(
+      SSL_CTX_use_PrivateKey_file(server_ctx.get(), key_path.c_str(), SSL_FILETYPE_PEM) > 0,
+      "SSL_CTX_use_PrivateKey_file");
+  SSL_CTX_set_max_proto_version(client_ctx.get(), TLS1_2_VERSION);
+  SSL_CTX_set_strict_cipher_list(client_ctx.get(), "ECDHE-RSA-AES128-GCM-SHA256");
+
+  bssl::UniquePtr<SSL> server_ssl(SSL_new(server_ctx.get()));
+  SSL_set_fd(server_ssl.get(), server_fd);
+  SSL_set_accept_state(server_ssl.get());
+
+  bssl::UniquePtr<SSL> client_ssl(SSL_new(client_ctx.get()));
+  SSL_set_fd(client_ssl.get(), client_fd);
+  SSL_set_connect_state(client_ssl.get());
+
+  bool handshake_success = false;
+  for (int i = 0; i < 50; i++) {
+    int client_err = SSL_do_handshake(client_ssl.get());
+    int server_err = SSL_do_handshake(server_ssl.get());
+    if (client_err == 1 && server_err == 1) {
+      handshake_success = true;
+      break;
+    }
+    handleSslError(client_ssl.get(), client_err, false);
+    handleSslError(server_ssl.get(), server_err, true);
+  }
+  RELEASE_ASSERT(handshake_success, "handshake completed successfully");
+
+  // The handle owns and closes the client socket.
+  Network::IoSocketHandleImpl client_handle(client_fd);
+  const bool kernel_tls = state.range(0);
+  if (kernel_tls && !KernelTls::enableTx(client_ssl.get(), client_handle)) {
+    state.SkipWithError("kernel TLS is not supported");
+    ::close(server_fd);
+    return;
+  }
+
+  static uint8_t read_buf[1024 * 1024];
+  auto drain_reader = [&server_ssl]() {
+    while (SSL_read(server_ssl.get(), read_buf, sizeof(read_buf)) > 0) {
+    }
+  };
+
+  uint64_t bytes_written = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    drain_reader();
+    Buffer::OwnedImpl write_buf;
+    addFullSlices(write_buf, 10, true);
+    bytes_written += write_buf.length();
+    state.ResumeTiming();
+
+    while (write_buf.length() > 0) {
+      if (kernel_tls) {
+        Api::IoCallUint64Result result = client_handle.write(write_buf);
+        RELEASE_ASSERT(result.ok() ||
+                           result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again,
+                       "write");
+        if (!result.ok()) {
+          drain_reader();
+        }
+      } else {
+        const size_t len = std::min<uint64_t>(write_buf.length(), 16384);
+        const int rc = SSL_write(client_ssl.get(), write_buf.linearize(len), len);
+        if (rc > 0) {
+          write_buf.drain(rc);
+        } else {
+          handleSslError(client_ssl.get(), rc, false);
+          drain_reader();
+        }
+      }
+    }
+  }
+  state.counters["throughput"] = benchmark::Counter(bytes_written, benchmark::Counter::kIsRate);
+
+  ::close(server_fd);
+}
+
+BENCHMARK(testKernelTlsThroughput)->Unit(::benchmark::kMicrosecond)->Arg(0)->Arg(1);
+
 } // namespace Extensions::TransportSockets::Tls
 } // namespace Envoy
@@ -467,6 +467,35 @@ TEST_F(UnaryGrpcAccessLogTest, Batching) {
   EXPECT_EQ(2, logger_->numClears());
 }
 
+// Test that the batch limit grows while the buffer keeps filling up and shrinks when it doesn't.
+TEST_F(UnaryGrpcAccessLogTest, AdaptiveBatching) {
+  const uint64_t entry_size = mockHttpEntry().ByteSizeLong();
+  config_.mutable_max_buffer_size_bytes()->set_value(8 * entry_size);
+  initLogger(FlushInterval, 2 * entry_size);
+  EXPECT_EQ(2 * entry_size, logger_->bufferSizeBytes());
+
+  // Every full buffer doubles the limit, up to the maximum.
+  for (const int count : {2, 4, 8, 8}) {
+    expectFlushedLogEntriesCount(MOCK_HTTP_LOG_FIELD_NAME, count);
+    for (int i = 0; i < count; ++i) {
+      logger_->log(mockHttpEntry());
+    }
+    EXPECT_EQ(std::min<uint64_t>(2 * count, 8) * entry_size, logger_->bufferSizeBytes());
+  }
+
+  // The buffer filled up during this interval, so the limit is kept.
+  EXPECT_CALL(*timer_, enableTimer(FlushInterval, _));
+  timer_->invokeCallback();
+  EXPECT_EQ(8 * entry_size, logger_->bufferSizeBytes());
+
+  // Every quiet interval halves the limit, down to the configured buffer size.
+  for (const uint64_t expected : {4, 2, 2}) {
+    EXPECT_CALL(*timer_, enableTimer(FlushInterval, _));
+    timer_->invokeCallback();
+    EXPECT_EQ(expected * entry_size, logger_->bufferSizeBytes());
+  }
+}
+
 // Test that log entries are flushed periodically.
 TEST_F(UnaryGrpcAccessLogTest, Flushing) {
   initLogger(FlushInterval, 100);
@@ -0,0 +1,117 @@
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/filters/exemplar/v3/exemplar.pb.h"
+
+#include "source/extensions/access_loggers/filters/exemplar/config.h"
+
+#include "test/common/stream_info/test_util.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Filters {
+namespace Exemplar {
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+class ExemplarFilterTest : public testing::Test {
+protected:
+  ExemplarFilterTest() : stream_info_(time_system_) {
+    ON_CALL(context_.server_factory_context_, timeSource()).WillByDefault(ReturnRef(time_system_));
+  }
+
+  AccessLog::FilterPtr createFilter(const std::string& yaml) {
+    envoy::config::accesslog::v3::ExtensionFilter proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    return factory_.createFilter(proto_config, context_);
+  }
+
+  bool evaluate(const AccessLog::Filter& filter, uint32_t response_code) {
+    stream_info_.setResponseCode(response_code);
+    return filter.evaluate({}, stream_info_);
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(context_.server_factory_context_.store_,
+                                    "access_log.exemplar." + name)
+        ->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+  TestStreamInfo stream_info_;
+  ExemplarFilterFactory factory_;
+};
+
+TEST_F(ExemplarFilterTest, EntriesPerKeyAndInterval) {
+  auto filter = createFilter(R"EOF(
+name: exemplar
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.access_loggers.filters.exemplar.v3.ExemplarFilter
+  key_format: "%RESPONSE_CODE%"
+  interval: 10s
+  max_entries_per_key: 2
+)EOF");
+
+  EXPECT_TRUE(evaluate(*filter, 200));
+  EXPECT_TRUE(evaluate(*filter, 200));
+  EXPECT_FALSE(evaluate(*filter, 200));
+  // Every key has its own budget.
+  EXPECT_TRUE(evaluate(*filter, 503));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_FALSE(evaluate(*filter, 200));
+
+  // The budgets are reset once the interval is over.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_TRUE(evaluate(*filter, 200));
+  EXPECT_TRUE(evaluate(*filter, 200));
+  EXPECT_FALSE(evaluate(*filter, 200));
+
+  EXPECT_EQ(5, counter("allowed"));
+  EXPECT_EQ(3, counter("denied"));
+}
+
+TEST_F(ExemplarFilterTest, MaxKeys) {
+  auto filter = createFilter(R"EOF(
+name: exemplar
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.access_loggers.filters.exemplar.v3.ExemplarFilter
+  key_format: "%RESPONSE_CODE%"
+  interval: 1s
+  max_keys: 2
+)EOF");
+
+  EXPECT_TRUE(evaluate(*filter, 200));
+  EXPECT_TRUE(evaluate(*filter, 404));
+  // New keys are not tracked until the interval is over.
+  EXPECT_FALSE(evaluate(*filter, 503));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_TRUE(evaluate(*filter, 503));
+}
+
+TEST_F(ExemplarFilterTest, InvalidKeyFormat) {
+  EXPECT_THROW(createFilter(R"EOF(
+name: exemplar
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.access_loggers.filters.exemplar.v3.ExemplarFilter
+  key_format: "%NOT_A_COMMAND%"
+  interval: 1s
+)EOF"),
+               EnvoyException);
+}
+
+} // namespace
+} // namespace Exemplar
+} // namespace Filters
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
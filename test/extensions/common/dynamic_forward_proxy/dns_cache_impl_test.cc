@@ -1593,6 +1593,67 @@ TEST_F(DnsCacheImplTest, MaxHostOverflow) {
   EXPECT_EQ(1, TestUtility::findCounter(context_.store_, "dns_cache.foo.host_overflow")->value());
 }
 
+// With LRU eviction enabled, a full cache makes room for a new host instead of overflowing.
+TEST_F(DnsCacheImplTest, MaxHostEvictsLeastRecentlyUsed) {
+  config_.set_evict_least_recently_used_hosts(true);
+  initialize({} /* preresolve_hostnames */, 1 /* max_hosts */);
+  InSequence s;
+
+  MockLoadDnsCacheEntryCallbacks callbacks;
+  Network::DnsResolver::ResolveCb resolve_cb;
+  Event::MockTimer* resolve_timer = new Event::MockTimer(&context_.server_context_.dispatcher_);
+  Event::MockTimer* timeout_timer = new Event::MockTimer(&context_.server_context_.dispatcher_);
+  EXPECT_CALL(*timeout_timer, enableTimer(std::chrono::milliseconds(5000), nullptr));
+  EXPECT_CALL(*resolver_, resolve("foo.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  auto result = dns_cache_->loadDnsCacheEntry("foo.com", 80, false, callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::Loading, result.status_);
+
+  EXPECT_CALL(*timeout_timer, disableTimer());
+  EXPECT_CALL(
+      update_callbacks_,
+      onDnsHostAddOrUpdate("foo.com:80", DnsHostInfoEquals("10.0.0.1:80", "foo.com", false)));
+  EXPECT_CALL(callbacks,
+              onLoadDnsCacheComplete(DnsHostInfoEquals("10.0.0.1:80", "foo.com", false)));
+  EXPECT_CALL(update_callbacks_,
+              onDnsResolutionComplete("foo.com:80",
+                                      DnsHostInfoEquals("10.0.0.1:80", "foo.com", false),
+                                      Network::DnsResolver::ResolutionStatus::Completed));
+  EXPECT_CALL(*resolve_timer, enableTimer(std::chrono::milliseconds(dns_ttl_), _));
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Completed, "",
+             TestUtility::makeDnsResponse({"10.0.0.1"}));
+
+  // The cache is full, so loading bar.com evicts foo.com.
+  MockLoadDnsCacheEntryCallbacks bar_callbacks;
+  EXPECT_CALL(update_callbacks_, onDnsHostRemove("foo.com:80"));
+  new Event::MockTimer(&context_.server_context_.dispatcher_); // resolve_timer
+  Event::MockTimer* bar_timeout_timer = new Event::MockTimer(&context_.server_context_.dispatcher_);
+  EXPECT_CALL(*bar_timeout_timer, enableTimer(std::chrono::milliseconds(5000), nullptr));
+  EXPECT_CALL(*resolver_, resolve("bar.com", _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  result = dns_cache_->loadDnsCacheEntry("bar.com", 80, false, bar_callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::Loading, result.status_);
+  EXPECT_NE(result.handle_, nullptr);
+
+  checkStats(2 /* attempt */, 1 /* success */, 0 /* failure */, 1 /* address changed */,
+             2 /* added */, 1 /* removed */, 1 /* num hosts */);
+  EXPECT_EQ(1, TestUtility::findCounter(context_.store_, "dns_cache.foo.host_evicted")->value());
+  EXPECT_EQ(0, TestUtility::findCounter(context_.store_, "dns_cache.foo.host_overflow")->value());
+  EXPECT_FALSE(dns_cache_->getHost("foo.com:80").has_value());
+
+  // bar.com is being resolved so it can't be evicted, and baz.com overflows the cache instead.
+  MockLoadDnsCacheEntryCallbacks baz_callbacks;
+  EXPECT_CALL(*resolver_, resolve("baz.com", _, _)).Times(0);
+  auto baz_result = dns_cache_->loadDnsCacheEntry("baz.com", 80, false, baz_callbacks);
+  EXPECT_EQ(DnsCache::LoadDnsCacheEntryStatus::Loading, baz_result.status_);
+
+  checkStats(2 /* attempt */, 1 /* success */, 0 /* failure */, 1 /* address changed */,
+             2 /* added */, 1 /* removed */, 1 /* num hosts */);
+  EXPECT_EQ(1, TestUtility::findCounter(context_.store_, "dns_cache.foo.host_evicted")->value());
+  EXPECT_EQ(1, TestUtility::findCounter(context_.store_, "dns_cache.foo.host_overflow")->value());
+  EXPECT_FALSE(dns_cache_->getHost("baz.com:80").has_value());
+}
+
 TEST_F(DnsCacheImplTest, CircuitBreakersNotInvoked) {
   initialize();
 
@@ -102,6 +102,36 @@ TEST_F(BrotliCompressorImplTest, CompressWithSmallChunkSize) {
   verifyWithDecompressor(std::move(compressor));
 }
 
+// A dictionary shared with the decompressor shrinks small payloads that repeat its content.
+TEST_F(BrotliCompressorImplTest, CompressWithDictionary) {
+  const std::string dictionary_data =
+      R"({"id": 0, "name": "", "status": "active", "tags": [], "created_at": ""})";
+  const std::string payload =
+      R"({"id": 42, "name": "envoy", "status": "active", "tags": [], "created_at": "now"})";
+
+  auto compress = [&](BrotliCompressorDictionarySharedPtr dictionary) {
+    BrotliCompressorImpl compressor(default_quality, default_window_bits, default_input_block_bits,
+                                    false, BrotliCompressorImpl::EncoderMode::Default, 4096,
+                                    std::move(dictionary));
+    Buffer::OwnedImpl buffer(payload);
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    return buffer.toString();
+  };
+  const std::string without_dictionary = compress(nullptr);
+  const std::string with_dictionary = compress(
+      std::make_shared<const BrotliCompressorDictionary>(dictionary_data, default_quality));
+  EXPECT_LT(with_dictionary.size(), without_dictionary.size());
+
+  Stats::IsolatedStoreImpl stats_store{};
+  Compression::Brotli::Decompressor::BrotliDecompressorImpl decompressor{
+      *stats_store.rootScope(), "test.", 4096, false,
+      std::make_shared<const std::string>(dictionary_data)};
+  Buffer::OwnedImpl input(with_dictionary);
+  Buffer::OwnedImpl output;
+  decompressor.decompress(input, output);
+  EXPECT_EQ(payload, output.toString());
+}
+
 class ConfigTest : public BrotliCompressorImplTest,
                    public testing::WithParamInterface<std::string> {};
 
@@ -133,6 +163,28 @@ TEST_P(ConfigTest, LoadConfig) {
   verifyWithDecompressor(factory->createCompressor());
 }
 
+TEST_F(BrotliCompressorImplTest, LoadConfigWithDictionary) {
+  envoy::extensions::compression::brotli::compressor::v3::Brotli brotli;
+  TestUtility::loadFromJson(R"EOF({"dictionary": {"inline_string": "dictionary content"}})EOF",
+                            brotli);
+
+  BrotliCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  Envoy::Compression::Compressor::CompressorFactoryPtr factory =
+      lib_factory.createCompressorFactoryFromProto(brotli, context);
+
+  Buffer::OwnedImpl buffer("dictionary content dictionary content");
+  factory->createCompressor()->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+
+  Stats::IsolatedStoreImpl stats_store{};
+  Compression::Brotli::Decompressor::BrotliDecompressorImpl decompressor{
+      *stats_store.rootScope(), "test.", 4096, false,
+      std::make_shared<const std::string>("dictionary content")};
+  Buffer::OwnedImpl output;
+  decompressor.decompress(buffer, output);
+  EXPECT_EQ("dictionary content dictionary content", output.toString());
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace Brotli
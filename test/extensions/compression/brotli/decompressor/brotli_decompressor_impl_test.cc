@@ -208,6 +208,40 @@ TEST_F(BrotliDecompressorImplTest, WrongInput) {
   EXPECT_EQ(1, stats_store.counterFromString("test.brotli_error").value());
 }
 
+// Content compressed with a dictionary only decompresses with the same dictionary.
+TEST_F(BrotliDecompressorImplTest, DecompressWithDictionary) {
+  const std::string dictionary = "the quick brown fox jumps over the lazy dog";
+  const std::string payload = "the quick brown fox jumps over the lazy dog twice";
+  Buffer::OwnedImpl compressed(payload);
+  Brotli::Compressor::BrotliCompressorImpl compressor{
+      default_quality,
+      default_window_bits,
+      default_input_block_bits,
+      false,
+      Brotli::Compressor::BrotliCompressorImpl::EncoderMode::Default,
+      4096,
+      std::make_shared<const Brotli::Compressor::BrotliCompressorDictionary>(dictionary,
+                                                                             default_quality)};
+  compressor.compress(compressed, Envoy::Compression::Compressor::State::Finish);
+
+  Stats::IsolatedStoreImpl stats_store{};
+  {
+    BrotliDecompressorImpl decompressor{*stats_store.rootScope(), "test.", 4096, false,
+                                        std::make_shared<const std::string>(dictionary)};
+    Buffer::OwnedImpl output_buffer;
+    decompressor.decompress(compressed, output_buffer);
+    EXPECT_EQ(payload, output_buffer.toString());
+    EXPECT_EQ(0, stats_store.counterFromString("test.brotli_error").value());
+  }
+  {
+    BrotliDecompressorImpl decompressor{*stats_store.rootScope(), "test.", 4096, false};
+    Buffer::OwnedImpl output_buffer;
+    decompressor.decompress(compressed, output_buffer);
+    EXPECT_NE(payload, output_buffer.toString());
+    EXPECT_EQ(1, stats_store.counterFromString("test.brotli_error").value());
+  }
+}
+
 TEST_F(BrotliDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   Buffer::OwnedImpl buffer;
   Buffer::OwnedImpl accumulation_buffer;
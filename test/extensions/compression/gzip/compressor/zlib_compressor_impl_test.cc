@@ -1,8 +1,10 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/hex.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/container/fixed_array.h"
@@ -150,8 +152,10 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
                        strategy, compression_level);
   }
   TestUtility::loadFromJson(json, gzip);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  Stats::IsolatedStoreImpl stats_store;
   Envoy::Compression::Compressor::CompressorPtr compressor =
-      GzipCompressorFactory(gzip).createCompressor();
+      GzipCompressorFactory(gzip, tls, *stats_store.rootScope()).createCompressor();
   // Check the created compressor produces valid output.
   TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
   compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
@@ -261,6 +265,35 @@ TEST_F(ZlibCompressorImplTest, CompressWithNotCommonParams) {
   expectValidFinishedBuffer(accumulation_buffer, input_size);
 }
 
+// Contexts released by finished streams are reset and reused by later streams.
+TEST_F(ZlibCompressorImplTest, PooledContextsAreReused) {
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  TestUtility::loadFromJson(R"EOF({"max_pooled_contexts": 1})EOF", gzip);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  Stats::IsolatedStoreImpl stats_store;
+  GzipCompressorFactory factory(gzip, tls, *stats_store.rootScope());
+
+  for (uint64_t i = 0; i < 3; i++) {
+    Buffer::OwnedImpl buffer;
+    TestUtility::feedBufferWithRandomCharacters(buffer, default_input_size);
+    Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+    if (i == 1) {
+      // Abandon the second stream midway; its context must still come back clean.
+      compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
+      continue;
+    }
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    expectValidFinishedBuffer(buffer, default_input_size);
+  }
+  EXPECT_EQ(1, stats_store.counterFromString("compressor_pool.gzip.miss").value());
+  EXPECT_EQ(2, stats_store.counterFromString("compressor_pool.gzip.hit").value());
+
+  // The pool keeps at most one idle context, so concurrent streams get fresh contexts.
+  auto first = factory.createCompressor();
+  auto second = factory.createCompressor();
+  EXPECT_EQ(2, stats_store.counterFromString("compressor_pool.gzip.miss").value());
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace Gzip
@@ -2,8 +2,10 @@
 #include "source/common/common/hex.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
+#include "source/extensions/compression/gzip/decompressor/config.h"
 #include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -334,6 +336,36 @@ TEST_F(ZlibDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   EXPECT_EQ(original_text, decompressed_text);
 }
 
+// Pooled decompressors are reused for streams with the same stats prefix only.
+TEST_F(ZlibDecompressorImplTest, PooledContextsAreReusedPerStatsPrefix) {
+  envoy::extensions::compression::gzip::decompressor::v3::Gzip gzip;
+  TestUtility::loadFromJson(R"EOF({"max_pooled_contexts": 2})EOF", gzip);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  GzipDecompressorFactory factory(gzip, stats_scope_, tls);
+
+  for (uint64_t i = 0; i < 3; i++) {
+    Buffer::OwnedImpl buffer;
+    TestUtility::feedBufferWithRandomCharacters(buffer, default_input_size);
+    const std::string original_text = buffer.toString();
+    Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+    compressor.init(
+        Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+        Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::
+            Standard,
+        gzip_window_bits, memory_level);
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+
+    Buffer::OwnedImpl output;
+    factory.createDecompressor("request.")->decompress(buffer, output);
+    EXPECT_EQ(original_text, output.toString());
+  }
+  EXPECT_EQ(1, stats_store_.counterFromString("decompressor_pool.gzip.miss").value());
+  EXPECT_EQ(2, stats_store_.counterFromString("decompressor_pool.gzip.hit").value());
+
+  factory.createDecompressor("response.");
+  EXPECT_EQ(2, stats_store_.counterFromString("decompressor_pool.gzip.miss").value());
+}
+
 class ZlibDecompressorStatsTest : public testing::Test {
 protected:
   void chargeErrorStats(const int result) { decompressor_.chargeErrorStats(result); }
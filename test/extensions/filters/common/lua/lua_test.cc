@@ -178,6 +178,111 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// Threads of coroutines that ran to completion are reused, others are not.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object:testCall()
+      return "done"
+    end
+
+    -- The threads are kept in globals so that their addresses can not be reused.
+    function yieldMe()
+      suspended = coroutine.running()
+      coroutine.yield()
+    end
+
+    function failMe()
+      failed = coroutine.running()
+      error("failed")
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  const int yield_me = state_->getGlobalRef(state_->registerGlobal("yieldMe", initializers_));
+  const int fail_me = state_->getGlobalRef(state_->registerGlobal("failMe", initializers_));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  lua_State* thread = cr->luaState();
+  LuaRef<TestObject> ref(TestObject::create(thread), true);
+  EXPECT_CALL(*ref.get(), doTestCall(_));
+  cr->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  cr.reset();
+
+  // The finished thread is handed out again with an empty stack and can run another function.
+  cr = state_->createCoroutine();
+  EXPECT_EQ(thread, cr->luaState());
+  EXPECT_EQ(0, lua_gettop(cr->luaState()));
+  EXPECT_CALL(*ref.get(), doTestCall(_));
+  ref.pushStack();
+  cr->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  EXPECT_STREQ("done", lua_tostring(cr->luaState(), -1));
+
+  // A thread left suspended is not reused.
+  cr.reset();
+  cr = state_->createCoroutine();
+  EXPECT_EQ(thread, cr->luaState());
+  EXPECT_CALL(on_yield_, ready());
+  cr->start(yield_me, 0, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Yielded);
+  cr.reset();
+  cr = state_->createCoroutine();
+  EXPECT_NE(thread, cr->luaState());
+
+  // Nor is a thread that failed.
+  thread = cr->luaState();
+  EXPECT_THROW_WITH_REGEX(cr->start(fail_me, 0, yield_callback_), LuaException, "failed");
+  cr.reset();
+  cr = state_->createCoroutine();
+  EXPECT_NE(thread, cr->luaState());
+  cr.reset();
+
+  EXPECT_CALL(*ref.get(), onDestroy());
+  ref.reset();
+  state_->runtimeGC();
+}
+
+// States running the same script share its bytecode, and load errors are still reported.
+TEST_F(LuaTest, SharedBytecode) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object:testCall()
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  auto other = std::make_unique<ThreadLocalState>(SCRIPT, tls_);
+  // The second state reuses the bytecode compiled for the first rather than compiling its own.
+  EXPECT_FALSE(state_->bytecode().empty());
+  EXPECT_EQ(&state_->bytecode(), &other->bytecode());
+  // A different script is compiled separately.
+  ThreadLocalState different(SCRIPT + "\n", tls_);
+  EXPECT_NE(&state_->bytecode(), &different.bytecode());
+  other->registerType<TestObject>();
+  const int call_me = other->getGlobalRef(other->registerGlobal("callMe", initializers_));
+  EXPECT_NE(LUA_REFNIL, call_me);
+
+  // The first state going away does not affect the second.
+  state_.reset();
+  CoroutinePtr cr(other->createCoroutine());
+  LuaRef<TestObject> ref(TestObject::create(cr->luaState()), true);
+  EXPECT_CALL(*ref.get(), doTestCall(_));
+  cr->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  cr.reset();
+  EXPECT_CALL(*ref.get(), onDestroy());
+  ref.reset();
+  other->runtimeGC();
+
+  EXPECT_THROW_WITH_REGEX(std::make_unique<ThreadLocalState>("bad syntax", tls_), LuaException,
+                          "script load error");
+  EXPECT_THROW_WITH_REGEX(std::make_unique<ThreadLocalState>("bad syntax", tls_), LuaException,
+                          "script load error");
+}
+
 class ThreadSafeTest : public testing::Test {
 public:
   ThreadSafeTest()
@@ -13,6 +13,8 @@
 #include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -474,6 +476,138 @@ TEST(RoleBasedAccessControlEngineImpl, ConjunctiveCondition) {
   checkEngine(engine, false, LogResult::Undecided, info, conn, headers);
 }
 
+// Large policy sets are evaluated through a PolicyIndex. The decision and the effective policy
+// must be the same as when every policy is evaluated in order.
+TEST(RoleBasedAccessControlEngineImpl, IndexedPolicies) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  auto& policies = *rbac.mutable_policies();
+
+  for (int i = 0; i < 16; ++i) {
+    envoy::config::rbac::v3::Policy policy;
+    policy.add_permissions()->mutable_url_path()->mutable_path()->set_exact(
+        absl::StrCat("/path/", i));
+    policy.add_principals()->set_any(true);
+    policies[absl::StrFormat("path-%02d", i)] = policy;
+  }
+  policies["z-path"] = policies["path-03"];
+
+  policies["b-ip"] = TestUtility::parseYaml<envoy::config::rbac::v3::Policy>(R"EOF(
+permissions:
+- any: true
+principals:
+- remote_ip:
+    address_prefix: 10.0.0.0
+    prefix_len: 8
+)EOF");
+  policies["c-port"] = TestUtility::parseYaml<envoy::config::rbac::v3::Policy>(R"EOF(
+permissions:
+- destination_port: 8443
+principals:
+- any: true
+)EOF");
+  policies["d-header"] = TestUtility::parseYaml<envoy::config::rbac::v3::Policy>(R"EOF(
+permissions:
+- and_rules:
+    rules:
+    - header:
+        name: x-tenant
+        string_match:
+          exact: gold
+    - header:
+        name: x-region
+        present_match: true
+principals:
+- any: true
+)EOF");
+  policies["e-regex"] = TestUtility::parseYaml<envoy::config::rbac::v3::Policy>(R"EOF(
+permissions:
+- url_path:
+    path:
+      safe_regex:
+        regex: "/api/v[0-9]+/users"
+principals:
+- any: true
+)EOF");
+  // Presence matchers can not be indexed, so this policy is always evaluated.
+  policies["f-unindexed"] = TestUtility::parseYaml<envoy::config::rbac::v3::Policy>(R"EOF(
+permissions:
+- header:
+    name: x-debug
+    present_match: true
+principals:
+- any: true
+)EOF");
+
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac, ProtobufMessage::getStrictValidationVisitor(),
+                                                factory_context);
+
+  const auto check = [&engine](absl::string_view expected_policy,
+                               Envoy::Http::TestRequestHeaderMapImpl headers,
+                               absl::string_view remote_address = "192.168.0.1",
+                               uint32_t local_port = 80) {
+    NiceMock<Envoy::Network::MockConnection> conn;
+    NiceMock<StreamInfo::MockStreamInfo> info;
+    info.downstream_connection_info_provider_->setLocalAddress(
+        Envoy::Network::Utility::parseInternetAddressNoThrow("1.2.3.4", local_port, false));
+    info.downstream_connection_info_provider_->setRemoteAddress(
+        Envoy::Network::Utility::parseInternetAddressNoThrow(std::string(remote_address), 1234,
+                                                             false));
+    std::string effective_policy_id;
+    EXPECT_EQ(!expected_policy.empty(),
+              engine.handleAction(conn, headers, info, &effective_policy_id));
+    EXPECT_EQ(expected_policy, effective_policy_id);
+  };
+
+  check("", {{":path", "/other"}});
+  check("path-03", {{":path", "/path/3?query#fragment"}});
+  check("path-15", {{":path", "/path/15"}});
+  check("b-ip", {{":path", "/path/3"}}, "10.1.2.3");
+  check("c-port", {{":path", "/path/3"}}, "192.168.0.1", 8443);
+  check("d-header", {{":path", "/other"}, {"x-tenant", "gold"}, {"x-region", "eu"}});
+  check("", {{":path", "/other"}, {"x-tenant", "gold"}});
+  check("", {{":path", "/other"}, {"x-tenant", "silver"}, {"x-region", "eu"}});
+  check("e-regex", {{":path", "/api/v2/users"}});
+  check("", {{":path", "/api/v2/users/1"}});
+  check("f-unindexed", {{":path", "/other"}, {"x-debug", "1"}});
+  check("d-header",
+        {{":path", "/other"}, {"x-tenant", "gold"}, {"x-region", "eu"}, {"x-debug", "1"}});
+}
+
+// Multiple header values are matched both individually and joined, so both must be candidates.
+TEST(RoleBasedAccessControlEngineImpl, IndexedPoliciesMultipleHeaderValues) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::DENY);
+  auto& policies = *rbac.mutable_policies();
+
+  for (int i = 0; i < 16; ++i) {
+    envoy::config::rbac::v3::Policy policy;
+    auto* header = policy.add_permissions()->mutable_header();
+    header->set_name("x-tenant");
+    header->mutable_string_match()->set_exact(absl::StrCat("tenant-", i));
+    policy.add_principals()->set_any(true);
+    policies[absl::StrFormat("tenant-%02d", i)] = policy;
+  }
+  envoy::config::rbac::v3::Policy joined;
+  auto* header = joined.add_permissions()->mutable_header();
+  header->set_name("x-tenant");
+  header->mutable_string_match()->set_exact("a,b");
+  joined.add_principals()->set_any(true);
+  policies["joined"] = joined;
+
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac, ProtobufMessage::getStrictValidationVisitor(),
+                                                factory_context);
+
+  checkEngine(engine, true, LogResult::Undecided, Envoy::Network::MockConnection(),
+              Envoy::Http::TestRequestHeaderMapImpl{{"x-tenant", "tenant-20"}});
+  checkEngine(engine, false, LogResult::Undecided, Envoy::Network::MockConnection(),
+              Envoy::Http::TestRequestHeaderMapImpl{{"x-tenant", "tenant-7"}});
+  checkEngine(engine, false, LogResult::Undecided, Envoy::Network::MockConnection(),
+              Envoy::Http::TestRequestHeaderMapImpl{{"x-tenant", "a"}, {"x-tenant", "b"}});
+}
+
 TEST(RoleBasedAccessControlMatcherEngineImpl, Disabled) {
   xds::type::matcher::v3::Matcher matcher;
 
@@ -0,0 +1,80 @@
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+using testing::NiceMock;
+
+// Each policy allows a single path and a single /24. Requests hit the policy that sorts last, so
+// that evaluating every policy is the worst case.
+envoy::config::rbac::v3::RBAC makeRules(int64_t num_policies, bool by_path) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (int64_t i = 0; i < num_policies; ++i) {
+    envoy::config::rbac::v3::Policy policy;
+    if (by_path) {
+      policy.add_permissions()->mutable_url_path()->mutable_path()->set_exact(
+          absl::StrCat("/service/", i));
+      policy.add_principals()->set_any(true);
+    } else {
+      policy.add_permissions()->set_any(true);
+      auto* range = policy.add_principals()->mutable_remote_ip();
+      range->set_address_prefix(absl::StrCat("10.", i / 256, ".", i % 256, ".0"));
+      range->mutable_prefix_len()->set_value(24);
+    }
+    (*rbac.mutable_policies())[absl::StrFormat("policy-%06d", i)] = policy;
+  }
+  return rbac;
+}
+
+void runBenchmark(::benchmark::State& state, bool by_path) {
+  const int64_t num_policies = state.range(0);
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  RoleBasedAccessControlEngineImpl engine(makeRules(num_policies, by_path),
+                                          ProtobufMessage::getNullValidationVisitor(),
+                                          factory_context);
+
+  const int64_t last = num_policies - 1;
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  info.downstream_connection_info_provider_->setRemoteAddress(
+      Network::Utility::parseInternetAddressNoThrow(
+          absl::StrCat("10.", last / 256, ".", last % 256, ".1"), 1234, false));
+  Http::TestRequestHeaderMapImpl headers{{":path", absl::StrCat("/service/", last)}};
+
+  for (auto _ : state) { // NOLINT
+    std::string effective_policy_id;
+    bool allowed = engine.handleAction(connection, headers, info, &effective_policy_id);
+    RELEASE_ASSERT(allowed, "");
+    benchmark::DoNotOptimize(effective_policy_id);
+  }
+}
+
+void bmPathPolicies(::benchmark::State& state) { runBenchmark(state, true); }
+void bmRemoteIpPolicies(::benchmark::State& state) { runBenchmark(state, false); }
+
+BENCHMARK(bmPathPolicies)->Unit(::benchmark::kMicrosecond)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK(bmRemoteIpPolicies)->Unit(::benchmark::kMicrosecond)->RangeMultiplier(4)->Range(4, 4096);
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -654,6 +654,120 @@ TEST_F(CompressorFilterTest, AcceptanceTestEncodingWithTrailers) {
   doResponseCompression(headers, true);
 }
 
+// Small response chunks are held back until the flush policy's minimum is reached and are then
+// compressed in a single call.
+TEST_F(CompressorFilterTest, FlushPolicyCoalescesSmallChunks) {
+  setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "common_config": {
+      "flush_policy": {
+        "min_flush_bytes": 100
+      }
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "deflate, test"}});
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+
+  auto* timer = new NiceMock<Event::MockTimer>(&encoder_callbacks_.dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(10), _));
+  Buffer::OwnedImpl chunk1(std::string(40, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(chunk1, false));
+  EXPECT_EQ(0, chunk1.length());
+  Buffer::OwnedImpl chunk2(std::string(40, 'b'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(chunk2, false));
+
+  Buffer::OwnedImpl chunk3(std::string(40, 'c'));
+  EXPECT_CALL(*timer, disableTimer());
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(chunk3, false));
+  EXPECT_EQ(std::string(40, 'a') + std::string(40, 'b') + std::string(40, 'c'), chunk3.toString());
+  EXPECT_EQ(2, stats_.counter("test.compressor.test.test.response.coalesced_chunks").value());
+  EXPECT_EQ(120,
+            stats_.counter("test.compressor.test.test.response.total_uncompressed_bytes").value());
+  filter_->onDestroy();
+}
+
+// Held back chunks are compressed and injected once the maximum flush latency elapses.
+TEST_F(CompressorFilterTest, FlushPolicyFlushesOnTimer) {
+  setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "common_config": {
+      "flush_policy": {
+        "min_flush_bytes": 100,
+        "max_flush_latency": "0.005s"
+      }
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "deflate, test"}});
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+
+  auto* timer = new NiceMock<Event::MockTimer>(&encoder_callbacks_.dispatcher_);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(5), _));
+  Buffer::OwnedImpl chunk(std::string(10, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(chunk, false));
+
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) { EXPECT_EQ(10, data.length()); }));
+  timer->invokeCallback();
+  EXPECT_EQ(10,
+            stats_.counter("test.compressor.test.test.response.total_uncompressed_bytes").value());
+  filter_->onDestroy();
+}
+
+// Trailers finish the compressed stream including any held back chunks.
+TEST_F(CompressorFilterTest, FlushPolicyFinishesPendingChunksOnTrailers) {
+  setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "common_config": {
+      "flush_policy": {
+        "min_flush_bytes": 100
+      }
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "deflate, test"}});
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+
+  auto* timer = new NiceMock<Event::MockTimer>(&encoder_callbacks_.dispatcher_);
+  Buffer::OwnedImpl chunk(std::string(10, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(chunk, false));
+
+  EXPECT_CALL(*timer, disableTimer());
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, true))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) { EXPECT_EQ(10, data.length()); }));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->encodeTrailers(trailers));
+  filter_->onDestroy();
+}
+
 TEST_F(CompressorFilterTest, NoAcceptEncodingHeader) {
   doRequestNoCompression({{":method", "get"}, {}});
   Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
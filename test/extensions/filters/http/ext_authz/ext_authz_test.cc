@@ -28,6 +28,7 @@
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/proto/helloworld.pb.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -7377,6 +7378,199 @@ TEST_F(HttpFilterTest, RequestHeaderLimitsReachedDuringRemoval) {
   EXPECT_EQ(1U, config_->stats().request_header_limits_reached_.value());
 }
 
+class DecisionCacheTest : public HttpFilterTest {
+public:
+  void initializeDecisionCache(const std::string& cache_yaml) {
+    ON_CALL(factory_context_, timeSource()).WillByDefault(ReturnRef(time_system_));
+    auto proto_config = getFilterConfig(false, false);
+    TestUtility::loadFromYaml(cache_yaml, *proto_config.mutable_decision_cache());
+    initialize(proto_config);
+  }
+
+  // Runs a request through a fresh filter sharing the configuration (and so the cache) of the
+  // previous ones. If expect_check is set the client answers with the given status, and with the
+  // given cache_ttl_seconds in its dynamic metadata if set.
+  Http::FilterHeadersStatus runRequest(const std::string& user, bool expect_check,
+                                       Filters::Common::ExtAuthz::CheckStatus status =
+                                           Filters::Common::ExtAuthz::CheckStatus::OK,
+                                       absl::optional<double> cache_ttl_seconds = absl::nullopt) {
+    client_ = new NiceMock<Filters::Common::ExtAuthz::MockClient>();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_},
+                                       factory_context_);
+    filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_filter_callbacks_);
+    prepareCheck();
+
+    if (expect_check) {
+      EXPECT_CALL(*client_, check(_, _, _, _))
+          .WillOnce(Invoke([status, cache_ttl_seconds](
+                               Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                               const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                               const StreamInfo::StreamInfo&) -> void {
+            auto response = std::make_unique<Filters::Common::ExtAuthz::Response>();
+            response->status = status;
+            response->status_code = status == Filters::Common::ExtAuthz::CheckStatus::OK
+                                        ? Http::Code::OK
+                                        : Http::Code::Forbidden;
+            if (cache_ttl_seconds.has_value()) {
+              (*response->dynamic_metadata.mutable_fields())["cache_ttl_seconds"] =
+                  ValueUtil::numberValue(cache_ttl_seconds.value());
+            }
+            callbacks.onComplete(std::move(response));
+          }));
+    } else {
+      EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+    }
+
+    Http::TestRequestHeaderMapImpl headers{
+        {":method", "GET"}, {":path", "/"}, {":authority", "host"}, {"x-user", user}};
+    return filter_->decodeHeaders(headers, true);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+};
+
+// Verifies that an allowed decision is reused for requests with the same key headers only.
+TEST_F(DecisionCacheTest, OkDecisionIsCached) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("bob", true));
+
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+  EXPECT_EQ(3U, config_->stats().ok_.value());
+}
+
+// Verifies that cached decisions expire after the TTL.
+TEST_F(DecisionCacheTest, DecisionExpires) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 10s
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+}
+
+// Verifies that the authorization service can shorten the TTL of a decision, but not extend it.
+TEST_F(DecisionCacheTest, MetadataTtlOverride) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 10s
+  )EOF");
+
+  // A shorter TTL replaces the configured one.
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            runRequest("alice", true, Filters::Common::ExtAuthz::CheckStatus::OK, 2));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+
+  // A longer TTL is capped by the configured one.
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            runRequest("bob", true, Filters::Common::ExtAuthz::CheckStatus::OK, 60));
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("bob", false));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("bob", true));
+
+  // A TTL of zero prevents the decision from being cached.
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            runRequest("carol", true, Filters::Common::ExtAuthz::CheckStatus::OK, 0));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("carol", true));
+}
+
+// Verifies that denied decisions are only cached when a negative TTL is configured.
+TEST_F(DecisionCacheTest, DeniedDecisionRequiresNegativeTtl) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            runRequest("mallory", true, Filters::Common::ExtAuthz::CheckStatus::Denied));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            runRequest("mallory", true, Filters::Common::ExtAuthz::CheckStatus::Denied));
+  EXPECT_EQ(0U, config_->stats().decision_cache_hit_.value());
+}
+
+TEST_F(DecisionCacheTest, DeniedDecisionIsCachedWithNegativeTtl) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  negative_ttl: 5s
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            runRequest("mallory", true, Filters::Common::ExtAuthz::CheckStatus::Denied));
+  EXPECT_CALL(decoder_filter_callbacks_, sendLocalReply(Http::Code::Forbidden, _, _, _, _));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            runRequest("mallory", false));
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().denied_.value());
+}
+
+// Verifies that the least recently used decision is evicted once the cache is full.
+TEST_F(DecisionCacheTest, LeastRecentlyUsedDecisionIsEvicted) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  max_entries: 2
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("bob", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("carol", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("bob", true));
+}
+
+// Verifies that decisions are not cached for unnamed routes, which can't be told apart.
+TEST_F(DecisionCacheTest, UnnamedRouteIsNotCached) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  )EOF");
+  decoder_filter_callbacks_.route_->route_name_ = "";
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  EXPECT_EQ(0U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(0U, config_->stats().decision_cache_miss_.value());
+}
+
+// Verifies that a decision made with one set of per-route context extensions isn't reused with
+// another.
+TEST_F(DecisionCacheTest, PerRouteContextExtensionsArePartOfKey) {
+  initializeDecisionCache(R"EOF(
+  key_headers: ["x-user"]
+  ttl: 60s
+  )EOF");
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+
+  envoy::extensions::filters::http::ext_authz::v3::ExtAuthzPerRoute per_route_config;
+  (*per_route_config.mutable_check_settings()->mutable_context_extensions())["tier"] = "admin";
+  FilterConfigPerRoute per_route_filter_config(per_route_config);
+  Router::RouteSpecificFilterConfigs per_route_configs{&per_route_filter_config};
+  ON_CALL(decoder_filter_callbacks_, perFilterConfigs()).WillByDefault(Return(per_route_configs));
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, runRequest("alice", false));
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+}
+
 } // namespace
 } // namespace ExtAuthz
 } // namespace HttpFilters
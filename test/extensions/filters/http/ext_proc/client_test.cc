@@ -346,6 +346,170 @@ TEST_F(ExtProcStreamTest, ClientStartError) {
   EXPECT_EQ(stream, nullptr);
 }
 
+class MultiplexedStreamPoolTest : public testing::Test {
+protected:
+  struct RecordingCallbacks : public ExternalProcessorCallbacks {
+    void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override {
+      responses_.push_back(std::move(response));
+    }
+    void onGrpcError(Grpc::Status::GrpcStatus status, const std::string&) override {
+      grpc_status_ = status;
+    }
+    void onGrpcClose() override { grpc_closed_ = true; }
+    void logStreamInfo() override {}
+    void onComplete(ProcessingResponse&) override {}
+    void onError() override {}
+
+    std::vector<std::unique_ptr<ProcessingResponse>> responses_;
+    Grpc::Status::GrpcStatus grpc_status_ = Grpc::Status::WellKnownGrpcStatus::Ok;
+    bool grpc_closed_ = false;
+  };
+
+  void SetUp() override {
+    grpc_service_.mutable_envoy_grpc()->set_cluster_name("test");
+    config_with_hash_key_.setConfig(grpc_service_);
+  }
+
+  void initialize(uint32_t max_streams) {
+    pool_ = std::make_unique<MultiplexedStreamPool>(client_manager_, *stats_store_.rootScope(),
+                                                    max_streams);
+  }
+
+  void expectSharedStreams(int count) {
+    EXPECT_CALL(client_manager_, getOrCreateRawAsyncClientWithHashKey(_, _, _))
+        .Times(count)
+        .WillRepeatedly(Invoke(this, &MultiplexedStreamPoolTest::doFactory));
+  }
+
+  Grpc::RawAsyncClientSharedPtr doFactory(Unused, Unused, Unused) {
+    auto async_client = std::make_shared<Grpc::MockAsyncClient>();
+    EXPECT_CALL(*async_client, startRaw("envoy.service.ext_proc.v3.ExternalProcessor", "Process",
+                                        _, _))
+        .WillOnce(Invoke(this, &MultiplexedStreamPoolTest::doStartRaw));
+    return async_client;
+  }
+
+  Grpc::RawAsyncStream* doStartRaw(Unused, Unused, Grpc::RawAsyncStreamCallbacks& callbacks,
+                                   const Http::AsyncClient::StreamOptions&) {
+    stream_callbacks_.push_back(&callbacks);
+    return &stream_;
+  }
+
+  ProcessingResponse responseFor(uint64_t id) {
+    ProcessingResponse response;
+    response.set_multiplexed_stream_id(id);
+    return response;
+  }
+
+  envoy::config::core::v3::GrpcService grpc_service_;
+  Grpc::GrpcServiceConfigWithHashKey config_with_hash_key_;
+  Grpc::MockAsyncClientManager client_manager_;
+  testing::NiceMock<Grpc::MockAsyncStream> stream_;
+  std::vector<Grpc::RawAsyncStreamCallbacks*> stream_callbacks_;
+  testing::NiceMock<Stats::MockStore> stats_store_;
+  std::unique_ptr<MultiplexedStreamPool> pool_;
+};
+
+// Verifies that HTTP streams share one gRPC stream and that responses are routed by ID.
+TEST_F(MultiplexedStreamPoolTest, StreamsShareGrpcStream) {
+  initialize(1);
+  expectSharedStreams(1);
+
+  RecordingCallbacks callbacks1;
+  RecordingCallbacks callbacks2;
+  auto stream1 = pool_->start(callbacks1, config_with_hash_key_);
+  auto stream2 = pool_->start(callbacks2, config_with_hash_key_);
+  ASSERT_NE(stream1, nullptr);
+  ASSERT_NE(stream2, nullptr);
+  ASSERT_EQ(stream_callbacks_.size(), 1U);
+
+  // Requests are tagged with the stream ID, and never half close the shared stream.
+  std::vector<ProcessingRequest> sent;
+  EXPECT_CALL(stream_, sendMessageRaw_(_, false))
+      .Times(2)
+      .WillRepeatedly(Invoke([&sent](Buffer::InstancePtr& request, bool) {
+        ProcessingRequest message;
+        EXPECT_TRUE(message.ParseFromString(request->toString()));
+        sent.push_back(message);
+      }));
+  stream1->send(ProcessingRequest(), true);
+  stream2->send(ProcessingRequest(), true);
+  ASSERT_EQ(sent.size(), 2U);
+  EXPECT_NE(sent[0].multiplexed_stream_id(), sent[1].multiplexed_stream_id());
+
+  stream_callbacks_[0]->onReceiveMessageRaw(
+      Grpc::Common::serializeMessage(responseFor(sent[1].multiplexed_stream_id())));
+  EXPECT_TRUE(callbacks1.responses_.empty());
+  EXPECT_EQ(callbacks2.responses_.size(), 1U);
+
+  // Responses for unknown IDs are dropped.
+  stream_callbacks_[0]->onReceiveMessageRaw(Grpc::Common::serializeMessage(responseFor(12345)));
+  EXPECT_TRUE(callbacks1.responses_.empty());
+  EXPECT_EQ(callbacks2.responses_.size(), 1U);
+
+  // Closing one HTTP stream signals its end without closing the shared stream.
+  EXPECT_CALL(stream_, sendMessageRaw_(_, false));
+  EXPECT_CALL(stream_, closeStream()).Times(0);
+  EXPECT_CALL(stream_, resetStream()).Times(0);
+  EXPECT_TRUE(stream1->close());
+  EXPECT_FALSE(stream1->close());
+  testing::Mock::VerifyAndClearExpectations(&stream_);
+  stream_callbacks_[0]->onReceiveMessageRaw(
+      Grpc::Common::serializeMessage(responseFor(sent[0].multiplexed_stream_id())));
+  EXPECT_TRUE(callbacks1.responses_.empty());
+}
+
+// Verifies that a new shared stream is only opened while all existing ones are in use.
+TEST_F(MultiplexedStreamPoolTest, OpensStreamsUpToLimit) {
+  initialize(2);
+  expectSharedStreams(2);
+
+  RecordingCallbacks callbacks;
+  auto stream1 = pool_->start(callbacks, config_with_hash_key_);
+  auto stream2 = pool_->start(callbacks, config_with_hash_key_);
+  auto stream3 = pool_->start(callbacks, config_with_hash_key_);
+  EXPECT_EQ(stream_callbacks_.size(), 2U);
+
+  stream1.reset();
+  stream2.reset();
+  stream3.reset();
+  auto stream4 = pool_->start(callbacks, config_with_hash_key_);
+  EXPECT_EQ(stream_callbacks_.size(), 2U);
+}
+
+// Verifies that a remote close of the shared stream is reported to every HTTP stream on it and
+// that the next HTTP stream opens a new shared stream.
+TEST_F(MultiplexedStreamPoolTest, RemoteCloseNotifiesAllStreams) {
+  initialize(1);
+  expectSharedStreams(2);
+
+  RecordingCallbacks callbacks1;
+  RecordingCallbacks callbacks2;
+  auto stream1 = pool_->start(callbacks1, config_with_hash_key_);
+  auto stream2 = pool_->start(callbacks2, config_with_hash_key_);
+  stream_callbacks_[0]->onRemoteClose(Grpc::Status::WellKnownGrpcStatus::Unavailable, "");
+  EXPECT_EQ(callbacks1.grpc_status_, Grpc::Status::WellKnownGrpcStatus::Unavailable);
+  EXPECT_EQ(callbacks2.grpc_status_, Grpc::Status::WellKnownGrpcStatus::Unavailable);
+
+  // Nothing is sent on a closed stream.
+  EXPECT_CALL(stream_, sendMessageRaw_(_, _)).Times(0);
+  EXPECT_TRUE(stream1->close());
+  testing::Mock::VerifyAndClearExpectations(&stream_);
+
+  RecordingCallbacks callbacks3;
+  auto stream3 = pool_->start(callbacks3, config_with_hash_key_);
+  EXPECT_NE(stream3, nullptr);
+  EXPECT_EQ(stream_callbacks_.size(), 2U);
+}
+
+TEST_F(MultiplexedStreamPoolTest, ClientStartError) {
+  initialize(1);
+  EXPECT_CALL(client_manager_, getOrCreateRawAsyncClientWithHashKey(_, _, _))
+      .WillOnce(Return(absl::InvalidArgumentError("error")));
+  RecordingCallbacks callbacks;
+  EXPECT_EQ(pool_->start(callbacks, config_with_hash_key_), nullptr);
+}
+
 } // namespace
 } // namespace ExternalProcessing
 } // namespace HttpFilters
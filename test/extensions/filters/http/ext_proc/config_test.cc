@@ -312,6 +312,27 @@ TEST(HttpExtProcConfigTest, InvalidRouteCacheConfig) {
                                        "be set to none-default at the same time.");
 }
 
+TEST(HttpExtProcConfigTest, MultiplexedStreamsWithObservabilityMode) {
+  std::string yaml = R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: ext_proc_server
+  observability_mode: true
+  multiplexed_streams_per_worker: 4
+  )EOF";
+
+  ExternalProcessingFilterConfig factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyConfigProto();
+  TestUtility::loadFromYaml(yaml, *proto_config);
+
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context;
+  auto result = factory.createFilterFactoryFromProto(*proto_config, "stats", context);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(result.status().message(), "multiplexed_streams_per_worker can only be used with a "
+                                       "grpc_service and without observability_mode.");
+}
+
 TEST(HttpExtProcConfigTest, InvalidServiceConfigServerContext) {
   std::string yaml = R"EOF(
   grpc_service:
@@ -190,6 +190,41 @@ TEST_F(BenchmarkTest, AddRequestHeaderAndClose) {
   measureHttpGets("add-request-header-close");
 }
 
+// Add a request header, multiplexing all requests over a single long-lived gRPC stream. Compared
+// with "add-request-header-close", this shows the per-request overhead without a gRPC stream setup.
+TEST_F(BenchmarkTest, AddRequestHeaderMultiplexed) {
+  proto_config_.mutable_processing_mode()->set_response_header_mode(ProcessingMode::SKIP);
+  proto_config_.mutable_multiplexed_streams_per_worker()->set_value(1);
+  const int iterations = testIterations();
+  test_processor_.start(
+      ipVersion(),
+      [iterations](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        int processed = 0;
+        ProcessingRequest header_req;
+        // Return once all requests have been processed, so that the stream is closed before the
+        // test processor shuts down.
+        while (processed < iterations && stream->Read(&header_req)) {
+          if (!header_req.has_request_headers()) {
+            // The end of an HTTP stream's messages.
+            continue;
+          }
+          ProcessingResponse header_resp;
+          header_resp.set_multiplexed_stream_id(header_req.multiplexed_stream_id());
+          auto* new_hdr = header_resp.mutable_request_headers()
+                              ->mutable_response()
+                              ->mutable_header_mutation()
+                              ->add_set_headers();
+          new_hdr->mutable_append()->set_value(false);
+          new_hdr->mutable_header()->set_key("x-envoy-benchmark");
+          new_hdr->mutable_header()->set_raw_value("true");
+          stream->Write(header_resp);
+          processed++;
+        }
+      });
+  initialize();
+  measureHttpGets("add-request-header-multiplexed");
+}
+
 // Add a response header, then close.
 TEST_F(BenchmarkTest, AddResponseHeaderAndClose) {
   test_processor_.start(
@@ -0,0 +1,119 @@
+#include "envoy/extensions/filters/http/grpc_json_transcoder/v3/transcoder.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+namespace {
+
+using testing::NiceMock;
+using testing::Return;
+
+constexpr uint64_t ChunkSize = 64 * 1024;
+
+enum class Body { Json, HttpBody, HttpBodyWithLength, HttpBodyWithLengthBuffered };
+
+// Transcodes a request of state.range(0) bytes delivered in 64 KiB chunks, reporting the peak
+// number of bytes held by the filter alongside the time taken.
+void runBenchmark(::benchmark::State& state, Body body) {
+  const uint64_t body_size = state.range(0);
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.grpc_json_transcoder_stream_http_body_requests",
+        body == Body::HttpBodyWithLengthBuffered ? "false" : "true"}});
+
+  envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder proto_config;
+  TestUtility::loadFromJson(
+      absl::StrCat("{\"proto_descriptor\": \"",
+                   TestEnvironment::runfilesPath("test/proto/bookstore.descriptor"),
+                   "\",\"services\": [\"bookstore.Bookstore\"]}"),
+      proto_config);
+  Api::ApiPtr api = Api::createApiForTest();
+  auto config = std::make_shared<JsonTranscoderConfig>(proto_config, *api);
+  Stats::IsolatedStoreImpl store;
+  auto stats = std::make_shared<GrpcJsonTranscoderFilterStats>(
+      GrpcJsonTranscoderFilterStats::generateStats("bench.", *store.rootScope()));
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  ON_CALL(decoder_callbacks, bufferLimit()).WillByDefault(Return(64 << 20));
+
+  std::string payload;
+  if (body == Body::Json) {
+    payload = absl::StrCat("{\"theme\": \"", std::string(body_size, 'a'), "\"}");
+  } else {
+    payload = std::string(body_size, 'a');
+  }
+
+  uint64_t peak = 0;
+  for (auto _ : state) { // NOLINT
+    Http::TestRequestHeaderMapImpl headers{{":method", "POST"}};
+    if (body == Body::Json) {
+      headers.setPath("/shelf");
+      headers.setContentType("application/json");
+    } else {
+      headers.setPath("/postBody?arg=hi");
+      headers.setContentType("text/plain");
+    }
+    if (body == Body::HttpBodyWithLength || body == Body::HttpBodyWithLengthBuffered) {
+      headers.setContentLength(payload.size());
+    }
+
+    JsonTranscoderFilter filter(config, stats);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    filter.decodeHeaders(headers, false);
+    uint64_t sent = 0;
+    while (sent < payload.size()) {
+      const uint64_t size = std::min(ChunkSize, payload.size() - sent);
+      Buffer::OwnedImpl data(absl::string_view(payload).substr(sent, size));
+      sent += size;
+      filter.decodeData(data, sent == payload.size());
+      peak = std::max(peak, stats->transcoder_request_buffer_bytes_.value());
+      benchmark::DoNotOptimize(data.length());
+    }
+    filter.onDestroy();
+  }
+  state.counters["peak_buffered_bytes"] = peak;
+}
+
+void bmJsonRequest(::benchmark::State& state) { runBenchmark(state, Body::Json); }
+void bmHttpBodyRequest(::benchmark::State& state) { runBenchmark(state, Body::HttpBody); }
+void bmHttpBodyRequestWithLength(::benchmark::State& state) {
+  runBenchmark(state, Body::HttpBodyWithLength);
+}
+void bmHttpBodyRequestWithLengthBuffered(::benchmark::State& state) {
+  runBenchmark(state, Body::HttpBodyWithLengthBuffered);
+}
+
+BENCHMARK(bmJsonRequest)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 14, 16 << 20);
+BENCHMARK(bmHttpBodyRequest)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 14, 16 << 20);
+BENCHMARK(bmHttpBodyRequestWithLength)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 14, 16 << 20);
+BENCHMARK(bmHttpBodyRequestWithLengthBuffered)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 14, 16 << 20);
+
+} // namespace
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
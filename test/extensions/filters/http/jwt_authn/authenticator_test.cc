@@ -2,6 +2,7 @@
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
 
 #include "source/common/common/base64.h"
+#include "source/common/common/bounded_thread_pool.h"
 #include "source/common/http/message_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/common/jwks_fetcher.h"
@@ -14,6 +15,7 @@
 #include "test/mocks/server/factory_context.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gtest/gtest.h"
 
 using envoy::extensions::filters::http::jwt_authn::v3::JwtAuthentication;
@@ -26,6 +28,7 @@ using ::testing::Invoke;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::ReturnRef;
 
 namespace Envoy {
 namespace Extensions {
@@ -1194,6 +1197,136 @@ TEST_F(AuthenticatorJwtCacheTest, TestCacheHit) {
   EXPECT_TRUE(TestUtility::protoEqual(out_extracted_data_, expected_payload));
 }
 
+TEST_F(AuthenticatorJwtCacheTest, TestSharedCacheMiss) {
+  SharedJwtCache shared_jwt_cache(100, 4096, time_system_);
+  ON_CALL(jwks_cache_.jwks_data_, getSharedJwtCache()).WillByDefault(Return(&shared_jwt_cache));
+  createAuthenticator("provider");
+
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, lookup(_)).WillOnce(Return(nullptr));
+  // A good jwt is inserted into both caches.
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _));
+
+  Http::TestRequestHeaderMapImpl headers{{"Authorization", "Bearer " + std::string(GoodToken)}};
+  expectVerifyStatus(Status::Ok, headers);
+
+  EXPECT_NE(shared_jwt_cache.lookup(GoodToken), nullptr);
+  EXPECT_EQ(1U, jwks_cache_.stats_.jwt_shared_cache_miss_.value());
+  EXPECT_EQ(0U, jwks_cache_.stats_.jwt_shared_cache_hit_.value());
+}
+
+TEST_F(AuthenticatorJwtCacheTest, TestSharedCacheHit) {
+  SharedJwtCache shared_jwt_cache(100, 4096, time_system_);
+  JwtVerify::Jwt cached_jwt;
+  cached_jwt.parseFromString(GoodToken);
+  shared_jwt_cache.insert(GoodToken, cached_jwt);
+  ON_CALL(jwks_cache_.jwks_data_, getSharedJwtCache()).WillByDefault(Return(&shared_jwt_cache));
+  createAuthenticator("provider");
+
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, lookup(_)).WillOnce(Return(nullptr));
+  // The signature is not verified again.
+  EXPECT_CALL(jwks_cache_.jwks_data_, getJwksObj()).Times(0);
+  // A copy of the shared entry is moved into the thread local cache.
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _));
+
+  Http::TestRequestHeaderMapImpl headers{{"Authorization", "Bearer " + std::string(GoodToken)}};
+  expectVerifyStatus(Status::Ok, headers);
+
+  EXPECT_EQ(0U, jwks_cache_.stats_.jwt_shared_cache_miss_.value());
+  EXPECT_EQ(1U, jwks_cache_.stats_.jwt_shared_cache_hit_.value());
+}
+
+class AuthenticatorVerificationPoolTest : public AuthenticatorJwtCacheTest {
+public:
+  AuthenticatorVerificationPoolTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        pool_(std::make_unique<Thread::BoundedThreadPool>(api_->threadFactory(), "jwt_verify", 1)) {
+    pool_->grow(1);
+    ON_CALL(jwks_cache_, verificationPool()).WillByDefault(Return(pool_.get()));
+    ON_CALL(jwks_cache_.jwks_data_, dispatcher()).WillByDefault(ReturnRef(*dispatcher_));
+    ON_CALL(jwks_cache_.jwks_data_, getJwksSharedObj())
+        .WillByDefault(Return(JwksConstSharedPtr(Jwks::createFrom(PublicKey, Jwks::JWKS))));
+  }
+
+  void verify(const char* token) {
+    headers_ = Http::TestRequestHeaderMapImpl{{"Authorization", "Bearer " + std::string(token)}};
+    auth_->verify(
+        headers_, parent_span_, extractor_->extract(headers_), nullptr,
+        [this](const Status& status) {
+          status_ = status;
+          dispatcher_->exit();
+        },
+        nullptr);
+  }
+
+  // Waits for the jobs posted to the single thread of the pool so far to run.
+  void waitForPool() {
+    absl::Notification done;
+    ASSERT_TRUE(pool_->post([&done]() { done.Notify(); }));
+    done.WaitForNotification();
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  std::unique_ptr<Thread::BoundedThreadPool> pool_;
+  Http::TestRequestHeaderMapImpl headers_;
+  absl::optional<Status> status_;
+};
+
+TEST_F(AuthenticatorVerificationPoolTest, GoodToken) {
+  createAuthenticator("provider");
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _));
+
+  verify(GoodToken);
+  // The signature is verified on the pool.
+  EXPECT_FALSE(status_.has_value());
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(status_, Status::Ok);
+  EXPECT_EQ(0U, jwks_cache_.stats_.jwt_verification_pool_full_.value());
+}
+
+TEST_F(AuthenticatorVerificationPoolTest, BadSignature) {
+  createAuthenticator("provider");
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(_, _)).Times(0);
+
+  verify(NonExistKidToken);
+  dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+  EXPECT_EQ(status_, Status::JwtVerificationFail);
+}
+
+TEST_F(AuthenticatorVerificationPoolTest, PoolFullVerifiesInline) {
+  createAuthenticator("provider");
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _));
+
+  // Keep the only thread of the pool busy and fill its queue.
+  absl::Notification started;
+  absl::Notification release;
+  ASSERT_TRUE(pool_->post([&]() {
+    started.Notify();
+    release.WaitForNotification();
+  }));
+  started.WaitForNotification();
+  for (size_t i = 0; i < Thread::BoundedThreadPool::MaxQueuedJobsPerThread; ++i) {
+    ASSERT_TRUE(pool_->post([]() {}));
+  }
+
+  verify(GoodToken);
+  // The signature was verified on the calling thread.
+  EXPECT_EQ(status_, Status::Ok);
+  EXPECT_EQ(1U, jwks_cache_.stats_.jwt_verification_pool_full_.value());
+  release.Notify();
+}
+
+TEST_F(AuthenticatorVerificationPoolTest, DestroyWhileVerifying) {
+  createAuthenticator("provider");
+
+  verify(GoodToken);
+  auth_->onDestroy();
+  auth_.reset();
+  waitForPool();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(status_.has_value());
+}
+
 // Test: ExtractOnlyWithoutValidation config can be set and cleared.
 TEST_F(AuthenticatorTest, ExtractOnlyVerificationHeaderConfig) {
   envoy::extensions::filters::http::jwt_authn::v3::ExtractOnlyWithoutValidation config;
@@ -0,0 +1,76 @@
+// Compares the cost of verifying a JWT signature with the cost of looking up a verified JWT in
+// the thread local and the shared JWT caches.
+
+#include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
+
+#include "source/common/jwt/jwks.h"
+#include "source/common/jwt/jwt.h"
+#include "source/common/jwt/verify.h"
+#include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
+#include "source/extensions/filters/http/jwt_authn/shared_jwt_cache.h"
+
+#include "test/extensions/filters/http/jwt_authn/test_common.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+
+// Parse and RS256-verify the token, as done on a cache miss.
+static void bmVerifySignature(benchmark::State& state) {
+  auto jwks = JwtVerify::Jwks::createFrom(PublicKey, JwtVerify::Jwks::JWKS);
+  for (auto _ : state) { // NOLINT
+    JwtVerify::Jwt jwt;
+    RELEASE_ASSERT(jwt.parseFromString(GoodToken) == JwtVerify::Status::Ok, "");
+    RELEASE_ASSERT(JwtVerify::verifyJwtWithoutTimeChecking(jwt, *jwks) == JwtVerify::Status::Ok,
+                   "");
+  }
+}
+BENCHMARK(bmVerifySignature);
+
+static void bmThreadLocalCacheLookup(benchmark::State& state) {
+  Event::SimulatedTimeSystem time_system;
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  auto cache = JwtCache::create(true, config, time_system);
+  auto jwt = std::make_unique<JwtVerify::Jwt>();
+  jwt->parseFromString(GoodToken);
+  cache->insert(GoodToken, std::move(jwt));
+  const std::string token(GoodToken);
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(cache->lookup(token));
+  }
+}
+BENCHMARK(bmThreadLocalCacheLookup);
+
+// Lookups from several threads contend on the shard locks. Each thread looks up its own token.
+static void bmSharedCacheLookup(benchmark::State& state) {
+  static Event::SimulatedTimeSystem* time_system;
+  static SharedJwtCache* cache;
+  if (state.thread_index() == 0) {
+    time_system = new Event::SimulatedTimeSystem();
+    cache = new SharedJwtCache(1000, 4096, *time_system);
+    JwtVerify::Jwt jwt;
+    jwt.parseFromString(GoodToken);
+    for (int i = 0; i < state.threads(); ++i) {
+      cache->insert(absl::StrCat(GoodToken, i), jwt);
+    }
+  }
+  const std::string token = absl::StrCat(GoodToken, state.thread_index());
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(cache->lookup(token));
+  }
+  if (state.thread_index() == 0) {
+    delete cache;
+    delete time_system;
+  }
+}
+BENCHMARK(bmSharedCacheLookup)->ThreadRange(1, 8);
+
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
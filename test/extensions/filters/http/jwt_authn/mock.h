@@ -88,9 +88,12 @@ public:
               (), (const));
   MOCK_METHOD(const Router::RetryPolicyConstSharedPtr&, retryPolicy, (), (const));
   MOCK_METHOD(const JwtVerify::Jwks*, getJwksObj, (), (const));
+  MOCK_METHOD(JwksConstSharedPtr, getJwksSharedObj, (), (const));
   MOCK_METHOD(bool, isExpired, (), (const));
   MOCK_METHOD(const JwtVerify::Jwks*, setRemoteJwks, (JwksConstPtr&&), ());
   MOCK_METHOD(JwtCache&, getJwtCache, (), ());
+  MOCK_METHOD(SharedJwtCache*, getSharedJwtCache, (), ());
+  MOCK_METHOD(Event::Dispatcher&, dispatcher, (), ());
 
   envoy::extensions::filters::http::jwt_authn::v3::JwtProvider jwt_provider_;
   ::testing::NiceMock<MockJwtCache> jwt_cache_;
@@ -114,6 +117,7 @@ public:
   MOCK_METHOD(JwksData*, findByProvider, (const std::string&), ());
   MOCK_METHOD(JwksData*, getSingleProvider, ());
   MOCK_METHOD(JwtAuthnFilterStats&, stats, ());
+  MOCK_METHOD(Thread::BoundedThreadPool*, verificationPool, ());
 
   NiceMock<Stats::MockIsolatedStatsStore> stats_store_;
   JwtAuthnFilterStats stats_;
@@ -0,0 +1,89 @@
+#include <memory>
+#include <string>
+
+#include "source/extensions/filters/http/jwt_authn/shared_jwt_cache.h"
+
+#include "test/extensions/filters/http/jwt_authn/test_common.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace JwtAuthn {
+namespace {
+
+using JwtVerify::Status;
+
+class SharedJwtCacheTest : public testing::Test {
+public:
+  void setupCache(uint32_t max_size, uint32_t max_token_size = 4096) {
+    cache_ = std::make_unique<SharedJwtCache>(max_size, max_token_size, time_system_);
+  }
+
+  JwtVerify::Jwt loadJwt(const char* jwt_str) {
+    JwtVerify::Jwt jwt;
+    EXPECT_EQ(jwt.parseFromString(jwt_str), Status::Ok);
+    return jwt;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  SharedJwtCachePtr cache_;
+};
+
+TEST_F(SharedJwtCacheTest, InsertAndLookup) {
+  setupCache(100);
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+
+  cache_->insert(GoodToken, loadJwt(GoodToken));
+  const JwtConstSharedPtr jwt = cache_->lookup(GoodToken);
+  ASSERT_NE(jwt, nullptr);
+  EXPECT_EQ(jwt->iss_, "https://example.com");
+  // The same entry is returned to every caller.
+  EXPECT_EQ(jwt, cache_->lookup(GoodToken));
+
+  EXPECT_EQ(cache_->lookup(OtherGoodToken), nullptr);
+}
+
+TEST_F(SharedJwtCacheTest, ExpiredToken) {
+  setupCache(100);
+  cache_->insert(ExpiredToken, loadJwt(ExpiredToken));
+  // Not found since it is expired.
+  EXPECT_EQ(cache_->lookup(ExpiredToken), nullptr);
+}
+
+TEST_F(SharedJwtCacheTest, InvalidTokenSize) {
+  setupCache(100, std::string(GoodToken).length() - 1);
+  cache_->insert(GoodToken, loadJwt(GoodToken));
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+}
+
+// Each shard holds at most max_size / NumShards entries and evicts the least recently used one.
+TEST_F(SharedJwtCacheTest, BoundedSize) {
+  setupCache(SharedJwtCache::NumShards);
+  const JwtVerify::Jwt jwt = loadJwt(GoodToken);
+
+  // The cache is keyed by the token digest only, so arbitrary keys can stand in for tokens.
+  constexpr int NumTokens = 1000;
+  for (int i = 0; i < NumTokens; ++i) {
+    cache_->insert(absl::StrCat("token-", i), jwt);
+  }
+  int found = 0;
+  for (int i = 0; i < NumTokens; ++i) {
+    if (cache_->lookup(absl::StrCat("token-", i)) != nullptr) {
+      ++found;
+    }
+  }
+  EXPECT_LE(found, static_cast<int>(SharedJwtCache::NumShards));
+  EXPECT_GT(found, 0);
+  // The most recently inserted token is always present.
+  EXPECT_NE(cache_->lookup(absl::StrCat("token-", NumTokens - 1)), nullptr);
+}
+
+} // namespace
+} // namespace JwtAuthn
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
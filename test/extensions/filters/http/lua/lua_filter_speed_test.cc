@@ -0,0 +1,76 @@
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/lua/lua_filter.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/mocks/upstream/cluster_manager.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Lua {
+namespace {
+
+using testing::NiceMock;
+
+// A typical header rewrite: walk the headers, then add, replace and remove a few of them.
+const std::string HEADER_REWRITE_SCRIPT{R"EOF(
+  function envoy_on_request(request_handle)
+    local headers = request_handle:headers()
+    local count = 0
+    for key, value in pairs(headers) do
+      count = count + 1
+    end
+    headers:add("x-header-count", count)
+    headers:replace("x-request-source", headers:get("x-forwarded-for") or "unknown")
+    headers:remove("x-internal")
+  end
+)EOF"};
+
+// Runs the script for a request with the given number of headers, creating a filter per request
+// as the filter chain does.
+void bmHeaderRewrite(::benchmark::State& state) {
+  NiceMock<ThreadLocal::MockInstance> tls;
+  NiceMock<Api::MockApi> api;
+  NiceMock<Upstream::MockClusterManager> cluster_manager;
+  Stats::IsolatedStoreImpl stats_store;
+  Event::SimulatedTimeSystem time_system;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+
+  envoy::extensions::filters::http::lua::v3::Lua proto_config;
+  proto_config.mutable_default_source_code()->set_inline_string(HEADER_REWRITE_SCRIPT);
+  auto config = std::make_shared<FilterConfig>(proto_config, tls, cluster_manager, api,
+                                               *stats_store.rootScope(), "bench.");
+
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                 {":path", "/"},
+                                                 {":authority", "host"},
+                                                 {"x-forwarded-for", "10.0.0.1"},
+                                                 {"x-internal", "true"}};
+  for (int64_t i = request_headers.size(); i < state.range(0); ++i) {
+    request_headers.addCopy(Http::LowerCaseString(absl::StrCat("x-header-", i)), "value");
+  }
+
+  for (auto _ : state) { // NOLINT
+    Http::TestRequestHeaderMapImpl headers(request_headers);
+    Filter filter(config, time_system);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    const auto status = filter.decodeHeaders(headers, true);
+    RELEASE_ASSERT(status == Http::FilterHeadersStatus::Continue, "");
+    filter.onDestroy();
+  }
+}
+
+BENCHMARK(bmHeaderRewrite)->Unit(::benchmark::kMicrosecond)->RangeMultiplier(4)->Range(8, 128);
+
+} // namespace
+} // namespace Lua
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <vector>
+
+#include "source/extensions/health_checkers/common/batched_timer_scheduler.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class BatchedTimerSchedulerTest : public testing::Test {
+protected:
+  BatchedTimerSchedulerTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")),
+        scheduler_(*dispatcher_, std::chrono::milliseconds(100)) {}
+
+  void advance(std::chrono::milliseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Event::Dispatcher::RunType::NonBlock);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  BatchedTimerScheduler scheduler_;
+};
+
+// Timers due in the same window run together from a single wakeup at the end of the window.
+TEST_F(BatchedTimerSchedulerTest, BatchesTimersInWindow) {
+  // Start at the beginning of a window.
+  const std::chrono::nanoseconds into_window =
+      time_system_.monotonicTime().time_since_epoch() % std::chrono::milliseconds(100);
+  time_system_.advanceTimeAndRun(std::chrono::milliseconds(100) - into_window, *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+
+  std::vector<int> fired;
+  std::vector<Event::TimerPtr> timers;
+  for (int i = 0; i < 3; ++i) {
+    timers.push_back(scheduler_.createTimer([&fired, i]() { fired.push_back(i); }));
+  }
+  timers[0]->enableTimer(std::chrono::milliseconds(90));
+  timers[1]->enableTimer(std::chrono::milliseconds(10));
+  timers[2]->enableTimer(std::chrono::milliseconds(150));
+  EXPECT_TRUE(timers[0]->enabled());
+
+  advance(std::chrono::milliseconds(99));
+  EXPECT_TRUE(fired.empty());
+
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ((std::vector<int>{0, 1}), fired);
+  EXPECT_FALSE(timers[0]->enabled());
+  EXPECT_TRUE(timers[2]->enabled());
+  EXPECT_EQ(1, scheduler_.wakeups());
+
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), fired);
+  EXPECT_EQ(2, scheduler_.wakeups());
+}
+
+TEST_F(BatchedTimerSchedulerTest, DisableAndDestroy) {
+  int fired = 0;
+  Event::TimerPtr disabled = scheduler_.createTimer([&fired]() { ++fired; });
+  Event::TimerPtr destroyed = scheduler_.createTimer([&fired]() { ++fired; });
+  Event::TimerPtr rescheduled = scheduler_.createTimer([&fired]() { ++fired; });
+  disabled->enableTimer(std::chrono::milliseconds(10));
+  disabled->disableTimer();
+  EXPECT_FALSE(disabled->enabled());
+  destroyed->enableTimer(std::chrono::milliseconds(10));
+  destroyed.reset();
+  rescheduled->enableTimer(std::chrono::milliseconds(10));
+  rescheduled->enableTimer(std::chrono::milliseconds(1000));
+
+  advance(std::chrono::milliseconds(200));
+  EXPECT_EQ(0, fired);
+  advance(std::chrono::milliseconds(1000));
+  EXPECT_EQ(1, fired);
+}
+
+// A timer enabled from a callback runs in a later window, even with a zero duration.
+TEST_F(BatchedTimerSchedulerTest, EnableFromCallback) {
+  int fired = 0;
+  Event::TimerPtr timer;
+  timer = scheduler_.createTimer([&]() {
+    if (++fired < 3) {
+      timer->enableTimer(std::chrono::milliseconds(0));
+    }
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(1, fired);
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(2, fired);
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(3, fired);
+  advance(std::chrono::milliseconds(100));
+  EXPECT_EQ(3, fired);
+  EXPECT_FALSE(timer->enabled());
+}
+
+// A callback can disable the other timers of its batch.
+TEST_F(BatchedTimerSchedulerTest, DisableFromCallback) {
+  int fired = 0;
+  Event::TimerPtr second;
+  Event::TimerPtr first = scheduler_.createTimer([&]() {
+    ++fired;
+    second->disableTimer();
+  });
+  second = scheduler_.createTimer([&]() { ++fired; });
+  first->enableTimer(std::chrono::milliseconds(10));
+  second->enableTimer(std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(200));
+  EXPECT_EQ(1, fired);
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
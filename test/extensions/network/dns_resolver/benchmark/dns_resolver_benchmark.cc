@@ -17,12 +17,16 @@ namespace Envoy {
 namespace {
 
 envoy::config::core::v3::TypedExtensionConfig
-createCaresTypedConfig(const std::string& server_address, uint16_t port) {
+createCaresTypedConfig(const std::string& server_address, uint16_t port,
+                       bool response_cache = false) {
   envoy::extensions::network::dns_resolver::cares::v3::CaresDnsResolverConfig cares;
   auto* resolver = cares.add_resolvers();
   auto* addr = resolver->mutable_socket_address();
   addr->set_address(server_address);
   addr->set_port_value(port);
+  if (response_cache) {
+    cares.mutable_response_cache();
+  }
 
   envoy::config::core::v3::TypedExtensionConfig typed_config;
   typed_config.set_name("envoy.network.dns_resolver.cares");
@@ -217,6 +221,62 @@ static void bmHickoryConcurrentQueries(::benchmark::State& state) {
   dns_server.stop();
 }
 
+// ---------------------------------------------------------------------------
+// Cached Query Throughput
+// Resolves N distinct hosts, as a dynamic forward proxy does, with the response
+// cache enabled and already populated. Reports items/second.
+// ---------------------------------------------------------------------------
+
+static void bmCaresCachedQueries(::benchmark::State& state) {
+  const int hosts = static_cast<int>(state.range(0));
+
+  ensureLibeventInitialized();
+  Network::Test::FakeUdpDnsServer dns_server;
+  dns_server.setDefaultAResponse("1.2.3.4");
+  dns_server.start();
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("cares_bench");
+  auto typed_config = createCaresTypedConfig(dns_server.address(), dns_server.port(), true);
+  auto resolver = createDnsResolver(*dispatcher, *api, typed_config);
+
+  std::vector<std::string> names;
+  names.reserve(hosts);
+  for (int i = 0; i < hosts; i++) {
+    names.push_back(fmt::format("host{}.example.com", i));
+  }
+
+  int completed = 0;
+  auto resolve_all = [&]() {
+    completed = 0;
+    for (const std::string& name : names) {
+      resolver->resolve(name, Network::DnsLookupFamily::V4Only,
+                        [&completed, hosts, &dispatcher](
+                            Network::DnsResolver::ResolutionStatus, absl::string_view /*details*/,
+                            std::list<Network::DnsResponse>&& /*responses*/) {
+                          if (++completed == hosts) {
+                            dispatcher->exit();
+                          }
+                        });
+    }
+  };
+
+  // Populate the cache.
+  resolve_all();
+  dispatcher->run(Event::Dispatcher::RunType::RunUntilExit);
+  RELEASE_ASSERT(completed == hosts, "Not all c-ares queries completed.");
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    // Cache hits are delivered inline, so there is nothing to run the dispatcher for.
+    resolve_all();
+    RELEASE_ASSERT(completed == hosts, "Not all c-ares cached queries completed inline.");
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * hosts);
+
+  dns_server.stop();
+}
+
 // ---------------------------------------------------------------------------
 // Resolver Creation Time
 // Measures the cost of constructing a resolver instance through the factory.
@@ -274,6 +334,8 @@ BENCHMARK(bmHickoryConcurrentQueries)
     ->Arg(500)
     ->Unit(::benchmark::kMicrosecond);
 
+BENCHMARK(bmCaresCachedQueries)->Arg(10)->Arg(100)->Arg(1000)->Unit(::benchmark::kMicrosecond);
+
 BENCHMARK(bmCaresResolverCreation)->Unit(::benchmark::kMicrosecond);
 BENCHMARK(bmHickoryResolverCreation)->Unit(::benchmark::kMicrosecond);
 
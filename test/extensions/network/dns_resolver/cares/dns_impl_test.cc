@@ -741,6 +741,10 @@ public:
     // Enable `reinit_channel_on_timeout` if requested by the test case.
     cares.set_reinit_channel_on_timeout(reinitOnTimeout());
 
+    if (responseCache()) {
+      cares.mutable_response_cache();
+    }
+
     // Copy over the dns_resolver_options_.
     cares.mutable_dns_resolver_options()->MergeFrom(dns_resolver_options);
     // setup the typed config
@@ -751,6 +755,8 @@ public:
   }
   // Whether to enable `reinit_channel_on_timeout` in the resolver config for this test.
   virtual bool reinitOnTimeout() const { return false; }
+  // Whether to enable the response cache with its default settings.
+  virtual bool responseCache() const { return false; }
 
   void SetUp() override {
     // Instantiate TestDnsServer and listen on a random port on the loopback address.
@@ -2367,5 +2373,117 @@ TEST_P(DnsImplEdns0Test, Edns0ConfigurationApplied) {
   ares_destroy_options(&opts);
 }
 
+// Response cache tests
+
+class DnsImplResponseCacheTest : public DnsImplTest {
+protected:
+  bool responseCache() const override { return true; }
+};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, DnsImplResponseCacheTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// A repeated resolution is served inline from the cache without querying the server.
+TEST_P(DnsImplResponseCacheTest, CacheHit) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, std::chrono::seconds(300)));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, std::chrono::seconds(300)));
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.cache_hits").value());
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.cache_misses").value());
+
+  // The lookup family is part of the key.
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::Auto,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(2, stats_store_.counter("dns.cares.cache_misses").value());
+}
+
+// Responses with a TTL of zero are not cached.
+TEST_P(DnsImplResponseCacheTest, ZeroTtlNotCached) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                               DnsResolver::ResolutionStatus::Completed,
+                                               {"201.134.56.7"}, {}, absl::nullopt));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(0, stats_store_.counter("dns.cares.cache_hits").value());
+}
+
+// Concurrent resolutions of the same name share one query to the server.
+TEST_P(DnsImplResponseCacheTest, Coalesced) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  ActiveDnsQuery* first = resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                                  DnsResolver::ResolutionStatus::Completed,
+                                                  {"201.134.56.7"}, {}, absl::nullopt);
+  ActiveDnsQuery* second = resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                                   DnsResolver::ResolutionStatus::Completed,
+                                                   {"201.134.56.7"}, {}, absl::nullopt);
+  EXPECT_NE(nullptr, first);
+  EXPECT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(1, stats_store_.counter("dns.cares.cache_coalesced").value());
+}
+
+// Cancelling one of the coalesced callers doesn't affect the others.
+TEST_P(DnsImplResponseCacheTest, CoalescedCancel) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  ActiveDnsQuery* first =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::V4Only, false);
+  ASSERT_NE(nullptr, first);
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  first->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // The response was still cached.
+  EXPECT_EQ(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+}
+
+// Resetting the networking drops the cached responses.
+TEST_P(DnsImplResponseCacheTest, ResetNetworkingClearsCache) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  resolver_->resetNetworking();
+  resetChannel();
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(0, stats_store_.counter("dns.cares.cache_hits").value());
+}
+
 } // namespace Network
 } // namespace Envoy
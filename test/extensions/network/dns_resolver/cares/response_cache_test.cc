@@ -0,0 +1,119 @@
+#include <chrono>
+#include <list>
+
+#include "source/common/network/utility.h"
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class DnsResponseCacheTest : public testing::Test {
+protected:
+  std::list<DnsResponse> responses(std::chrono::seconds ttl) {
+    std::list<DnsResponse> responses;
+    responses.emplace_back(Utility::parseInternetAddressNoThrow("10.0.0.1"), ttl);
+    responses.emplace_back(Utility::parseInternetAddressNoThrow("10.0.0.2"), ttl * 2);
+    return responses;
+  }
+
+  const DnsResponseCache::Key foo_{"foo.com", DnsLookupFamily::V4Only};
+  const DnsResponseCache::Key bar_{"bar.com", DnsLookupFamily::V4Only};
+  Event::SimulatedTimeSystem time_system_;
+};
+
+TEST_F(DnsResponseCacheTest, ExpiresAfterMinimumTtl) {
+  DnsResponseCache cache(16, std::chrono::seconds(5), 0, time_system_);
+  EXPECT_FALSE(cache.lookup(foo_).has_value());
+
+  cache.insert(foo_, responses(std::chrono::seconds(30)));
+  time_system_.advanceTimeWait(std::chrono::milliseconds(10500));
+  auto hit = cache.lookup(foo_);
+  ASSERT_TRUE(hit.has_value());
+  ASSERT_EQ(2, hit->responses_.size());
+  EXPECT_EQ("10.0.0.1", hit->responses_.front().addrInfo().address_->ip()->addressAsString());
+  // The TTLs are the time left until the entry expires, rounded up.
+  for (const DnsResponse& response : hit->responses_) {
+    EXPECT_EQ(std::chrono::seconds(20), response.addrInfo().ttl_);
+  }
+  EXPECT_FALSE(hit->prefetch_);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_FALSE(cache.lookup(foo_).has_value());
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(DnsResponseCacheTest, NegativeTtl) {
+  DnsResponseCache cache(16, std::chrono::seconds(5), 0, time_system_);
+  cache.insert(foo_, {});
+  auto hit = cache.lookup(foo_);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_TRUE(hit->responses_.empty());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_FALSE(cache.lookup(foo_).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, ZeroTtlNotCached) {
+  DnsResponseCache cache(16, std::chrono::seconds(0), 0, time_system_);
+  cache.insert(foo_, responses(std::chrono::seconds(0)));
+  cache.insert(bar_, {});
+  EXPECT_EQ(0, cache.size());
+
+  // A zero TTL response also replaces a previously cached one.
+  cache.insert(foo_, responses(std::chrono::seconds(30)));
+  cache.insert(foo_, responses(std::chrono::seconds(0)));
+  EXPECT_FALSE(cache.lookup(foo_).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, KeyIncludesLookupFamily) {
+  DnsResponseCache cache(16, std::chrono::seconds(5), 0, time_system_);
+  cache.insert(foo_, responses(std::chrono::seconds(30)));
+  EXPECT_FALSE(cache.lookup({"foo.com", DnsLookupFamily::Auto}).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, EvictsLeastRecentlyUsed) {
+  DnsResponseCache cache(2, std::chrono::seconds(5), 0, time_system_);
+  const DnsResponseCache::Key baz{"baz.com", DnsLookupFamily::V4Only};
+  cache.insert(foo_, responses(std::chrono::seconds(30)));
+  cache.insert(bar_, responses(std::chrono::seconds(30)));
+  EXPECT_TRUE(cache.lookup(foo_).has_value());
+
+  cache.insert(baz, responses(std::chrono::seconds(30)));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.lookup(foo_).has_value());
+  EXPECT_FALSE(cache.lookup(bar_).has_value());
+  EXPECT_TRUE(cache.lookup(baz).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, PrefetchReportedOnce) {
+  DnsResponseCache cache(16, std::chrono::seconds(5), 10, time_system_);
+  cache.insert(foo_, responses(std::chrono::seconds(100)));
+  time_system_.advanceTimeWait(std::chrono::seconds(89));
+  EXPECT_FALSE(cache.lookup(foo_)->prefetch_);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_TRUE(cache.lookup(foo_)->prefetch_);
+  EXPECT_FALSE(cache.lookup(foo_)->prefetch_);
+
+  // Refreshing the entry arms the prefetch again.
+  cache.insert(foo_, responses(std::chrono::seconds(100)));
+  time_system_.advanceTimeWait(std::chrono::seconds(95));
+  EXPECT_TRUE(cache.lookup(foo_)->prefetch_);
+}
+
+TEST_F(DnsResponseCacheTest, Clear) {
+  DnsResponseCache cache(16, std::chrono::seconds(5), 0, time_system_);
+  cache.insert(foo_, responses(std::chrono::seconds(30)));
+  cache.clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_FALSE(cache.lookup(foo_).has_value());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
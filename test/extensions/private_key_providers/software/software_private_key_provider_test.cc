@@ -0,0 +1,270 @@
+#include <string>
+#include <vector>
+
+#include "source/common/tls/private_key/private_key_manager_impl.h"
+#include "source/extensions/private_key_providers/software/software_private_key_provider.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Software {
+namespace {
+
+constexpr absl::string_view RsaKey = "{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem";
+constexpr absl::string_view EcdsaKey =
+    "{{ test_rundir }}/test/common/tls/test_data/san_dns_ecdsa_1_key.pem";
+
+class TestCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  explicit TestCallbacks(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  void onPrivateKeyMethodComplete() override {
+    ++completions_;
+    dispatcher_.exit();
+  }
+
+  Event::Dispatcher& dispatcher_;
+  uint32_t completions_{};
+};
+
+class SoftwarePrivateKeyProviderTest : public testing::Test {
+protected:
+  SoftwarePrivateKeyProviderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        callbacks_(*dispatcher_), ssl_ctx_(SSL_CTX_new(TLS_method())),
+        ssl_(SSL_new(ssl_ctx_.get())) {
+    ON_CALL(factory_context_.server_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_.server_context_, sslContextManager())
+        .WillByDefault(ReturnRef(context_manager_));
+    ON_CALL(context_manager_, privateKeyMethodManager())
+        .WillByDefault(ReturnRef(private_key_method_manager_));
+  }
+
+  ~SoftwarePrivateKeyProviderTest() override {
+    if (provider_ != nullptr) {
+      provider_->unregisterPrivateKeyMethod(ssl_.get());
+    }
+  }
+
+  void createProvider(absl::string_view key_path) {
+    const std::string yaml = fmt::format(R"EOF(
+      provider_name: software
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.software.v3.SoftwarePrivateKeyMethodConfig
+        private_key: {{ filename: "{}" }}
+)EOF",
+                                         key_path);
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), config);
+    provider_ =
+        private_key_method_manager_.createPrivateKeyMethodProvider(config, factory_context_);
+    ASSERT_NE(nullptr, provider_);
+    method_ = provider_->getBoringSslPrivateKeyMethod();
+    provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+  }
+
+  bssl::UniquePtr<EVP_PKEY> readKey(absl::string_view key_path) {
+    const std::string pem = TestEnvironment::readFileToStringForTest(
+        TestEnvironment::substitute(std::string(key_path)));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+    return bssl::UniquePtr<EVP_PKEY>(
+        PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  // Waits for the pending operation and returns the result of completing it.
+  ssl_private_key_result_t complete() {
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+    size_t out_len = 0;
+    out_.resize(512);
+    ssl_private_key_result_t result = method_->complete(ssl_.get(), out_.data(), &out_len, 512);
+    out_.resize(out_len);
+    return result;
+  }
+
+  uint64_t counter(const std::string& name) {
+    return factory_context_.store_.counter("software_key_provider." + name).value();
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  TestCallbacks callbacks_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  NiceMock<Ssl::MockContextManager> context_manager_;
+  TransportSockets::Tls::PrivateKeyMethodManagerImpl private_key_method_manager_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  Ssl::PrivateKeyMethodProviderSharedPtr provider_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  std::vector<uint8_t> out_;
+  const std::string input_{"handshake transcript"};
+};
+
+bool verify(EVP_PKEY* pkey, uint16_t signature_algorithm, absl::string_view input,
+            const std::vector<uint8_t>& signature) {
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (!EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                            SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                            pkey)) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+  return EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                          reinterpret_cast<const uint8_t*>(input.data()), input.size());
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, RsaPssSign) {
+  createProvider(RsaKey);
+  EXPECT_TRUE(provider_->isAvailable());
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_EQ(1U, callbacks_.completions_);
+  EXPECT_TRUE(verify(readKey(RsaKey).get(), SSL_SIGN_RSA_PSS_RSAE_SHA256, input_, out_));
+  EXPECT_EQ(1U, counter("offloaded"));
+  EXPECT_EQ(0U, counter("failed"));
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, RsaPkcs1Sign) {
+  createProvider(RsaKey);
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PKCS1_SHA384,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(readKey(RsaKey).get(), SSL_SIGN_RSA_PKCS1_SHA384, input_, out_));
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, EcdsaSign) {
+  createProvider(EcdsaKey);
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(readKey(EcdsaKey).get(), SSL_SIGN_ECDSA_SECP256R1_SHA256, input_, out_));
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, RsaDecrypt) {
+  createProvider(RsaKey);
+
+  bssl::UniquePtr<EVP_PKEY> pkey = readKey(RsaKey);
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey.get());
+  // A leading zero keeps the plaintext below the modulus.
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0x5a);
+  plaintext[0] = 0;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len = 0;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry, method_->decrypt(ssl_.get(), out, &out_len, sizeof(out),
+                                                    ciphertext.data(), ciphertext_len));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_EQ(plaintext, out_);
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, MismatchedAlgorithmFails) {
+  createProvider(RsaKey);
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_ECDSA_SECP256R1_SHA256,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  EXPECT_EQ(ssl_private_key_failure, complete());
+  EXPECT_EQ(1U, counter("failed"));
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, CompleteBeforeOperationPerformed) {
+  createProvider(RsaKey);
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  // The result is only handed over on the dispatcher, which hasn't run yet.
+  EXPECT_EQ(ssl_private_key_retry, method_->complete(ssl_.get(), out, &out_len, sizeof(out)));
+  EXPECT_EQ(ssl_private_key_success, complete());
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, DropsResultAfterConnectionDestroyed) {
+  createProvider(RsaKey);
+
+  size_t out_len = 0;
+  uint8_t out[512];
+  EXPECT_EQ(ssl_private_key_retry,
+            method_->sign(ssl_.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                          reinterpret_cast<const uint8_t*>(input_.data()), input_.size()));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+
+  // The pool has a single thread, so once this job has run the operation has been performed.
+  absl::Notification performed;
+  ASSERT_TRUE(SoftwarePrivateKeyMethodProvider::signingPool(
+                  factory_context_.server_context_.singletonManager(), api_->threadFactory(), 1)
+                  ->post([&performed]() { performed.Notify(); }));
+  performed.WaitForNotification();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(0U, callbacks_.completions_);
+
+  // The connection is gone, so the operation can't be completed.
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl_.get(), out, &out_len, sizeof(out)));
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, RegisterTwiceThrows) {
+  createProvider(RsaKey);
+  EXPECT_THROW_WITH_MESSAGE(
+      provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Not registering the software provider twice for same context");
+}
+
+TEST_F(SoftwarePrivateKeyProviderTest, InvalidKeyThrows) {
+  const std::string yaml = R"EOF(
+      provider_name: software
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.software.v3.SoftwarePrivateKeyMethodConfig
+        private_key: { inline_string: "not a key" }
+)EOF";
+  envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+  TestUtility::loadFromYaml(yaml, config);
+  EXPECT_THROW_WITH_MESSAGE(
+      private_key_method_manager_.createPrivateKeyMethodProvider(config, factory_context_),
+      EnvoyException, "Failed to read private key.");
+}
+
+} // namespace
+} // namespace Software
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -26,6 +26,7 @@ public:
   void setTransportSocketIsReadable() override { transport_socket_is_readable_ = true; }
   void raiseEvent(Network::ConnectionEvent) override { event_raised_ = true; }
   void flushWriteBuffer() override { write_buffer_flushed_ = true; }
+  uint64_t compactBuffers() override { return 0; }
 
   bool eventRaised() const { return event_raised_; }
   bool transportSocketIsReadable() const { return transport_socket_is_readable_; }
@@ -660,6 +660,7 @@ public:
   MOCK_METHOD(void, setTransportSocketIsReadable, ());
   MOCK_METHOD(void, raiseEvent, (ConnectionEvent));
   MOCK_METHOD(void, flushWriteBuffer, ());
+  MOCK_METHOD(uint64_t, compactBuffers, ());
 
   testing::NiceMock<MockConnection> connection_;
 };
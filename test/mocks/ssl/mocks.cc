@@ -50,6 +50,12 @@ MockServerContextConfig::MockServerContextConfig() {
 }
 MockServerContextConfig::~MockServerContextConfig() = default;
 
+MockCertificateValidationContextConfig::MockCertificateValidationContextConfig() {
+  ON_CALL(*this, asyncChainVerification())
+      .WillByDefault(testing::ReturnRef(async_chain_verification_));
+}
+MockCertificateValidationContextConfig::~MockCertificateValidationContextConfig() = default;
+
 MockPrivateKeyMethodManager::MockPrivateKeyMethodManager() = default;
 MockPrivateKeyMethodManager::~MockPrivateKeyMethodManager() = default;
 
@@ -125,6 +125,7 @@ public:
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
+  MOCK_METHOD(bool, kernelTlsTxOffload, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
   MOCK_METHOD(absl::optional<
                   envoy::extensions::transport_sockets::tls::v3::TlsParameters::CompliancePolicy>,
@@ -170,9 +171,12 @@ public:
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
   MOCK_METHOD(bool, disableStatefulSessionResumption, (), (const));
+  MOCK_METHOD(absl::optional<uint32_t>, sharedSessionCacheMaxSessions, (), (const));
+  MOCK_METHOD(absl::optional<std::chrono::milliseconds>, idleCompactionTimeout, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
+  MOCK_METHOD(bool, kernelTlsTxOffload, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
   MOCK_METHOD(bool, fullScanCertsOnSNIMismatch, (), (const));
   MOCK_METHOD(absl::optional<
@@ -211,6 +215,9 @@ public:
 
 class MockCertificateValidationContextConfig : public CertificateValidationContextConfig {
 public:
+  MockCertificateValidationContextConfig();
+  ~MockCertificateValidationContextConfig() override;
+
   MOCK_METHOD(const std::string&, caCert, (), (const));
   MOCK_METHOD(const std::string&, caCertPath, (), (const));
   MOCK_METHOD(const std::string&, caCertName, (), (const));
@@ -231,6 +238,13 @@ public:
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
   MOCK_METHOD(bool, autoSniSanMatch, (), (const));
+  MOCK_METHOD(const absl::optional<envoy::extensions::transport_sockets::tls::v3::
+                                       CertificateValidationContext::AsyncChainVerification>&,
+              asyncChainVerification, (), (const));
+
+  absl::optional<envoy::extensions::transport_sockets::tls::v3::CertificateValidationContext::
+                     AsyncChainVerification>
+      async_chain_verification_;
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
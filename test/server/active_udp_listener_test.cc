@@ -195,6 +195,25 @@ TEST_P(ActiveUdpListenerTest, MultipleFiltersOnReceiveErrorStopIteration) {
   active_listener_->onReceiveError(Api::IoError::IoErrorCode::UnknownError);
 }
 
+TEST_P(ActiveUdpListenerTest, ForwardedDatagramsAreCounted) {
+  setup(2);
+
+  auto* test_filter = new NiceMock<Network::MockUdpListenerReadFilter>(cb_);
+  EXPECT_CALL(*test_filter, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
+  active_listener_->addReadFilter(Network::UdpListenerReadFilterPtr{test_filter});
+
+  // A datagram for this worker is processed here.
+  Network::UdpRecvData data;
+  active_listener_->onData(std::move(data));
+  EXPECT_EQ(0, TestUtility::findCounter(store_, "udp.downstream_rx_datagram_forwarded")->value());
+
+  // A datagram for another worker is handed to it.
+  active_listener_->destination_ = 1;
+  Network::UdpRecvData data2;
+  active_listener_->onData(std::move(data2));
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "udp.downstream_rx_datagram_forwarded")->value());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
@@ -107,6 +107,7 @@ TEST_F(OptionsImplTest, All) {
       "--local-address-ip-version v6 -l info --component-log-level upstream:debug,connection:trace "
       "--service-cluster cluster --service-node node --service-zone zone "
       "--file-flush-interval-msec 9000 "
+      "--file-flush-thread-buffer-size-kb 32 --file-flush-overflow-policy drop "
       "--skip-hot-restart-on-no-parent "
       "--skip-hot-restart-parent-stats "
       "--drain-time-s 60 --log-format [%v] --parent-shutdown-time-s 90 "
@@ -135,6 +136,8 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ("node", options->serviceNodeName());
   EXPECT_EQ("zone", options->serviceZone());
   EXPECT_EQ(std::chrono::milliseconds(9000), options->fileFlushIntervalMsec());
+  EXPECT_EQ(32U, options->fileFlushThreadBufferSizeKB());
+  EXPECT_EQ(Server::FileFlushOverflowPolicy::Drop, options->fileFlushOverflowPolicy());
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
@@ -202,6 +205,8 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setRestartEpoch(44);
   options->setFileFlushIntervalMsec(std::chrono::milliseconds(45));
   options->setFileFlushMinSizeKB(128);
+  options->setFileFlushThreadBufferSizeKB(16);
+  options->setFileFlushOverflowPolicy(Server::FileFlushOverflowPolicy::Drop);
   options->setMode(Server::Mode::Validate);
   options->setServiceClusterName("cluster_foo");
   options->setServiceNodeName("node_foo");
@@ -236,6 +241,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(44, options->restartEpoch());
   EXPECT_EQ(std::chrono::milliseconds(45), options->fileFlushIntervalMsec());
   EXPECT_EQ(128U, options->fileFlushMinSizeKB());
+  EXPECT_EQ(16U, options->fileFlushThreadBufferSizeKB());
+  EXPECT_EQ(Server::FileFlushOverflowPolicy::Drop, options->fileFlushOverflowPolicy());
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ("cluster_foo", options->serviceClusterName());
   EXPECT_EQ("node_foo", options->serviceNodeName());
@@ -269,6 +276,10 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
+  EXPECT_EQ(options->fileFlushThreadBufferSizeKB(),
+            command_line_options->file_flush_thread_buffer_size());
+  EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Drop,
+            command_line_options->file_flush_overflow_policy());
   EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Validate, command_line_options->mode());
   EXPECT_EQ(options->serviceClusterName(), command_line_options->service_cluster());
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
@@ -288,6 +299,8 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(std::chrono::seconds(600), options->drainTime());
   EXPECT_EQ(Server::DrainStrategy::Gradual, options->drainStrategy());
   EXPECT_EQ(std::chrono::seconds(900), options->parentShutdownTime());
+  EXPECT_EQ(0U, options->fileFlushThreadBufferSizeKB());
+  EXPECT_EQ(Server::FileFlushOverflowPolicy::Buffer, options->fileFlushOverflowPolicy());
   EXPECT_EQ("", options->adminAddressPath());
   EXPECT_EQ(Network::Address::IpVersion::v4, options->localAddressIpVersion());
   EXPECT_EQ(Server::Mode::Serve, options->mode());
@@ -390,6 +403,9 @@ TEST_F(OptionsImplTest, OptionsFromArgvPrefix) {
 TEST_F(OptionsImplTest, BadCliOption) {
   EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --local-address-ip-version foo"),
                           MalformedArgvException, "error: unknown IP address version 'foo'");
+  EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --file-flush-overflow-policy foo"),
+                          MalformedArgvException,
+                          "error: unknown file-flush-overflow-policy 'foo'");
 }
 
 TEST_F(OptionsImplTest, ParseComponentLogLevels) {